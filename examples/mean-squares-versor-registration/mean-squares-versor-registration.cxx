@@ -330,6 +330,11 @@ main(int argc, char * argv[])
   auto observer = CommandIterationUpdate::New();
   optimizer->AddObserver(itk::IterationEvent(), observer);
 
+  // Report the optimizer iterations as the progress of the registration, and
+  // stop it when the host aborts the pipeline
+  pipeline.observe_process(registration);
+  pipeline.observe_optimizer(registration, optimizer.GetPointer());
+
   // One level registration process without shrinking and smoothing.
   //
   constexpr unsigned int numberOfLevels = 1;
@@ -349,6 +354,11 @@ main(int argc, char * argv[])
   try
   {
     registration->Update();
+    if (registration->GetAbortGenerateData())
+    {
+      std::cerr << "Registration aborted" << std::endl;
+      return EXIT_FAILURE;
+    }
     std::cout << "Optimizer stop condition: "
               << registration->GetOptimizer()->GetStopConditionDescription()
               << std::endl;
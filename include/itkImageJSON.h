@@ -27,6 +27,7 @@
 #include "itkPixelTypesJSON.h"
 #include "itkWasmImage.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -60,6 +61,40 @@ namespace itk
     std::vector<SizeValueType>  size  {};
   };
 
+  /** \class ImageChunkJSON
+   *
+   * \brief Part of an image pixel buffer along the slowest varying axis.
+   *
+   * Large images can be provided as several separately allocated chunks,
+   * each holding `size` slices starting at slice `index`.
+   *
+   * \ingroup WebAssemblyInterface
+   */
+  struct ImageChunkJSON
+  {
+    IndexValueType index { 0 };
+    SizeValueType  size  { 0 };
+    DescriptorArrayJSON data;
+  };
+
+  /** \class ImageChunkedLayoutJSON
+   *
+   * \brief Chunked, multiscale layout of the pixel data of the .iwi directory format.
+   *
+   * The pixel data is stored in N-D chunks of `chunkSize` pixels, in
+   * data/chunks/<level>/<chunk index along each axis>.raw, with `.zst` appended when
+   * the chunks are zstd compressed. Resolution level l samples every 2^l-th pixel
+   * of the image along each axis.
+   *
+   * \ingroup WebAssemblyInterface
+   */
+  struct ImageChunkedLayoutJSON
+  {
+    std::vector<SizeValueType> chunkSize {};
+    unsigned int               levels { 1 };
+    std::string                compression {};
+  };
+
   /** \class ImageJSON
    *
    * \brief Image JSON representation data structure.
@@ -74,17 +109,21 @@ namespace itk
 
     std::vector<double> origin { 0.0, 0.0 };
     std::vector<double> spacing { 1.0, 1.0 };
-    std::string         direction;
+    DescriptorArrayJSON direction;
     std::vector<SizeValueType> size { 0, 0 };
     ImageRegionJSON bufferedRegion{};
 
-    std::string data;
+    DescriptorArrayJSON data;
+    // When set, the pixel buffer is provided in chunks instead of `data`
+    std::optional<std::vector<ImageChunkJSON>> chunks;
+    // When set, the .iwi directory format stores the pixel data in chunks
+    std::optional<ImageChunkedLayoutJSON> chunkedLayout;
 
     MetadataJSON metadata;
   };
 
 template<typename TImage>
-auto imageToImageJSON(const TImage * image, const WasmImage<TImage> * wasmImage, bool inMemory) -> ImageJSON
+auto imageToImageJSON(const TImage * image, const WasmImage<TImage> * wasmImage, bool inMemory, bool withMetadata = true) -> ImageJSON
 {
   using ImageType = TImage;
 
@@ -125,11 +164,7 @@ auto imageToImageJSON(const TImage * image, const WasmImage<TImage> * wasmImage,
 
   if (inMemory)
   {
-    const auto direction = reinterpret_cast< size_t >( image->GetDirection().GetVnlMatrix().begin() );
-    std::ostringstream directionStream;
-    directionStream << "data:application/vnd.itk.address,0:";
-    directionStream << direction;
-    imageJSON.direction = directionStream.str();
+    imageJSON.direction = descriptorArray(image->GetDirection().GetVnlMatrix().begin());
   }
   else
   {
@@ -152,19 +187,18 @@ auto imageToImageJSON(const TImage * image, const WasmImage<TImage> * wasmImage,
 
   if (inMemory)
   {
-    const auto data = reinterpret_cast< size_t >( image->GetBufferPointer() );
-    std::ostringstream dataStream;
-    dataStream << "data:application/vnd.itk.address,0:";
-    dataStream << data;
-    imageJSON.data = dataStream.str();
+    imageJSON.data = descriptorArray(image->GetBufferPointer());
   }
   else
   {
     imageJSON.data = "data:application/vnd.itk.path,data/data.raw";
   }
 
-  auto dictionary = image->GetMetaDataDictionary();
-  metaDataDictionaryToJSON(dictionary, imageJSON.metadata);
+  if (withMetadata)
+  {
+    auto dictionary = image->GetMetaDataDictionary();
+    metaDataDictionaryToJSON(dictionary, imageJSON.metadata);
+  }
 
   return imageJSON;
 }
@@ -19,6 +19,7 @@
 #define itkImageToWasmImageFilter_hxx
 
 #include "itkImageToWasmImageFilter.h"
+#include "itkWasmDescriptor.h"
 
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataDictionaryJSON.h"
@@ -139,14 +140,20 @@ ImageToWasmImageFilter<TImage>
   wasmImage->SetImage(image);
 
   constexpr bool inMemory = true;
-  const ImageJSON imageJSON = imageToImageJSON<ImageType>(image, wasmImage, inMemory);
+  const ImageJSON imageJSON = imageToImageJSON<ImageType>(image, wasmImage, inMemory, !this->m_LazyMetadata);
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true, .concatenate = false }>(imageJSON, serialized);
+  auto ec = writeDescriptor(imageJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize ImageJSON");
   }
   wasmImage->SetJSON(serialized);
+  wasmImage->SetBinaryDescriptor(this->m_BinaryDescriptor);
+  if (this->m_LazyMetadata)
+  {
+    // Shares the dictionary entries until either copy is modified
+    wasmImage->SetMetaDataDictionary(image->GetMetaDataDictionary());
+  }
 }
 
 template <typename TImage>
@@ -155,6 +162,8 @@ ImageToWasmImageFilter<TImage>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
+  os << indent << "LazyMetadata: " << this->m_LazyMetadata << std::endl;
 }
 } // end namespace itk
 
@@ -116,9 +116,8 @@ ImportVectorImageFilter<TOutputImage>::EnlargeOutputRequestedRegion(DataObject *
   // get pointer to the output
   OutputImagePointer outputPtr = this->GetOutput();
 
-  // set the requested region to the largest possible region (in this case
-  // the amount of data that we have)
-  outputPtr->SetRequestedRegion(m_BufferedRegion);
+  // set the requested region to the amount of data that we have
+  outputPtr->SetRequestedRegion(m_BufferedRegion.GetNumberOfPixels() > 0 ? m_BufferedRegion : m_LargestPossibleRegion);
 }
 
 template <typename TOutputImage>
@@ -155,9 +154,17 @@ ImportVectorImageFilter<TOutputImage>::GenerateData()
   // get pointer to the output
   OutputImagePointer outputPtr = this->GetOutput();
 
-  // the output buffer size is set to the size specified by the user via the
-  // SetRegion() method.
-  outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
+  // the output buffer is the region specified by the user via the
+  // SetBufferedRegion() method, or the largest possible region when it is
+  // not set.
+  if (m_BufferedRegion.GetNumberOfPixels() > 0)
+  {
+    outputPtr->SetBufferedRegion(m_BufferedRegion);
+  }
+  else
+  {
+    outputPtr->SetBufferedRegion(outputPtr->GetLargestPossibleRegion());
+  }
 
   // pass the pointer down to the container during each Update() since
   // a call to Initialize() causes the container to forget the
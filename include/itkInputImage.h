@@ -27,6 +27,7 @@
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #include "itkImageFileReader.h"
+#include "itkWasmMappedImage.h"
 #endif
 
 namespace itk
@@ -42,6 +43,13 @@ namespace wasm
  *
  * Call `Get()` to get the TImage * to use an input to a pipeline.
  *
+ * By default the whole image is imported. A chunked memory IO input is
+ * gathered into one buffer in that case, so a pipeline that processes the
+ * image in slabs calls `SetStreaming(true)` before parsing. Only the image
+ * information is read at parse time, and each region its filters request is
+ * imported on update. The filesystem inputs are always read whole, except
+ * for .iwi directories, which are mapped.
+ *
  * \ingroup WebAssemblyInterface
  */
 template <typename TImage>
@@ -58,10 +66,26 @@ public:
     return this->m_Image.GetPointer();
   }
 
+  /** Import only the regions requested by the consumers of the image. */
+  void SetStreaming(bool streaming) {
+    this->m_Streaming = streaming;
+  }
+
+  bool GetStreaming() const {
+    return this->m_Streaming;
+  }
+
+  /** Process object that imports the requested regions when streaming. */
+  void SetSource(ProcessObject * source) {
+    this->m_Source = source;
+  }
+
   InputImage() = default;
   ~InputImage() = default;
 protected:
   typename TImage::ConstPointer m_Image;
+  bool m_Streaming{ false };
+  ProcessObject::Pointer m_Source;
 };
 
 
@@ -73,6 +97,14 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
     return false;
   }
 
+  if (const auto * parsed = wasm::Pipeline::get_parsed_input<TImage>(input))
+  {
+    inputImage.Set(parsed);
+    return true;
+  }
+
+  ProfileScope profileScope("read input image", "input");
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -83,7 +115,17 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
     auto json = getMemoryStoreInputJSON(0, index);
     wasmImage->SetJSON(json);
     wasmImageToImageFilter->SetInput(wasmImage);
-    wasmImageToImageFilter->Update();
+    if (inputImage.GetStreaming())
+    {
+      // The image stays connected to the filter, which imports the region
+      // requested by the consumers when they are updated
+      wasmImageToImageFilter->UpdateOutputInformation();
+      inputImage.SetSource(wasmImageToImageFilter);
+    }
+    else
+    {
+      wasmImageToImageFilter->Update();
+    }
     inputImage.Set(wasmImageToImageFilter->GetOutput());
 #else
     return false;
@@ -92,12 +134,19 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
   else
   {
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
-    auto image = itk::ReadImage<TImage>(input);
+    // The pixel data of .iwi directories is mapped instead of read
+    typename TImage::Pointer image = readMappedImage<TImage>(input);
+    if (!image)
+    {
+      image = itk::ReadImage<TImage>(input);
+    }
     inputImage.Set(image);
 #else
     return false;
 #endif
   }
+  profileScope.SetBytes(inputImage.Get()->GetPixelContainer()->Size() * sizeof(typename TImage::InternalPixelType));
+  wasm::Pipeline::set_parsed_input(input, inputImage.Get());
   return true;
 }
 
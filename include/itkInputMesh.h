@@ -73,6 +73,14 @@ bool lexical_cast(const std::string &input, InputMesh<TMesh> &inputMesh)
     return false;
   }
 
+  if (const auto * parsed = wasm::Pipeline::get_parsed_input<TMesh>(input))
+  {
+    inputMesh.Set(parsed);
+    return true;
+  }
+
+  ProfileScope profileScope("read input mesh", "input");
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -102,6 +110,8 @@ bool lexical_cast(const std::string &input, InputMesh<TMesh> &inputMesh)
     return false;
 #endif
   }
+  profileScope.SetBytes(inputMesh.Get()->GetNumberOfPoints() * sizeof(typename TMesh::PointType));
+  wasm::Pipeline::set_parsed_input(input, inputMesh.Get());
   return true;
 }
 
@@ -74,6 +74,12 @@ bool lexical_cast(const std::string &input, InputPointSet<TPointSet> &inputPoint
     return false;
   }
 
+  if (const auto * parsed = wasm::Pipeline::get_parsed_input<TPointSet>(input))
+  {
+    inputPointSet.Set(parsed);
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -104,6 +110,7 @@ bool lexical_cast(const std::string &input, InputPointSet<TPointSet> &inputPoint
     return false;
 #endif
   }
+  wasm::Pipeline::set_parsed_input(input, inputPointSet.Get());
   return true;
 }
 
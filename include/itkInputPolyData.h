@@ -75,6 +75,12 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
     return false;
   }
 
+  if (const auto * parsed = wasm::Pipeline::get_parsed_input<TPolyData>(input))
+  {
+    inputPolyData.Set(parsed);
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -109,6 +115,7 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
     return false;
 #endif
   }
+  wasm::Pipeline::set_parsed_input(input, inputPolyData.Get());
   return true;
 }
 
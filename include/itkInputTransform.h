@@ -73,6 +73,12 @@ bool lexical_cast(const std::string &input, InputTransform<TTransform> &inputTra
     return false;
   }
 
+  if (const auto * parsed = wasm::Pipeline::get_parsed_input<TTransform>(input))
+  {
+    inputTransform.Set(parsed);
+    return true;
+  }
+
   if (wasm::Pipeline::get_use_memory_io())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -112,6 +118,7 @@ bool lexical_cast(const std::string &input, InputTransform<TTransform> &inputTra
     return false;
 #endif
   }
+  wasm::Pipeline::set_parsed_input(input, inputTransform.Get());
   return true;
 }
 
@@ -27,6 +27,7 @@
 #include "itkPixelTypesJSON.h"
 #include "itkWasmMesh.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -64,23 +65,23 @@ namespace itk
     std::string name { "Mesh"};
 
     size_t numberOfPoints{ 0 };
-    std::string points;
+    DescriptorArrayJSON points;
 
     size_t numberOfPointPixels{ 0 };
-    std::string pointData;
+    DescriptorArrayJSON pointData;
 
     size_t numberOfCells{ 0 };
-    std::string cells;
+    DescriptorArrayJSON cells;
     size_t cellBufferSize{ 0 };
 
     size_t numberOfCellPixels{ 0 };
-    std::string cellData;
+    DescriptorArrayJSON cellData;
 
     MetadataJSON metadata;
   };
 
 template<typename TMesh>
-auto meshToMeshJSON(const TMesh * mesh, const WasmMesh<TMesh> * wasmMesh, bool inMemory) -> MeshJSON
+auto meshToMeshJSON(const TMesh * mesh, const WasmMesh<TMesh> * wasmMesh, bool inMemory, bool withMetadata = true) -> MeshJSON
 {
   using MeshType = TMesh;
 
@@ -125,39 +126,27 @@ auto meshToMeshJSON(const TMesh * mesh, const WasmMesh<TMesh> * wasmMesh, bool i
     meshJSON.cellBufferSize = wasmMesh->GetCellBuffer()->Size();
 
     const auto pointsAddress = reinterpret_cast< size_t >( &(mesh->GetPoints()->at(0)) );
-    std::ostringstream pointsStream;
-    pointsStream << "data:application/vnd.itk.address,0:";
-    pointsStream << pointsAddress;
-    meshJSON.points = pointsStream.str();
+    meshJSON.points = static_cast<uint64_t>(pointsAddress);
     size_t cellsAddress = 0;
     if (mesh->GetNumberOfCells() > 0)
     {
       cellsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
     }
-    std::ostringstream cellsStream;
-    cellsStream << "data:application/vnd.itk.address,0:";
-    cellsStream << cellsAddress;
-    meshJSON.cells = cellsStream.str();
+    meshJSON.cells = static_cast<uint64_t>(cellsAddress);
 
     size_t pointDataAddress = 0;
     if (mesh->GetPointData() != nullptr && mesh->GetPointData()->Size() > 0)
     {
       pointDataAddress = reinterpret_cast< size_t >( &(mesh->GetPointData()->at(0)) );
     }
-    std::ostringstream pointDataStream;
-    pointDataStream << "data:application/vnd.itk.address,0:";
-    pointDataStream << pointDataAddress;
-    meshJSON.pointData = pointDataStream.str();
+    meshJSON.pointData = static_cast<uint64_t>(pointDataAddress);
 
     size_t cellDataAddress = 0;
     if (mesh->GetCellData() != nullptr && mesh->GetCellData()->Size() > 0)
     {
       cellDataAddress = reinterpret_cast< size_t >( &(mesh->GetCellData()->at(0)) );
     }
-    std::ostringstream cellDataStream;
-    cellDataStream <<  "data:application/vnd.itk.address,0:";
-    cellDataStream << cellDataAddress;
-    meshJSON.cellData = cellDataStream.str();
+    meshJSON.cellData = static_cast<uint64_t>(cellDataAddress);
   }
   else
   {
@@ -167,8 +156,11 @@ auto meshToMeshJSON(const TMesh * mesh, const WasmMesh<TMesh> * wasmMesh, bool i
     meshJSON.cellData = "data:application/vnd.itk.path,data/cell-data.raw";
   }
 
-  auto dictionary = mesh->GetMetaDataDictionary();
-  metaDataDictionaryToJSON(dictionary, meshJSON.metadata);
+  if (withMetadata)
+  {
+    auto dictionary = mesh->GetMetaDataDictionary();
+    metaDataDictionaryToJSON(dictionary, meshJSON.metadata);
+  }
 
   return meshJSON;
 }
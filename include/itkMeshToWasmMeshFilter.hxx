@@ -19,6 +19,7 @@
 #define itkMeshToWasmMeshFilter_hxx
 
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -129,15 +130,21 @@ MeshToWasmMeshFilter<TMesh>
 
   wasmMesh->SetMesh(mesh);
   constexpr bool inMemory = true;
-  const auto meshJSON = meshToMeshJSON<MeshType>(mesh, wasmMesh, inMemory);
+  const auto meshJSON = meshToMeshJSON<MeshType>(mesh, wasmMesh, inMemory, !this->m_LazyMetadata);
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(meshJSON, serialized);
+  auto ec = writeDescriptor(meshJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize MeshJSON");
   }
 
   wasmMesh->SetJSON(serialized);
+  wasmMesh->SetBinaryDescriptor(this->m_BinaryDescriptor);
+  if (this->m_LazyMetadata)
+  {
+    // Shares the dictionary entries until either copy is modified
+    wasmMesh->SetMetaDataDictionary(mesh->GetMetaDataDictionary());
+  }
 }
 
 template <typename TMesh>
@@ -146,6 +153,8 @@ MeshToWasmMeshFilter<TMesh>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
+  os << indent << "LazyMetadata: " << this->m_LazyMetadata << std::endl;
 }
 } // end namespace itk
 
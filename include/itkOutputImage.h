@@ -57,6 +57,46 @@ public:
     return this->m_Image.GetPointer();
   }
 
+  /** Write the pixels of the source's primary output directly into the
+   * buffer the host pre-allocated with itk_wasm_output_array_alloc, if any.
+   *
+   * Call after the pipeline is parsed and before the source is updated. The
+   * buffer is imported when the source starts generating data, after its
+   * outputs have been re-initialized, so the following Allocate() reuses it.
+   * If the host did not provide a buffer, or it is too small for the
+   * requested region, ITK allocates the output as usual and the host copies
+   * from the address reported by itk_wasm_output_array_address. */
+  void UseOutputBuffer(ProcessObject * source)
+  {
+#ifndef ITK_WASM_NO_MEMORY_IO
+    if (!wasm::Pipeline::get_use_memory_io() || this->m_Identifier.empty())
+    {
+      return;
+    }
+    const auto index = std::stoi(this->m_Identifier);
+    const auto buffer = getMemoryStoreOutputArrayBuffer(0, index, 0);
+    if (buffer.first == 0)
+    {
+      return;
+    }
+    source->AddObserver(StartEvent(), [source, buffer](const EventObject &) {
+      auto * image = dynamic_cast<ImageType *>(source->GetPrimaryOutput());
+      if (image == nullptr)
+      {
+        return;
+      }
+      using PixelContainerType = typename ImageType::PixelContainer;
+      using ElementType = typename PixelContainerType::Element;
+      auto pixelContainer = PixelContainerType::New();
+      const bool letContainerManageMemory = false;
+      pixelContainer->SetImportPointer(reinterpret_cast<ElementType *>(buffer.first),
+                                       buffer.second / sizeof(ElementType),
+                                       letContainerManageMemory);
+      image->SetPixelContainer(pixelContainer);
+    });
+#endif
+  }
+
   /** FileName or output index. */
   void SetIdentifier(const std::string & identifier)
   {
@@ -69,6 +109,11 @@ public:
 
   OutputImage() = default;
   ~OutputImage() {
+    ProfileScope profileScope("write output image", "output");
+    if (!this->m_Image.IsNull())
+    {
+      profileScope.SetBytes(this->m_Image->GetPixelContainer()->Size() * sizeof(typename ImageType::InternalPixelType));
+    }
     if(wasm::Pipeline::get_use_memory_io())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -76,6 +121,8 @@ public:
       {
         using ImageToWasmImageFilterType = ImageToWasmImageFilter<ImageType>;
         auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+        imageToWasmImageFilter->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
+        imageToWasmImageFilter->SetLazyMetadata(wasm::Pipeline::get_use_lazy_metadata());
         imageToWasmImageFilter->SetInput(this->m_Image);
         imageToWasmImageFilter->Update();
         auto wasmImage = imageToWasmImageFilter->GetOutput();
@@ -41,6 +41,11 @@ namespace wasm
  * This mesh is written to the filesystem or memory when it goes out of scope.
  * 
  * Call `GetMesh()` to get the TMesh * to use an input to a pipeline.
+ *
+ * Unlike OutputImage::UseOutputBuffer, there is no host-provided output
+ * buffer for meshes: mesh filters fill their point and cell containers
+ * incrementally, so the size is not known before the update and the
+ * containers cannot adopt a buffer. The mesh arrays are copied by the host.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -70,6 +75,11 @@ public:
 
   OutputMesh() = default;
   ~OutputMesh() {
+    ProfileScope profileScope("write output mesh", "output");
+    if (!this->m_Mesh.IsNull())
+    {
+      profileScope.SetBytes(this->m_Mesh->GetNumberOfPoints() * sizeof(typename MeshType::PointType));
+    }
     if(wasm::Pipeline::get_use_memory_io())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
@@ -77,6 +87,8 @@ public:
       {
         using MeshToWasmMeshFilterType = MeshToWasmMeshFilter<MeshType>;
         auto meshToWasmMeshFilter = MeshToWasmMeshFilterType::New();
+        meshToWasmMeshFilter->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
+        meshToWasmMeshFilter->SetLazyMetadata(wasm::Pipeline::get_use_lazy_metadata());
         meshToWasmMeshFilter->SetInput(this->m_Mesh);
         meshToWasmMeshFilter->Update();
         auto wasmMesh = meshToWasmMeshFilter->GetOutput();
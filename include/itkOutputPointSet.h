@@ -78,6 +78,8 @@ public:
       {
         using PointSetToWasmPointSetFilterType = PointSetToWasmPointSetFilter<PointSetType>;
         auto pointSetToWasmPointSetFilter = PointSetToWasmPointSetFilterType::New();
+        pointSetToWasmPointSetFilter->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
+        pointSetToWasmPointSetFilter->SetLazyMetadata(wasm::Pipeline::get_use_lazy_metadata());
         pointSetToWasmPointSetFilter->SetInput(this->m_PointSet);
         pointSetToWasmPointSetFilter->Update();
         auto wasmPointSet = pointSetToWasmPointSetFilter->GetOutput();
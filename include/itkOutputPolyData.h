@@ -78,6 +78,8 @@ public:
       {
         using PolyDataToWasmPolyDataFilterType = PolyDataToWasmPolyDataFilter<PolyDataType>;
         auto polyDataToWasmPolyDataFilter = PolyDataToWasmPolyDataFilterType::New();
+        polyDataToWasmPolyDataFilter->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
+        polyDataToWasmPolyDataFilter->SetLazyMetadata(wasm::Pipeline::get_use_lazy_metadata());
         polyDataToWasmPolyDataFilter->SetInput(this->m_PolyData);
         polyDataToWasmPolyDataFilter->Update();
         auto wasmPolyData = polyDataToWasmPolyDataFilter->GetOutput();
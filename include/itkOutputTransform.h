@@ -78,6 +78,7 @@ public:
       {
         using TransformToWasmTransformFilterType = TransformToWasmTransformFilter<TransformType>;
         auto transformToWasmTransformFilter = TransformToWasmTransformFilterType::New();
+        transformToWasmTransformFilter->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
         transformToWasmTransformFilter->SetTransform(this->m_Transform.GetPointer());
         transformToWasmTransformFilter->Update();
         auto wasmTransform = transformToWasmTransformFilter->GetOutput();
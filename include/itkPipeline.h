@@ -28,9 +28,25 @@
 
 #include "glaze/glaze.hpp"
 
+#include "itkWasmProfiler.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+
 #include "WebAssemblyInterfaceExport.h"
 
 
+// Exit after the help, interface or version output. In batch mode, only the
+// invocation ends.
+#define ITK_WASM_PARSE_EXIT() \
+    if (itk::wasm::Pipeline::get_in_batch()) \
+    { \
+      return EXIT_SUCCESS; \
+    } \
+    std::exit(0);
+
 // Short circuit help output without raising an exception (currently not
 // available in WASI)
 #define ITK_WASM_PARSE(pipeline) \
@@ -43,17 +59,17 @@
             if (arg == "-h" || arg == "--help") \
             { \
               (pipeline).exit(CLI::CallForAllHelp()); \
-              std::exit(0); \
+              ITK_WASM_PARSE_EXIT() \
             } \
             if (arg == "--interface-json") \
             { \
               (pipeline).interface_json(); \
-              std::exit(0); \
+              ITK_WASM_PARSE_EXIT() \
             } \
             if (arg == "--version") \
             { \
               std::cout << "Version: " << (pipeline).version() << std::endl; \
-              std::exit(0); \
+              ITK_WASM_PARSE_EXIT() \
             } \
           } \
         (pipeline).parse(); \
@@ -79,9 +95,19 @@
     (pipeline).set_help_flag("-h,--help", "Print this help message and exit"); \
     (pipeline).clear();
 
+// Define main for a pipeline function with the signature of main. Called
+// with `--batch <file.jsonl>`, or `--batch -` for the standard input, the
+// pipeline runs once per line, a JSON array of arguments, in one process.
+#define ITK_WASM_PIPELINE_MAIN(pipelineMain) \
+  int main(int argc, char * argv[]) \
+  { \
+    return itk::wasm::Pipeline::run(argc, argv, pipelineMain); \
+  }
+
 #define ITK_WASM_CATCH_EXCEPTION(pipeline, command) \
   try \
   { \
+    itk::wasm::ProfileScope iwpProfileScope(#command, "pipeline"); \
     command; \
   } \
   catch (const itk::ExceptionObject & excp) \
@@ -118,6 +144,8 @@ using CLI::ParseError;
 using CLI::Success;
 using CLI::Config;
 
+struct WasmPipelineStatus;
+
 /**
  * @brief Create a glaze arrat_t value from an STL style container.
  *
@@ -141,15 +169,75 @@ public:
     /** Exit. */
     auto exit(const CLI::Error &e) -> int;
 
-    void parse() {
-        CLI::App::parse(m_argc, m_argv);
-    }
+    /** Parse the arguments, and record the stage in the `--profile` trace. */
+    void parse();
+
+    /** The Pipeline of the invocation running on the calling thread, or
+     * nullptr. The invocation state is kept by this Pipeline, so pipelines
+     * can run concurrently on different threads. */
+    static Pipeline * get_current();
+
+    /** Whether the invocation on the calling thread uses memory IO. */
+    static bool get_use_memory_io();
+
+    /** Whether the calling thread runs the pipeline as one invocation of a
+     * batch. */
+    static bool get_in_batch();
+
+    /** Profiler of the invocation on the calling thread, when it was called
+     * with `--profile <file>` or `--profile=<file>`, otherwise nullptr. The trace is written when
+     * the Pipeline is destroyed. */
+    static Profiler * get_profiler();
+
+    /** Status block of the invocation running on the calling thread, or
+     * nullptr. It is the block exported with itk_wasm_progress_address when
+     * the Pipeline was made, and is always nullptr without memory IO. */
+    static WasmPipelineStatus * get_status();
 
-    static auto get_use_memory_io()
+    /** Observe the process object: report its progress in the status block
+     * of the invocation, abort it when the host sets the abort flag there,
+     * and record its updates in the `--profile` trace. */
+    static void observe_process(ProcessObject * process);
+
+    /** Observe an optimizer run by the process, e.g. by an image registration
+     * method, which does not report progress itself: report its iterations
+     * as the progress of the process, and stop it when the host sets the
+     * abort flag. Call observe_process on the process too. */
+    template <typename TOptimizer>
+    static void observe_optimizer(ProcessObject * process, TOptimizer * optimizer)
     {
-      return m_UseMemoryIO;
+      optimizer->AddObserver(IterationEvent(), [process, optimizer](const EventObject &) {
+        const auto numberOfIterations = optimizer->GetNumberOfIterations();
+        if (numberOfIterations > 0)
+        {
+          const float progress = static_cast<float>(optimizer->GetCurrentIteration() + 1) / numberOfIterations;
+          process->UpdateProgress(progress < 1.0f ? progress : 1.0f);
+        }
+        if (process->GetAbortGenerateData())
+        {
+          optimizer->StopOptimization();
+        }
+      });
     }
 
+    using MainFunctionType = int (*)(int, char **);
+
+    /** Run pipelineMain with the arguments, or, with `--batch <file.jsonl>`,
+     * once per line of the batch file. Each line is a JSON array of the
+     * arguments that follow the executable name. The exit code and wall time
+     * of each invocation are reported as a JSON line on the standard error.
+     * Returns non-zero when an invocation failed. */
+    static int run(int argc, char ** argv, MainFunctionType pipelineMain);
+
+    /** Whether the host requested binary (BEVE) descriptors for memory IO
+     * outputs with --binary-descriptors. Input descriptors are JSON. */
+    static bool get_use_binary_descriptors();
+
+    /** Whether memory IO output metadata is left out of the descriptors and
+     * serialized only when the host requests it with
+     * itk_wasm_output_metadata_address. */
+    static bool get_use_lazy_metadata();
+
     int get_argc() const
     {
       return m_argc;
@@ -172,12 +260,56 @@ public:
 
     void interface_json();
 
+    /** Input data already read or converted from the argument in this
+     * invocation, or nullptr. CLI11 calls lexical_cast on every parse, e.g.
+     * in both ITK_WASM_PRE_PARSE and ITK_WASM_PARSE, so the input types
+     * memoize their data to materialize it once. */
+    template <typename TData>
+    static const TData * get_parsed_input(const std::string & input)
+    {
+      const Pipeline * pipeline = get_current();
+      if (pipeline == nullptr)
+      {
+        return nullptr;
+      }
+      const auto parsed = pipeline->m_ParsedInputs.find(parsed_input_key<TData>(input));
+      if (parsed == pipeline->m_ParsedInputs.end())
+      {
+        return nullptr;
+      }
+      return dynamic_cast<const TData *>(parsed->second.GetPointer());
+    }
+
+    template <typename TData>
+    static void set_parsed_input(const std::string & input, const TData * data)
+    {
+      Pipeline * pipeline = get_current();
+      if (pipeline != nullptr)
+      {
+        pipeline->m_ParsedInputs[parsed_input_key<TData>(input)] = data;
+      }
+    }
+
     ~Pipeline() override;
 private:
-    static bool m_UseMemoryIO;
+    template <typename TData>
+    static std::string parsed_input_key(const std::string & input)
+    {
+      return std::string(typeid(TData).name()) + '\n' + input;
+    }
+
+    bool m_UseMemoryIO{ false };
+    bool m_UseBinaryDescriptors{ false };
+    bool m_UseLazyMetadata{ false };
+    std::map<std::string, LightObject::ConstPointer> m_ParsedInputs;
+    std::unique_ptr<Profiler> m_Profiler;
+    WasmPipelineStatus * m_Status{ nullptr };
+    /** Pipeline that was current on the thread when this one was made. */
+    Pipeline * m_PreviousPipeline{ nullptr };
     int m_argc;
     char **m_argv;
     std::string m_Version;
+    Profiler::TimePoint m_StartTime;
 };
 
 
@@ -27,6 +27,7 @@
 #include "itkPixelTypesJSON.h"
 #include "itkWasmPointSet.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -60,16 +61,16 @@ namespace itk
     std::string name { "PointSet"};
 
     size_t numberOfPoints{ 0 };
-    std::string points;
+    DescriptorArrayJSON points;
 
     size_t numberOfPointPixels{ 0 };
-    std::string pointData;
+    DescriptorArrayJSON pointData;
 
     MetadataJSON metadata;
   };
 
 template<typename TPointSet>
-auto pointSetToPointSetJSON(const TPointSet * pointSet, const WasmPointSet<TPointSet> * wasmPointSet, bool inMemory) -> PointSetJSON
+auto pointSetToPointSetJSON(const TPointSet * pointSet, const WasmPointSet<TPointSet> * wasmPointSet, bool inMemory, bool withMetadata = true) -> PointSetJSON
 {
   using PointSetType = TPointSet;
 
@@ -97,20 +98,14 @@ auto pointSetToPointSetJSON(const TPointSet * pointSet, const WasmPointSet<TPoin
   if (inMemory)
   {
     const auto pointsAddress = reinterpret_cast< size_t >( &(pointSet->GetPoints()->at(0)) );
-    std::ostringstream pointsStream;
-    pointsStream << "data:application/vnd.itk.address,0:";
-    pointsStream << pointsAddress;
-    pointSetJSON.points = pointsStream.str();
+    pointSetJSON.points = static_cast<uint64_t>(pointsAddress);
 
     size_t pointDataAddress = 0;
     if (pointSet->GetPointData() != nullptr && pointSet->GetPointData()->Size() > 0)
     {
       pointDataAddress = reinterpret_cast< size_t >( &(pointSet->GetPointData()->at(0)) );
     }
-    std::ostringstream pointDataStream;
-    pointDataStream << "data:application/vnd.itk.address,0:";
-    pointDataStream << pointDataAddress;
-    pointSetJSON.pointData = pointDataStream.str();
+    pointSetJSON.pointData = static_cast<uint64_t>(pointDataAddress);
   }
   else
   {
@@ -118,8 +113,11 @@ auto pointSetToPointSetJSON(const TPointSet * pointSet, const WasmPointSet<TPoin
     pointSetJSON.pointData = "data:application/vnd.itk.path,data/point-data.raw";
   }
 
-  auto dictionary = pointSet->GetMetaDataDictionary();
-  metaDataDictionaryToJSON(dictionary, pointSetJSON.metadata);
+  if (withMetadata)
+  {
+    auto dictionary = pointSet->GetMetaDataDictionary();
+    metaDataDictionaryToJSON(dictionary, pointSetJSON.metadata);
+  }
 
   return pointSetJSON;
 }
@@ -19,6 +19,7 @@
 #define itkPointSetToWasmPointSetFilter_hxx
 
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -129,15 +130,21 @@ PointSetToWasmPointSetFilter<TPointSet>
 
   wasmPointSet->SetPointSet(pointSet);
   constexpr bool inMemory = true;
-  const auto pointSetJSON = pointSetToPointSetJSON<PointSetType>(pointSet, wasmPointSet, inMemory);
+  const auto pointSetJSON = pointSetToPointSetJSON<PointSetType>(pointSet, wasmPointSet, inMemory, !this->m_LazyMetadata);
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(pointSetJSON, serialized);
+  auto ec = writeDescriptor(pointSetJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize PointSetJSON");
   }
 
   wasmPointSet->SetJSON(serialized);
+  wasmPointSet->SetBinaryDescriptor(this->m_BinaryDescriptor);
+  if (this->m_LazyMetadata)
+  {
+    // Shares the dictionary entries until either copy is modified
+    wasmPointSet->SetMetaDataDictionary(pointSet->GetMetaDataDictionary());
+  }
 }
 
 template <typename TPointSet>
@@ -146,6 +153,8 @@ PointSetToWasmPointSetFilter<TPointSet>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
+  os << indent << "LazyMetadata: " << this->m_LazyMetadata << std::endl;
 }
 } // end namespace itk
 
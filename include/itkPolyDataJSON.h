@@ -27,6 +27,7 @@
 #include "itkPixelTypesJSON.h"
 #include "itkWasmPolyData.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -61,31 +62,31 @@ namespace itk
     std::string name { "PolyData" };
 
     size_t numberOfPoints{ 0 };
-    std::string points;
+    DescriptorArrayJSON points;
 
     size_t verticesBufferSize { 0 };
-    std::string vertices;
+    DescriptorArrayJSON vertices;
 
     size_t linesBufferSize { 0 };
-    std::string lines;
+    DescriptorArrayJSON lines;
 
     size_t polygonsBufferSize { 0 };
-    std::string polygons;
+    DescriptorArrayJSON polygons;
 
     size_t triangleStripsBufferSize { 0 };
-    std::string triangleStrips;
+    DescriptorArrayJSON triangleStrips;
 
     size_t numberOfPointPixels { 0 };
-    std::string pointData;
+    DescriptorArrayJSON pointData;
 
     size_t numberOfCellPixels { 0 };
-    std::string cellData;
+    DescriptorArrayJSON cellData;
 
     MetadataJSON metadata;
   };
 
 template<typename TPolyData>
-auto polyDataToPolyDataJSON(const TPolyData * polyData, bool inMemory) -> PolyDataJSON
+auto polyDataToPolyDataJSON(const TPolyData * polyData, bool inMemory, bool withMetadata = true) -> PolyDataJSON
 {
   using PolyDataType = TPolyData;
 
@@ -141,73 +142,55 @@ auto polyDataToPolyDataJSON(const TPolyData * polyData, bool inMemory) -> PolyDa
   {
     pointsAddress = reinterpret_cast< size_t >( &(polyData->GetPoints()->at(0)) );
   }
-  std::ostringstream pointsStream;
-  pointsStream << "data:application/vnd.itk.address,0:";
-  pointsStream << pointsAddress;
-  polyDataJSON.points = pointsStream.str();
+  polyDataJSON.points = static_cast<uint64_t>(pointsAddress);
 
   size_t verticesAddress = 0;
   if (polyData->GetVertices() != nullptr && polyData->GetVertices()->Size() > 0)
   {
     verticesAddress = reinterpret_cast< size_t >( &(polyData->GetVertices()->at(0)) );
   }
-  std::ostringstream verticesStream;
-  verticesStream << "data:application/vnd.itk.address,0:";
-  verticesStream << verticesAddress;
-  polyDataJSON.vertices = verticesStream.str();
+  polyDataJSON.vertices = static_cast<uint64_t>(verticesAddress);
 
   size_t linesAddress = 0;
   if (polyData->GetLines() != nullptr && polyData->GetLines()->Size() > 0)
   {
     linesAddress = reinterpret_cast< size_t >( &(polyData->GetLines()->at(0)) );
   }
-  std::ostringstream linesStream;
-  linesStream << "data:application/vnd.itk.address,0:";
-  linesStream << linesAddress;
-  polyDataJSON.lines = linesStream.str();
+  polyDataJSON.lines = static_cast<uint64_t>(linesAddress);
 
   size_t polygonsAddress = 0;
   if (polyData->GetPolygons() != nullptr && polyData->GetPolygons()->Size() > 0)
   {
     polygonsAddress = reinterpret_cast< size_t >( &(polyData->GetPolygons()->at(0)) );
   }
-  std::ostringstream polygonsStream;
-  polygonsStream << "data:application/vnd.itk.address,0:";
-  polygonsStream << polygonsAddress;
-  polyDataJSON.polygons = polygonsStream.str();
+  polyDataJSON.polygons = static_cast<uint64_t>(polygonsAddress);
 
   size_t triangleStripsAddress = 0;
   if (polyData->GetTriangleStrips() != nullptr && polyData->GetTriangleStrips()->Size() > 0)
   {
     triangleStripsAddress = reinterpret_cast< size_t >( &(polyData->GetTriangleStrips()->at(0)) );
   }
-  std::ostringstream triangleStripsStream;
-  triangleStripsStream << "data:application/vnd.itk.address,0:";
-  triangleStripsStream << triangleStripsAddress;
-  polyDataJSON.triangleStrips = triangleStripsStream.str();
+  polyDataJSON.triangleStrips = static_cast<uint64_t>(triangleStripsAddress);
 
   size_t pointDataAddress = 0;
   if (polyData->GetPointData() != nullptr && polyData->GetPointData()->Size() > 0)
   {
     pointDataAddress = reinterpret_cast< size_t >( &(polyData->GetPointData()->at(0)) );
   }
-  std::ostringstream pointDataStream;
-  pointDataStream << "data:application/vnd.itk.address,0:";
-  pointDataStream << pointDataAddress;
-  polyDataJSON.pointData = pointDataStream.str();
+  polyDataJSON.pointData = static_cast<uint64_t>(pointDataAddress);
 
   size_t cellDataAddress = 0;
   if (polyData->GetCellData() != nullptr && polyData->GetCellData()->Size() > 0)
   {
     cellDataAddress = reinterpret_cast< size_t >( &(polyData->GetCellData()->at(0)) );
   }
-  std::ostringstream cellDataStream;
-  cellDataStream <<  "data:application/vnd.itk.address,0:";
-  cellDataStream << cellDataAddress;
-  polyDataJSON.cellData = cellDataStream.str();
+  polyDataJSON.cellData = static_cast<uint64_t>(cellDataAddress);
 
-  auto dictionary = polyData->GetMetaDataDictionary();
-  metaDataDictionaryToJSON(dictionary, polyDataJSON.metadata);
+  if (withMetadata)
+  {
+    auto dictionary = polyData->GetMetaDataDictionary();
+    metaDataDictionaryToJSON(dictionary, polyDataJSON.metadata);
+  }
 
   return polyDataJSON;
 }
@@ -75,6 +75,17 @@ public:
   WasmPolyDataType *
   GetOutput(unsigned int idx);
 
+  /** Serialize the descriptor in the binary (BEVE) encoding instead of JSON. */
+  itkSetMacro(BinaryDescriptor, bool);
+  itkGetConstMacro(BinaryDescriptor, bool);
+  itkBooleanMacro(BinaryDescriptor);
+
+  /** Leave the metadata out of the descriptor. The output keeps a copy of
+   * the metadata dictionary, so it can be serialized on request. */
+  itkSetMacro(LazyMetadata, bool);
+  itkGetConstMacro(LazyMetadata, bool);
+  itkBooleanMacro(LazyMetadata);
+
 protected:
   PolyDataToWasmPolyDataFilter();
   ~PolyDataToWasmPolyDataFilter() override = default;
@@ -92,6 +103,9 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool m_BinaryDescriptor{ false };
+  bool m_LazyMetadata{ false };
 };
 } // end namespace itk
 
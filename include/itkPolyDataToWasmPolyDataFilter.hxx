@@ -19,6 +19,7 @@
 #define itkPolyDataToWasmPolyDataFilter_hxx
 
 #include "itkPolyDataToWasmPolyDataFilter.h"
+#include "itkWasmDescriptor.h"
 
 #include "itkMeshConvertPixelTraits.h"
 
@@ -135,15 +136,21 @@ PolyDataToWasmPolyDataFilter<TPolyData>
   wasmPolyData->SetPolyData(polyData);
 
   constexpr bool inMemory = true;
-  const auto polyDataJSON = polyDataToPolyDataJSON<PolyDataType>(polyData, inMemory);
+  const auto polyDataJSON = polyDataToPolyDataJSON<PolyDataType>(polyData, inMemory, !this->m_LazyMetadata);
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(polyDataJSON, serialized);
+  auto ec = writeDescriptor(polyDataJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize PolyDataJSON");
   }
 
   wasmPolyData->SetJSON(serialized);
+  wasmPolyData->SetBinaryDescriptor(this->m_BinaryDescriptor);
+  if (this->m_LazyMetadata)
+  {
+    // Shares the dictionary entries until either copy is modified
+    wasmPolyData->SetMetaDataDictionary(polyData->GetMetaDataDictionary());
+  }
 }
 
 template <typename TPolyData>
@@ -152,6 +159,8 @@ PolyDataToWasmPolyDataFilter<TPolyData>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
+  os << indent << "LazyMetadata: " << this->m_LazyMetadata << std::endl;
 }
 } // end namespace itk
 
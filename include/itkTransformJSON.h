@@ -24,6 +24,7 @@
 
 #include "itkCompositeTransformIOHelper.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmDescriptor.h"
 
 #include "glaze/glaze.hpp"
 
@@ -92,8 +93,8 @@ namespace itk
     std::string inputSpaceName;
     std::string outputSpaceName;
 
-    std::string fixedParameters;
-    std::string parameters;
+    DescriptorArrayJSON fixedParameters;
+    DescriptorArrayJSON parameters;
 
     MetadataJSON metadata;
   };
@@ -299,22 +300,13 @@ auto transformListToTransformListJSON(std::list<typename TTransformBase::ConstPo
       if (pString == "CompositeTransform")
       {
         // For composite transforms, we don't store the parameters in memory directly
-        transformJSON.fixedParameters = "data:application/vnd.itk.address,0:0";
-        transformJSON.parameters = "data:application/vnd.itk.address,0:0";
+        transformJSON.fixedParameters = uint64_t{ 0 };
+        transformJSON.parameters = uint64_t{ 0 };
       }
       else
       {
-        std::ostringstream fixedParametersStream;
-        fixedParametersStream << "data:application/vnd.itk.address,0:";
-        const auto fixedParametersAddr = reinterpret_cast< size_t >( currentTransform->GetFixedParameters().data_block() );
-        fixedParametersStream << fixedParametersAddr;
-        transformJSON.fixedParameters = fixedParametersStream.str();
-
-        std::ostringstream parametersStream;
-        parametersStream << "data:application/vnd.itk.address,0:";
-        const auto parametersAddr = reinterpret_cast< size_t >( currentTransform->GetParameters().data_block() );
-        parametersStream << parametersAddr;
-        transformJSON.parameters = parametersStream.str();
+        transformJSON.fixedParameters = descriptorArray(currentTransform->GetFixedParameters().data_block());
+        transformJSON.parameters = descriptorArray(currentTransform->GetParameters().data_block());
       }
     }
     else
@@ -65,6 +65,11 @@ public:
   WasmTransformType *
   GetOutput(unsigned int idx);
 
+  /** Serialize the descriptor in the binary (BEVE) encoding instead of JSON. */
+  itkSetMacro(BinaryDescriptor, bool);
+  itkGetConstMacro(BinaryDescriptor, bool);
+  itkBooleanMacro(BinaryDescriptor);
+
 protected:
   TransformToWasmTransformFilter();
   ~TransformToWasmTransformFilter() override = default;
@@ -82,6 +87,8 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool m_BinaryDescriptor{ false };
 };
 } // end namespace itk
 
@@ -21,6 +21,7 @@
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
 #include "itkTransformJSON.h"
+#include "itkWasmDescriptor.h"
 
 namespace itk
 {
@@ -104,13 +105,14 @@ TransformToWasmTransformFilter<TTransform>
   const TransformListJSON transformListJSON = transformListToTransformListJSON<TransformBaseType>(transformList, inMemory);
 
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(transformListJSON, serialized);
+  auto ec = writeDescriptor(transformListJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize TransformListJSON");
   }
 
   wasmTransform->SetJSON(serialized);
+  wasmTransform->SetBinaryDescriptor(this->m_BinaryDescriptor);
 }
 
 template <typename TTransform>
@@ -119,6 +121,7 @@ TransformToWasmTransformFilter<TTransform>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmBase64_h
+#define itkWasmBase64_h
+// Vectorized base64 encoding and decoding, and stream buffers that apply it
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+namespace itk
+{
+
+/** Number of characters of the padded base64 encoding of length bytes. */
+constexpr size_t
+base64EncodedLength(size_t length)
+{
+  return (length + 2) / 3 * 4;
+}
+
+/** Encode length bytes with the standard alphabet and padding. The output
+ * holds base64EncodedLength(length) characters. Returns the number written.
+ *
+ * SSSE3 and AVX2 kernels are selected at run time on x86-64, and the
+ * wasm simd128 kernel is used when it is enabled at compile time. */
+WebAssemblyInterface_EXPORT
+size_t
+base64Encode(const void * input, size_t length, char * output);
+
+/** Decode length characters of base64 without whitespace. Padding is only
+ * accepted at the end. The output holds length / 4 * 3 bytes. Returns the
+ * number of bytes written. Throws std::invalid_argument on invalid input. */
+WebAssemblyInterface_EXPORT
+size_t
+base64Decode(const char * input, size_t length, void * output);
+
+/** Base64 encodes the bytes written to it onto the sink.
+ *
+ * Writes are encoded in blocks directly from the caller's buffer. Finish()
+ * writes the last, padded, group. */
+class WebAssemblyInterface_EXPORT Base64OutputStreamBuffer: public std::streambuf
+{
+public:
+  explicit Base64OutputStreamBuffer(std::ostream & sink);
+
+  /** Encode the remaining bytes with padding. */
+  void Finish();
+
+protected:
+  std::streamsize xsputn(const char * data, std::streamsize count) override;
+  int_type overflow(int_type character) override;
+
+private:
+  std::ostream & m_Sink;
+  unsigned char m_Pending[3];
+  size_t m_PendingCount{ 0 };
+  std::vector<char> m_Encoded;
+};
+
+/** Decodes base64 read from the source. Whitespace is skipped. */
+class WebAssemblyInterface_EXPORT Base64InputStreamBuffer: public std::streambuf
+{
+public:
+  explicit Base64InputStreamBuffer(std::istream & source);
+
+protected:
+  int_type underflow() override;
+
+private:
+  std::istream & m_Source;
+  std::vector<char> m_Text;
+  size_t m_TextCount{ 0 };
+  std::vector<char> m_Decoded;
+  bool m_Finished{ false };
+};
+
+} // end namespace itk
+
+#endif // itkWasmBase64_h
@@ -45,8 +45,24 @@ public:
   itkNewMacro(Self);
   itkTypeMacro(WasmDataObject, DataObject);
 
-  /** Get/Set the DataObject JSON representation. */
-  itkSetStringMacro(JSON);
+  /** Get/Set the DataObject JSON representation.
+   *
+   * The representation may also be a binary (BEVE) descriptor, which can
+   * contain null bytes, so the std::string overload keeps its full size. */
+  virtual void
+  SetJSON(const char * json)
+  {
+    this->SetJSON(std::string(json ? json : ""));
+  }
+  virtual void
+  SetJSON(const std::string & json)
+  {
+    if (json != this->m_JSON)
+    {
+      this->m_JSON = json;
+      this->Modified();
+    }
+  }
   virtual const std::string & GetJSON() const
   {
     return this->m_JSON;
@@ -58,6 +74,12 @@ public:
   itkGetConstObjectMacro(DataObject, DataObject);
   itkSetObjectMacro(DataObject, DataObject);
 
+  /** Get/Set whether the representation is a binary (BEVE) descriptor
+   * instead of JSON. */
+  itkSetMacro(BinaryDescriptor, bool);
+  itkGetConstMacro(BinaryDescriptor, bool);
+  itkBooleanMacro(BinaryDescriptor);
+
 protected:
   WasmDataObject() = default;
   ~WasmDataObject() override = default;
@@ -66,6 +88,7 @@ protected:
 
   std::string m_JSON;
   DataObject::ConstPointer m_DataObject;
+  bool m_BinaryDescriptor{ false };
 };
 
 } // end namespace itk
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmDescriptor_h
+#define itkWasmDescriptor_h
+
+#include "glaze/glaze.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace itk
+{
+
+/** Reference to an array from an interface object descriptor.
+ *
+ * Arrays in memory are referenced by their address as a native integer.
+ * Arrays in a file are referenced with a `data:application/vnd.itk.path,<path>`
+ * string. Hosts that predate integer addresses send a
+ * `data:application/vnd.itk.address,0:<address>` string, which is still
+ * accepted when reading. */
+using DescriptorArrayJSON = std::variant<uint64_t, std::string>;
+
+/** Reference an array in memory. */
+inline DescriptorArrayJSON
+descriptorArray(const void * address)
+{
+  return static_cast<uint64_t>(reinterpret_cast<size_t>(address));
+}
+
+/** Address of an array in memory, or 0 when the array is not in memory. */
+inline size_t
+descriptorArrayAddress(const DescriptorArrayJSON & array)
+{
+  if (const auto * address = std::get_if<uint64_t>(&array))
+  {
+    return static_cast<size_t>(*address);
+  }
+  constexpr std::string_view addressPrefix = "data:application/vnd.itk.address,0:";
+  const std::string & uri = std::get<std::string>(array);
+  if (uri.compare(0, addressPrefix.size(), addressPrefix) != 0)
+  {
+    return 0;
+  }
+  return static_cast<size_t>(std::strtoull(uri.c_str() + addressPrefix.size(), nullptr, 10));
+}
+
+template <typename T>
+T *
+descriptorArrayPointer(const DescriptorArrayJSON & array)
+{
+  return reinterpret_cast<T *>(descriptorArrayAddress(array));
+}
+
+/** Serialize an interface object descriptor, e.g. an ImageJSON or MeshJSON.
+ *
+ * JSON is the default. The binary (BEVE) encoding is only written for output
+ * descriptors when the host requests it with the --binary-descriptors
+ * pipeline flag. */
+template <typename TDescriptor>
+auto
+writeDescriptor(const TDescriptor & descriptor, std::string & serialized, bool binary = false)
+{
+  if (binary)
+  {
+    return glz::write_beve(descriptor, serialized);
+  }
+  return glz::write<glz::opts{ .prettify = true }>(descriptor, serialized);
+}
+
+/** Deserialize an interface object descriptor written in the given encoding. */
+template <typename TDescriptor>
+auto
+readDescriptor(const std::string & serialized, bool binary = false)
+{
+  if (binary)
+  {
+    return glz::read_beve<TDescriptor>(serialized);
+  }
+  return glz::read_json<TDescriptor>(serialized);
+}
+
+} // end namespace itk
+
+#endif
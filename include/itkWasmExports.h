@@ -23,6 +23,13 @@
 
 #include "itkWasmDataObject.h"
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #if defined(__EMSCRIPTEN__)
 #  include "emscripten/em_macros.h"
 #else
@@ -36,21 +43,67 @@ namespace itk
 namespace wasm
 {
 
+// address, size
+using MemoryStoreArrayType = std::pair<size_t, size_t>;
+
 // dataset index, array index
 using InputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
 using InputArrayStoreValueType = std::vector<uint8_t>;
 using InputArrayStoreType = std::map<InputArrayStoreKeyType, InputArrayStoreValueType>;
 
-// Function for the Pipeline Input's and Output's to set / get from the memory store
+// Function for the Pipeline Input's and Output's to set / get from the memory store.
+// Each thread has its own memory store, so the host allocates the inputs and
+// reads the outputs on the thread that runs the pipeline.
 
-WebAssemblyInterface_EXPORT const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index);
+/** Copy of the input JSON allocated with itk_wasm_input_json_alloc.
+ *
+ * Returns an empty string if the JSON has not been allocated. */
+WebAssemblyInterface_EXPORT std::string getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index);
+
+/** Address and size of an input array allocated with itk_wasm_input_array_alloc.
+ *
+ * Returns {0, 0} if the array has not been allocated. */
+WebAssemblyInterface_EXPORT MemoryStoreArrayType getMemoryStoreInputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 
+/** Copy of the input arrays of the calling thread, keyed by (index, subIndex).
+ *
+ * Deprecated: the input arrays now live in the memory store arena, so this
+ * copies every array on each call. Use getMemoryStoreInputArray instead. */
+[[deprecated("Use getMemoryStoreInputArray")]]
 WebAssemblyInterface_EXPORT const InputArrayStoreType & getMemoryInputArrayStore();
 
+/** Largest number of bytes the memory store arena of the calling thread has
+ * had in use. Use this to size the initial memory of the module. */
+WebAssemblyInterface_EXPORT size_t getMemoryStoreHighWaterMark();
+
 WebAssemblyInterface_EXPORT void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject);
 
+/** Address and size of an output buffer pre-allocated by the host with
+ * itk_wasm_output_array_alloc.
+ *
+ * Returns {0, 0} if the host did not provide a buffer. */
+WebAssemblyInterface_EXPORT MemoryStoreArrayType getMemoryStoreOutputArrayBuffer(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
+
 WebAssemblyInterface_EXPORT void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size);
 
+/** Status shared with the host at itk_wasm_progress_address.
+ *
+ * The pipeline stores the progress, in [0, 1], of the process objects it
+ * observes; the host stores a non-zero abort to stop them. Both are read and
+ * written without locking: a float32 at offset 0 and a uint32 at offset 4. */
+struct WasmPipelineStatus
+{
+  std::atomic<float> progress{ 0.0f };
+  std::atomic<uint32_t> abort{ 0 };
+};
+static_assert(sizeof(std::atomic<float>) == 4 && sizeof(std::atomic<uint32_t>) == 4,
+              "The status block layout is shared with the host");
+
+/** Status block that the next pipeline invocation on the calling thread
+ * reports to. A running invocation keeps the block from when it started, see
+ * Pipeline::get_status. */
+WebAssemblyInterface_EXPORT WasmPipelineStatus & getPipelineStatus();
+
 
 } // end namespace wasm
 } // end namespace itk
@@ -61,11 +114,44 @@ extern "C"
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size);
 
+/** Pre-allocate an output buffer before the pipeline runs so the pipeline can
+ * write its result in place. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size);
+
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index);
+/** Metadata JSON of an output written with --lazy-metadata. It is serialized
+ * from the output's metadata dictionary on the first request. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_metadata_address(uint32_t memoryIndex, uint32_t index);
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_metadata_size(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_memory_high_water_mark();
+
+/** Descriptor encodings of the module as a bit mask. 1: JSON descriptors
+ * with array addresses as integers. 2: binary (BEVE) output descriptors,
+ * written when the host passes the --binary-descriptors pipeline flag. */
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_descriptor_encodings();
+
+/** Address of the progress and abort status block.
+ *
+ * In wasm builds the module runs one invocation at a time and the block is a
+ * process global, so the host may look it up before main runs and poll it,
+ * or set abort, from another thread over shared memory. In native builds
+ * each thread has its own block, so look it up on the thread that will run
+ * the invocation.
+ *
+ * The Python host polls the block while a WASI pipeline runs. The
+ * TypeScript host does not: Emscripten pipelines run synchronously on a
+ * worker without shared memory. */
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_progress_address();
+
+/** Release the JSON and arrays of one input or output as soon as the host is
+ * done with it, instead of waiting for itk_wasm_free_all. */
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_input_release(uint32_t memoryIndex, uint32_t index);
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_output_release(uint32_t memoryIndex, uint32_t index);
+
 WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_all();
 
 } // end extern "C"
@@ -26,6 +26,11 @@
 #include "itkCommonEnums.h"
 
 #include <fstream>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "cbor.h"
 
@@ -88,6 +93,111 @@ WebAssemblyInterface_EXPORT
 size_t
 ITKComponentSize( const CommonEnums::IOComponent );
 
+/** CBOR typed array tag, https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml,
+ * for the component type. */
+WebAssemblyInterface_EXPORT
+uint64_t
+cborTypedArrayTag(IOComponentEnum ioComponent);
+
+/** Write the head of a CBOR data item, i.e. its major type and argument. */
+WebAssemblyInterface_EXPORT
+void
+writeCBORHead(std::ostream & outputStream, uint8_t majorType, uint64_t value);
+
+/** Write the key / value pairs of a CBOR map item, without the map head.
+ *
+ * Used to stream the small fields of a map whose head, written with
+ * writeCBORHead, also counts the typed arrays written with
+ * writeCBORTypedArray. */
+WebAssemblyInterface_EXPORT
+void
+writeCBORMapEntries(std::ostream & outputStream, const cbor_item_t * map);
+
+/** Write the key, tag and byte string head of a typed array map entry. The
+ * byte string content is expected to follow. */
+WebAssemblyInterface_EXPORT
+void
+writeCBORTypedArrayHead(std::ostream & outputStream, const char * dataName, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent);
+
+/** Write a map entry with a text string key and a tagged typed array byte string.
+ *
+ * The byte string content is written directly from the buffer provided,
+ * without an intermediate copy. */
+WebAssemblyInterface_EXPORT
+void
+writeCBORTypedArray(std::ostream & outputStream, const char * dataName, const void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent);
+
+/** \brief Read-only view of a file's content
+ *
+ * The file is memory mapped on native POSIX platforms, so its pages are
+ * only loaded when they are accessed. Elsewhere the content is read into
+ * memory.
+ *
+ * With copyOnWrite, the content may be modified in memory through a
+ * const_cast of GetData(). The file is never changed.
+ */
+class WebAssemblyInterface_EXPORT MappedFile
+{
+public:
+  explicit MappedFile(const std::string & fileName, bool copyOnWrite = false);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const unsigned char * GetData() const
+  {
+    return m_Data;
+  }
+  size_t GetLength() const
+  {
+    return m_Length;
+  }
+
+private:
+  const unsigned char * m_Data{ nullptr };
+  size_t m_Length{ 0 };
+  bool m_Mapped{ false };
+  std::vector<unsigned char> m_Buffer;
+};
+
+/** Location of an encoded CBOR data item in a buffer. */
+struct CBORSpan
+{
+  const unsigned char * data{ nullptr };
+  size_t length{ 0 };
+};
+
+/** Entries of the top-level CBOR map in a buffer by their text string keys.
+ *
+ * Only the item headers are walked, so large byte strings are neither
+ * decoded nor copied. With allowTruncated, the buffer may end within the
+ * content of a byte string entry, which is then the last, truncated, entry. */
+WebAssemblyInterface_EXPORT
+std::vector<std::pair<std::string_view, CBORSpan>>
+cborMapEntries(const unsigned char * buffer, size_t length, bool allowTruncated = false);
+
+/** Content of a CBOR byte string item, which may be wrapped in a typed array tag. */
+WebAssemblyInterface_EXPORT
+CBORSpan
+cborByteStringContent(const CBORSpan & item);
+
+/** Releases a decoded CBOR item with cbor_decref. */
+struct CBORItemDeleter
+{
+  void
+  operator()(cbor_item_t * item) const
+  {
+    cbor_decref(&item);
+  }
+};
+using CBORItemPointer = std::unique_ptr<cbor_item_t, CBORItemDeleter>;
+
+/** Decode a single CBOR item, e.g. a small map entry value. */
+WebAssemblyInterface_EXPORT
+CBORItemPointer
+cborLoadItem(const CBORSpan & item);
+
 } // end namespace itk
 
 #endif // itkWasmIOCommon_h
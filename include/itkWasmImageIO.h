@@ -21,6 +21,9 @@
 
 #include "itkStreamingImageIOBase.h"
 #include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "itkImageJSON.h"
 
@@ -36,6 +39,11 @@ namespace itk
  *
  * The file extensions used are .iwi and .iwi.cbor.
  *
+ * With a ChunkSize, the .iwi directory format stores the pixel data in
+ * N-D chunks, and optionally in NumberOfResolutionLevels downsampled
+ * levels, so arbitrary regions of a ResolutionLevel are read and written
+ * without touching the rest of the image.
+ *
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
  */
@@ -91,6 +99,28 @@ public:
    * that the IORegions has been set properly. */
   void Write(const void *buffer) override;
 
+  /** Size of the chunks of the directory format, per dimension, or a single
+   * value for all dimensions. Empty, the default, writes a single data file. */
+  void SetChunkSize(const std::vector<SizeValueType> & chunkSize);
+  const std::vector<SizeValueType> & GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /** Number of resolution levels written with chunks. Level l samples every
+   * 2^l-th pixel along each axis. Defaults to 1, the image only. */
+  itkSetClampMacro(NumberOfResolutionLevels, unsigned int, 1, 32);
+  itkGetConstMacro(NumberOfResolutionLevels, unsigned int);
+
+  /** Resolution level of a chunked image that is read. Defaults to 0, the image. */
+  itkSetMacro(ResolutionLevel, unsigned int);
+  itkGetConstMacro(ResolutionLevel, unsigned int);
+
+  /** File holding the pixel buffer of the directory image read, in the
+   * layout of the image buffer. Empty for the CBOR and chunked layouts.
+   * Valid after ReadImageInformation(). */
+  std::string GetDataFileName() const;
+
 protected:
   WasmImageIO();
   ~WasmImageIO() override;
@@ -101,8 +131,35 @@ protected:
     return 0;
   }
 
-  void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  size_t WriteCBOR(const void * buffer = nullptr, unsigned char ** cborBuffer = nullptr, bool allocateCBORBuffer = false);
+  /** Read the CBOR encoding from the buffer provided, or the file. With
+   * headerOnly, the buffer may end before the content of the data entry. */
+  void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0, bool headerOnly = false);
+  /** Stream the CBOR encoding of the image, and of the pixel buffer if provided. */
+  void WriteCBOR(std::ostream & outputStream, const void * buffer = nullptr);
+  /** Stream the CBOR encoding up to the content of the data entry, which is
+   * included when withData is true and must follow. */
+  void WriteCBORHeader(std::ostream & outputStream, bool withData);
+
+  /** Compression of the chunks written. Empty for uncompressed chunks. */
+  virtual std::string GetChunkCompression() const
+  {
+    return std::string();
+  }
+  /** Read a chunk file of the chunked layout, compressed with the layout's compression. */
+  virtual void ReadChunk(const std::string & fileName, const std::string & compression, void * buffer, SizeValueType numberOfBytes);
+  /** Write a chunk file of the chunked layout. */
+  virtual void WriteChunk(const std::string & fileName, const std::string & compression, const void * buffer, SizeValueType numberOfBytes);
+
+  void ReadChunks(void * buffer);
+  void WriteChunks(const void * buffer);
+  /** Path of a chunk file relative to the image directory. */
+  std::string GetChunkFileName(unsigned int level, const std::vector<SizeValueType> & chunkIndex, const std::string & compression) const;
+
+  std::vector<SizeValueType> m_ChunkSize;
+  unsigned int m_NumberOfResolutionLevels{ 1 };
+  unsigned int m_ResolutionLevel{ 0 };
+  /** Layout of the image read, if it is chunked. */
+  std::optional<ImageChunkedLayoutJSON> m_ChunkedLayout;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmImageIO);
@@ -20,6 +20,7 @@
 
 #include "itkProcessObject.h"
 #include "itkWasmImage.h"
+#include "itkImageJSON.h"
 
 namespace itk
 {
@@ -29,6 +30,13 @@ namespace itk
  *
  * TImage must match the type stored in the JSON representation or an exception will be shown.
  *
+ * When the pixel buffer is provided in chunks along the slowest axis, the
+ * output's requested region is honored: a region within one chunk imports
+ * that chunk without a copy, and a region spanning several chunks copies
+ * only the overlapping chunks. The requested region is the largest possible
+ * region unless a consumer requests a smaller one before the first update,
+ * see InputImage::SetStreaming.
+ *
  * \ingroup WebAssemblyInterface
  */
 template <typename TImage>
@@ -87,13 +95,15 @@ protected:
   MakeOutput(const ProcessObject::DataObjectIdentifierType &) override;
 
   void
-  GenerateOutputInformation() override
-  {} // do nothing
+  GenerateOutputInformation() override;
   void
   GenerateData() override;
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  ImageJSON m_ImageJSON;
 };
 } // end namespace itk
 
@@ -19,9 +19,11 @@
 #define itkWasmImageToImageFilter_hxx
 
 #include "itkWasmImageToImageFilter.h"
+#include "itkWasmDescriptor.h"
 
 #include "itkMetaDataDictionaryJSON.h"
 #include "itkImportVectorImageFilter.h"
+#include <algorithm>
 #include <exception>
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
@@ -129,25 +131,66 @@ WasmImageToImageFilter<TImage>
 template <typename TImage>
 void
 WasmImageToImageFilter<TImage>
-::GenerateData()
+::GenerateOutputInformation()
 {
-  // Get the input and output pointers
   const WasmImageType * wasmImage = this->GetInput();
-  const std::string json(wasmImage->GetJSON());
-  ImageType * image = this->GetOutput();
-
-  using IOPixelType = typename TImage::IOPixelType;
-  using PixelType = typename TImage::PixelType;
-  using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
-  constexpr unsigned int Dimension = TImage::ImageDimension;
+  const std::string & json = wasmImage->GetJSON();
 
-  auto deserializedAttempt = glz::read_json<ImageJSON>(json);
+  auto deserializedAttempt = readDescriptor<ImageJSON>(json, wasmImage->GetBinaryDescriptor());
   if (!deserializedAttempt)
   {
     const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
     itkExceptionMacro("Failed to deserialize imageJSON: " << descriptiveError);
   }
-  auto imageJSON = deserializedAttempt.value();
+  this->m_ImageJSON = std::move(deserializedAttempt.value());
+  const auto & imageJSON = this->m_ImageJSON;
+
+  // The information is available before the pixels so that consumers can
+  // request a region. It is grafted again with the pixel buffer.
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  if (imageJSON.imageType.dimension != Dimension)
+  {
+    itkExceptionMacro("Unexpected dimension: " << imageJSON.imageType.dimension << ", expected " << Dimension);
+  }
+
+  ImageType * image = this->GetOutput();
+
+  typename ImageType::PointType origin;
+  typename ImageType::SpacingType spacing;
+  typename ImageType::RegionType largestRegion;
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    origin[i] = imageJSON.origin[i];
+    spacing[i] = imageJSON.spacing[i];
+    largestRegion.SetIndex(i, 0);
+    largestRegion.SetSize(i, imageJSON.size[i]);
+  }
+  image->SetOrigin(origin);
+  image->SetSpacing(spacing);
+
+  using DirectionType = typename ImageType::DirectionType;
+  const double * directionPtr = descriptorArrayPointer<double>(imageJSON.direction);
+  using VnlMatrixType = typename DirectionType::InternalMatrixType;
+  const VnlMatrixType vnlMatrix(directionPtr);
+  image->SetDirection(DirectionType(vnlMatrix));
+
+  image->SetLargestPossibleRegion(largestRegion);
+  image->SetNumberOfComponentsPerPixel(imageJSON.imageType.components);
+}
+
+template <typename TImage>
+void
+WasmImageToImageFilter<TImage>
+::GenerateData()
+{
+  // Get the output pointer and the descriptor parsed with the information
+  ImageType * image = this->GetOutput();
+  const ImageJSON & imageJSON = this->m_ImageJSON;
+
+  using IOPixelType = typename TImage::IOPixelType;
+  using PixelType = typename TImage::PixelType;
+  using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
+  constexpr unsigned int Dimension = TImage::ImageDimension;
 
   const auto dimension = imageJSON.imageType.dimension;
   const auto componentType = imageJSON.imageType.componentType;
@@ -156,17 +199,17 @@ WasmImageToImageFilter<TImage>
 
   if (dimension != Dimension)
   {
-    throw std::runtime_error("Unexpected dimension");
+    itkExceptionMacro("Unexpected dimension: " << imageJSON.imageType.dimension << ", expected " << Dimension);
   }
 
   if ( componentType != itk::wasm::MapComponentType<typename ConvertPixelTraits::ComponentType>::JSONComponentEnum )
   {
-    throw std::runtime_error("Unexpected component type");
+    itkExceptionMacro("Unexpected component type");
   }
 
   if ( pixelType != itk::wasm::MapPixelType<PixelType>::JSONPixelEnum )
   {
-    throw std::runtime_error("Unexpected pixel type");
+    itkExceptionMacro("Unexpected pixel type");
   }
 
   using FilterType = ImportVectorImageFilter< TImage >;
@@ -175,7 +218,7 @@ WasmImageToImageFilter<TImage>
   // Don't throw when PixelType is VariableLengthPixel where number of components is 0
   if (ConvertPixelTraits::GetNumberOfComponents() != 0 && components != ConvertPixelTraits::GetNumberOfComponents() )
   {
-    throw std::runtime_error("Unexpected number of components");
+    itkExceptionMacro("Unexpected number of components: " << components << ", expected " << ConvertPixelTraits::GetNumberOfComponents());
   }
 
   using OriginType = typename ImageType::PointType;
@@ -195,13 +238,14 @@ WasmImageToImageFilter<TImage>
   filter->SetSpacing( spacing );
 
   using DirectionType = typename ImageType::DirectionType;
-  const std::string directionString = imageJSON.direction;
-  const double * directionPtr = reinterpret_cast< double * >( std::strtoull(directionString.substr(35).c_str(), nullptr, 10) );
+  const double * directionPtr = descriptorArrayPointer<double>(imageJSON.direction);
   using VnlMatrixType = typename DirectionType::InternalMatrixType;
   const VnlMatrixType vnlMatrix(directionPtr);
   const DirectionType direction(vnlMatrix);
   filter->SetDirection(direction);
 
+  const bool variableLengthPixel = pixelType == JSONPixelTypesEnum::VariableLengthVector || pixelType == JSONPixelTypesEnum::VariableSizeMatrix;
+
   using RegionType = typename ImageType::RegionType;
   RegionType bufferedRegion;
   RegionType largestRegion;
@@ -219,25 +263,92 @@ WasmImageToImageFilter<TImage>
       bufferedRegion.SetIndex(i, 0);
       bufferedRegion.SetSize(i, imageJSON.size[i]);
     }
-    totalSize *= imageJSON.bufferedRegion.size[i];
+    totalSize *= bufferedRegion.GetSize(i);
     largestRegion.SetSize(i, imageJSON.size[i]);
   }
-  filter->SetBufferedRegion(bufferedRegion);
   filter->SetLargestPossibleRegion(largestRegion);
 
-  const std::string dataString = imageJSON.data;
-  IOPixelType * dataPtr = reinterpret_cast< IOPixelType * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
-  const bool letImageContainerManageMemory = false;
-  if (pixelType == JSONPixelTypesEnum::VariableLengthVector || pixelType == JSONPixelTypesEnum::VariableSizeMatrix)
+  if (imageJSON.chunks)
+  {
+    // Slices along the slowest axis that the requested region needs
+    constexpr unsigned int sliceAxis = Dimension - 1;
+    const RegionType requestedRegion = image->GetRequestedRegion();
+    const IndexValueType requestedStart = requestedRegion.GetIndex(sliceAxis);
+    const IndexValueType requestedEnd = requestedStart + static_cast<IndexValueType>(requestedRegion.GetSize(sliceAxis));
+
+    std::vector<ImageChunkJSON> chunks;
+    for (const auto & chunk : *imageJSON.chunks)
     {
-    filter->SetImportPointer(dataPtr, totalSize, letImageContainerManageMemory, components);
+      const IndexValueType chunkEnd = chunk.index + static_cast<IndexValueType>(chunk.size);
+      if (chunk.index < requestedEnd && chunkEnd > requestedStart)
+      {
+        chunks.push_back(chunk);
+      }
     }
-  else
+    if (chunks.empty())
     {
-    filter->SetImportPointer(dataPtr, totalSize, letImageContainerManageMemory);
+      itkExceptionMacro("No image chunk overlaps the requested region " << requestedRegion);
     }
-  filter->Update();
-  image->Graft(filter->GetOutput());
+    std::sort(chunks.begin(), chunks.end(), [](const ImageChunkJSON & a, const ImageChunkJSON & b) { return a.index < b.index; });
+
+    bufferedRegion = largestRegion;
+    bufferedRegion.SetIndex(sliceAxis, chunks.front().index);
+    SizeValueType slices = 0;
+    for (const auto & chunk : chunks)
+    {
+      if (chunk.index != chunks.front().index + static_cast<IndexValueType>(slices))
+      {
+        itkExceptionMacro("Image chunks do not cover the requested region " << requestedRegion);
+      }
+      slices += chunk.size;
+    }
+    bufferedRegion.SetSize(sliceAxis, slices);
+    filter->SetBufferedRegion(bufferedRegion);
+
+    const SizeValueType pixelsPerSlice = largestRegion.GetNumberOfPixels() / largestRegion.GetSize(sliceAxis);
+    const SizeValueType elementsPerPixel = variableLengthPixel ? components : 1;
+    if (chunks.size() == 1)
+    {
+      IOPixelType * dataPtr = descriptorArrayPointer<IOPixelType>(chunks.front().data);
+      const bool letImageContainerManageMemory = false;
+      filter->SetImportPointer(dataPtr, bufferedRegion.GetNumberOfPixels(), letImageContainerManageMemory, elementsPerPixel);
+    }
+    else
+    {
+      // Spanning chunks are not contiguous, so only they are gathered
+      IOPixelType * dataPtr = new IOPixelType[bufferedRegion.GetNumberOfPixels() * elementsPerPixel];
+      IOPixelType * chunkDestination = dataPtr;
+      for (const auto & chunk : chunks)
+      {
+        const IOPixelType * chunkPtr = descriptorArrayPointer<const IOPixelType>(chunk.data);
+        const SizeValueType chunkElements = chunk.size * pixelsPerSlice * elementsPerPixel;
+        std::copy(chunkPtr, chunkPtr + chunkElements, chunkDestination);
+        chunkDestination += chunkElements;
+      }
+      const bool letImageContainerManageMemory = true;
+      filter->SetImportPointer(dataPtr, bufferedRegion.GetNumberOfPixels(), letImageContainerManageMemory, elementsPerPixel);
+    }
+    filter->Update();
+    image->Graft(filter->GetOutput());
+    image->SetRequestedRegion(requestedRegion);
+  }
+  else
+  {
+    filter->SetBufferedRegion(bufferedRegion);
+
+    IOPixelType * dataPtr = descriptorArrayPointer<IOPixelType>(imageJSON.data);
+    const bool letImageContainerManageMemory = false;
+    if (variableLengthPixel)
+      {
+      filter->SetImportPointer(dataPtr, totalSize, letImageContainerManageMemory, components);
+      }
+    else
+      {
+      filter->SetImportPointer(dataPtr, totalSize, letImageContainerManageMemory);
+      }
+    filter->Update();
+    image->Graft(filter->GetOutput());
+  }
 
   auto dictionary = image->GetMetaDataDictionary();
   jsonToMetaDataDictionary(imageJSON.metadata, dictionary);
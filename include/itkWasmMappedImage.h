@@ -0,0 +1,170 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMappedImage_h
+#define itkWasmMappedImage_h
+
+#include "itkImportImageContainer.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmIOCommon.h"
+#include "itkWasmMapComponentType.h"
+#include "itkWasmMapPixelType.h"
+#include "itkWasmComponentTypeFromIOComponentEnum.h"
+#include "itkWasmPixelTypeFromIOPixelEnum.h"
+#include "itksys/SystemTools.hxx"
+
+#include <memory>
+#include <string>
+
+namespace itk
+{
+
+/**
+ *\class WasmMappedImageContainer
+ * \brief Pixel container that imports a memory mapped file
+ *
+ * The container keeps the mapping alive for as long as the image uses it.
+ * The file is mapped copy-on-write, so filters that run in place modify
+ * the memory but never the file.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_TEMPLATE_EXPORT WasmMappedImageContainer : public ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmMappedImageContainer);
+
+  using Self = WasmMappedImageContainer;
+  using Superclass = ImportImageContainer<TElementIdentifier, TElement>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(WasmMappedImageContainer, ImportImageContainer);
+
+  /** Map the file and import its content as numberOfElements elements. */
+  void
+  MapFile(const std::string & fileName, TElementIdentifier numberOfElements)
+  {
+    auto mappedFile = std::make_unique<MappedFile>(fileName, true);
+    if (mappedFile->GetLength() != numberOfElements * sizeof(TElement))
+    {
+      itkExceptionMacro("Unexpected size of " << fileName << ": " << mappedFile->GetLength() << " bytes, expected "
+                                              << numberOfElements * sizeof(TElement));
+    }
+    auto * elements = reinterpret_cast<TElement *>(const_cast<unsigned char *>(mappedFile->GetData()));
+    const bool letContainerManageMemory = false;
+    this->SetImportPointer(elements, numberOfElements, letContainerManageMemory);
+    m_MappedFile = std::move(mappedFile);
+  }
+
+protected:
+  WasmMappedImageContainer() = default;
+  ~WasmMappedImageContainer() override = default;
+
+private:
+  std::unique_ptr<MappedFile> m_MappedFile;
+};
+
+namespace wasm
+{
+
+/** Read an .iwi directory image by mapping its pixel data file.
+ *
+ * The data file of the directory layout is in the layout of the image
+ * buffer, so it is imported without a copy when the component type, pixel
+ * type, and dimension match TImage. Returns nullptr for other files and
+ * layouts, which are read with the ImageFileReader.
+ */
+template <typename TImage>
+typename TImage::Pointer
+readMappedImage(const std::string & fileName)
+{
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
+  using InternalPixelType = typename ImageType::InternalPixelType;
+  constexpr unsigned int Dimension = ImageType::ImageDimension;
+
+  auto imageIO = WasmImageIO::New();
+  if (!itksys::SystemTools::FileIsDirectory(fileName) || !imageIO->CanReadFile(fileName.c_str()))
+  {
+    return nullptr;
+  }
+  imageIO->SetFileName(fileName);
+  imageIO->ReadImageInformation();
+  const std::string dataFileName = imageIO->GetDataFileName();
+  if (dataFileName.empty())
+  {
+    return nullptr;
+  }
+
+  // Conversions are left to the ImageFileReader
+  const unsigned int components = imageIO->GetNumberOfComponents();
+  if (imageIO->GetNumberOfDimensions() != Dimension ||
+      WasmComponentTypeFromIOComponentEnum(imageIO->GetComponentType()) !=
+        MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString ||
+      WasmPixelTypeFromIOPixelEnum(imageIO->GetPixelType()) != MapPixelType<PixelType>::PixelString ||
+      (ConvertPixelTraits::GetNumberOfComponents() != 0 && components != ConvertPixelTraits::GetNumberOfComponents()))
+  {
+    return nullptr;
+  }
+
+  auto image = ImageType::New();
+  typename ImageType::RegionType region;
+  typename ImageType::PointType origin;
+  typename ImageType::SpacingType spacing;
+  typename ImageType::DirectionType direction;
+  for (unsigned int ii = 0; ii < Dimension; ++ii)
+  {
+    region.SetIndex(ii, 0);
+    region.SetSize(ii, imageIO->GetDimensions(ii));
+    origin[ii] = imageIO->GetOrigin(ii);
+    spacing[ii] = imageIO->GetSpacing(ii);
+    const std::vector<double> axis = imageIO->GetDirection(ii);
+    for (unsigned int jj = 0; jj < Dimension; ++jj)
+    {
+      direction[jj][ii] = axis[jj];
+    }
+  }
+  image->SetRegions(region);
+  image->SetOrigin(origin);
+  image->SetSpacing(spacing);
+  image->SetDirection(direction);
+  image->SetMetaDataDictionary(imageIO->GetMetaDataDictionary());
+
+  SizeValueType elementsPerPixel = 1;
+  if (image->GetNameOfClass() == std::string("VectorImage"))
+  {
+    image->SetNumberOfComponentsPerPixel(components);
+    elementsPerPixel = components;
+  }
+
+  using ContainerType = WasmMappedImageContainer<SizeValueType, InternalPixelType>;
+  auto container = ContainerType::New();
+  container->MapFile(dataFileName, region.GetNumberOfPixels() * elementsPerPixel);
+  image->SetPixelContainer(container);
+
+  return image;
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
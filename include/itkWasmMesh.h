@@ -77,6 +77,11 @@ protected:
   }
   ~WasmMesh() override = default;
 
+  /** Serialize the cells into the flat [type, number of points, point ids...]
+   * cell buffer. Chunks of cells are counted and filled in parallel; the
+   * result matches Mesh::GetCellsArray. */
+  void SerializeCells(const MeshType * mesh);
+
   typename CellBufferContainerType::Pointer m_CellBufferContainer;
 };
 
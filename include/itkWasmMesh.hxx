@@ -19,6 +19,10 @@
 #define itkWasmMesh_hxx
 
 #include "itkWasmMesh.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <type_traits>
 
 namespace itk
 {
@@ -28,10 +32,94 @@ void
 WasmMesh<TMesh>
 ::SetMesh(const MeshType * mesh)
 {
-  this->m_CellBufferContainer = const_cast<MeshType *>(mesh)->GetCellsArray();
+  this->m_CellBufferContainer = CellBufferContainerType::New();
+  this->SerializeCells(mesh);
   this->SetDataObject(const_cast<MeshType *>(mesh));
 }
 
+template <typename TMesh>
+void
+WasmMesh<TMesh>
+::SerializeCells(const MeshType * mesh)
+{
+  using CellType = typename MeshType::CellType;
+  using CellsContainer = typename MeshType::CellsContainer;
+  using CellBufferElementType = typename CellBufferContainerType::Element;
+
+  const CellsContainer * cellsContainer = mesh->GetCells();
+  if (cellsContainer == nullptr || cellsContainer->Size() == 0)
+  {
+    return;
+  }
+
+  // Cells in container order, indexed directly when the container is a vector
+  std::vector<const CellType *> collectedCells;
+  const CellType * const * cells = nullptr;
+  const SizeValueType numberOfCells = cellsContainer->Size();
+  if constexpr (std::is_same_v<CellsContainer, VectorContainer<CellIdentifier, CellType *>>)
+  {
+    cells = cellsContainer->CastToSTLConstContainer().data();
+  }
+  else
+  {
+    collectedCells.reserve(numberOfCells);
+    for (auto cellItr = cellsContainer->Begin(); cellItr != cellsContainer->End(); ++cellItr)
+    {
+      collectedCells.push_back(cellItr->Value());
+    }
+    cells = collectedCells.data();
+  }
+
+  // Fixed chunks so the buffer layout does not depend on the thread schedule
+  constexpr SizeValueType minimumCellsPerChunk = 16384;
+  auto multiThreader = MultiThreaderBase::New();
+  const SizeValueType numberOfChunks =
+    std::max<SizeValueType>(1, std::min<SizeValueType>(multiThreader->GetNumberOfWorkUnits(), numberOfCells / minimumCellsPerChunk));
+  const auto chunkBegin = [numberOfCells, numberOfChunks](SizeValueType chunk) {
+    return numberOfCells * chunk / numberOfChunks;
+  };
+
+  // Counting pass: each cell is [type, number of points, point ids...]
+  std::vector<SizeValueType> chunkOffsets(numberOfChunks + 1, 0);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      SizeValueType chunkSize = 0;
+      for (SizeValueType ii = chunkBegin(chunk); ii < chunkBegin(chunk + 1); ++ii)
+      {
+        chunkSize += 2 + cells[ii]->GetNumberOfPoints();
+      }
+      chunkOffsets[chunk + 1] = chunkSize;
+    },
+    nullptr);
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    chunkOffsets[chunk + 1] += chunkOffsets[chunk];
+  }
+
+  // Fill pass
+  this->m_CellBufferContainer->Reserve(chunkOffsets[numberOfChunks]);
+  CellBufferElementType * cellBuffer = &(this->m_CellBufferContainer->at(0));
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      CellBufferElementType * chunkBuffer = cellBuffer + chunkOffsets[chunk];
+      for (SizeValueType ii = chunkBegin(chunk); ii < chunkBegin(chunk + 1); ++ii)
+      {
+        const CellType * cell = cells[ii];
+        *chunkBuffer++ = static_cast<CellBufferElementType>(cell->GetType());
+        *chunkBuffer++ = static_cast<CellBufferElementType>(cell->GetNumberOfPoints());
+        for (auto pointIdItr = cell->PointIdsBegin(); pointIdItr != cell->PointIdsEnd(); ++pointIdItr)
+        {
+          *chunkBuffer++ = static_cast<CellBufferElementType>(*pointIdItr);
+        }
+      }
+    },
+    nullptr);
+}
+
 } // end namespace itk
 
 #endif
@@ -21,8 +21,12 @@
 
 #include "itkMeshIOBase.h"
 #include <fstream>
+#include <map>
+#include <memory>
+#include <string>
 
 #include "itkMeshJSON.h"
+#include "itkWasmIOCommon.h"
 #include "cbor.h"
 
 namespace itk
@@ -100,12 +104,33 @@ protected:
   ~WasmMeshIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Reads in the mesh information and populates the related buffers. */
+  /** Reads in the mesh information and indexes the buffers. When cborBuffer
+   * is provided, it must remain valid until the buffers are read. */
   void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  /** Writes the buffers into the CBOR item and the buffer out to disk. */
+  /** Copy a buffer indexed by ReadCBOR. */
+  void ReadCBORSection(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead);
+  /** Encodes the mesh information into the CBOR item. It is streamed out
+   * together with the buffers, which are not copied. */
   void WriteCBOR();
 
+  /** Stream the CBOR encoding is written to, which is created and receives
+   * the mesh information on first use. */
+  std::ostream & GetCBOROutputStream();
+
+  /** Account for a buffer announced in the CBOR map head. */
+  void CountCBORBufferWritten();
+
+  /** Create the stream the CBOR encoding is written to. Defaults to the file. */
+  virtual std::unique_ptr<std::ostream> CreateCBOROutputStream();
+
   cbor_item_t * m_CBORRoot{ nullptr };
+  /** The mapped file read, when the CBOR buffer is not provided. */
+  std::unique_ptr<MappedFile> m_MappedCBOR;
+  /** Content of the buffers in the CBOR encoding read, by name. */
+  std::map<std::string, CBORSpan> m_CBORSections;
+  std::unique_ptr<std::ostream> m_CBOROutputStream;
+  /** Number of buffers announced in the CBOR map head that are not written yet. */
+  unsigned int m_PendingCBORBuffers{ 0 };
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmMeshIO);
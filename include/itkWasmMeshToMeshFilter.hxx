@@ -19,6 +19,8 @@
 #define itkWasmMeshToMeshFilter_hxx
 
 #include "itkWasmMeshToMeshFilter.h"
+#include "itkWasmDescriptor.h"
+#include "itkWasmPooledCell.h"
 #include "itkNumericTraits.h"
 #include "itkCommonEnums.h"
 #include "itkHexahedronCell.h"
@@ -41,6 +43,34 @@
 namespace
 {
 
+// Number of mesh cells encoded in a cells buffer, where polylines expand to
+// one line cell per segment.
+template<typename TCellBufferType>
+itk::SizeValueType
+countCells(itk::SizeValueType cellBufferSize, const TCellBufferType * cellsBufferPtr)
+{
+  itk::SizeValueType numberOfCells = 0;
+  itk::SizeValueType index = 0;
+  while (index + 1 < cellBufferSize)
+  {
+    const auto type = static_cast<itk::CellGeometryEnum>(static_cast<int>(cellsBufferPtr[index]));
+    const auto cellPoints = static_cast<itk::SizeValueType>(cellsBufferPtr[index + 1]);
+    if (type == itk::CellGeometryEnum::LINE_CELL && cellPoints > 1)
+    {
+      numberOfCells += cellPoints - 1;
+    }
+    else
+    {
+      ++numberOfCells;
+    }
+    index += 2 + cellPoints;
+  }
+  return numberOfCells;
+}
+
+// Import the cells buffer in one pass. The cells container is sized once and
+// populated directly, instead of growing it and updating its modified time
+// with a SetCell call per cell. Cells are allocated from contiguous slabs.
 template<typename TMesh, typename TCellBufferType>
 void
 populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType * cellsBufferPtr)
@@ -59,9 +89,30 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
   using QuadrilateralCellType = itk::QuadrilateralCell<CellType>;
   using QuadraticEdgeCellType = itk::QuadraticEdgeCell<CellType>;
   using QuadraticTriangleCellType = itk::QuadraticTriangleCell<CellType>;
-  using CellAutoPointer = typename MeshType::CellAutoPointer;
+
+  // The mesh owns the cells from the start, so they are released if the buffer is invalid
+  auto cellsContainer = MeshType::CellsContainer::New();
+  const itk::SizeValueType numberOfCells = countCells(cellBufferSize, cellsBufferPtr);
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+  cellsContainer->Reserve(numberOfCells);
+  mesh->SetCells(cellsContainer);
+  mesh->SetCellsAllocationMethod(itk::MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedDynamicallyCellByCell);
+  auto & cells = cellsContainer->CastToSTLContainer();
+
   itk::SizeValueType index = itk::NumericTraits<itk::SizeValueType>::ZeroValue();
   CellIdentifier id = itk::NumericTraits<CellIdentifier>::ZeroValue();
+  // Slot for the next cell, checked before the cell is allocated so that it
+  // is always owned by the mesh
+  const auto nextCell = [&]() -> CellType *& {
+    if (id >= numberOfCells)
+    {
+      itkGenericExceptionMacro("The cells buffer holds more than the " << numberOfCells << " counted cells");
+    }
+    return cells[id++];
+  };
   while (index < cellBufferSize)
   {
     auto type = static_cast<itk::CellGeometryEnum>(static_cast<int>(cellsBufferPtr[index++]));
@@ -72,17 +123,15 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != VertexCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Vertex Cell number of points");
+          itkGenericExceptionMacro("Invalid Vertex Cell number of points");
         }
-        CellAutoPointer cell;
-        auto *                vertexCell = new VertexCellType;
+        CellType *& vertexCellSlot = nextCell();
+        auto * vertexCell = new itk::wasm::PooledCell<VertexCellType>;
+        vertexCellSlot = vertexCell;
         for (unsigned int jj = 0; jj < VertexCellType::NumberOfPoints; ++jj)
         {
           vertexCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(vertexCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::LINE_CELL:
@@ -91,18 +140,17 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints < 2)
         {
-          throw std::runtime_error("Invalid Line Cell number of points");
+          itkGenericExceptionMacro("Invalid Line Cell number of points");
         }
         auto pointIDBuffer = static_cast<PointIdentifier>(cellsBufferPtr[index++]);
         for (unsigned int jj = 1; jj < cellPoints; ++jj)
         {
-          CellAutoPointer cell;
-          auto *                lineCell = new LineCellType;
+          CellType *& lineCellSlot = nextCell();
+          auto * lineCell = new itk::wasm::PooledCell<LineCellType>;
+          lineCellSlot = lineCell;
           lineCell->SetPointId(0, pointIDBuffer);
           pointIDBuffer = static_cast<PointIdentifier>(cellsBufferPtr[index++]);
           lineCell->SetPointId(1, pointIDBuffer);
-          cell.TakeOwnership(lineCell);
-          mesh->SetCell(id++, cell);
         }
         break;
       }
@@ -111,18 +159,16 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != TriangleCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Triangle Cell number of points");
+          itkGenericExceptionMacro("Invalid Triangle Cell number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                triangleCell = new TriangleCellType;
+        CellType *& triangleCellSlot = nextCell();
+        auto * triangleCell = new itk::wasm::PooledCell<TriangleCellType>;
+        triangleCellSlot = triangleCell;
         for (unsigned int jj = 0; jj < TriangleCellType::NumberOfPoints; ++jj)
         {
           triangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(triangleCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::QUADRILATERAL_CELL:
@@ -130,46 +176,43 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != QuadrilateralCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Quadrilateral Cell with number of points");
+          itkGenericExceptionMacro("Invalid Quadrilateral Cell with number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                quadrilateralCell = new QuadrilateralCellType;
+        CellType *& quadrilateralCellSlot = nextCell();
+        auto * quadrilateralCell = new itk::wasm::PooledCell<QuadrilateralCellType>;
+        quadrilateralCellSlot = quadrilateralCell;
         for (unsigned int jj = 0; jj < QuadrilateralCellType::NumberOfPoints; ++jj)
         {
           quadrilateralCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(quadrilateralCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::POLYGON_CELL:
       {
         // For polyhedron, if the number of points is 3, then we treat it as
         // triangle cell
-        CellAutoPointer cell;
         auto                  cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints == TriangleCellType::NumberOfPoints)
         {
-          auto * triangleCell = new TriangleCellType;
+          CellType *& triangleCellSlot = nextCell();
+          auto * triangleCell = new itk::wasm::PooledCell<TriangleCellType>;
+          triangleCellSlot = triangleCell;
           for (unsigned int jj = 0; jj < TriangleCellType::NumberOfPoints; ++jj)
           {
             triangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
           }
-          cell.TakeOwnership(triangleCell);
         }
         else
         {
-          auto * polygonCell = new PolygonCellType;
+          CellType *& polygonCellSlot = nextCell();
+          auto * polygonCell = new itk::wasm::PooledCell<PolygonCellType>;
+          polygonCellSlot = polygonCell;
           for (unsigned int jj = 0; jj < cellPoints; ++jj)
           {
             polygonCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
           }
-          cell.TakeOwnership(polygonCell);
         }
-
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::TETRAHEDRON_CELL:
@@ -177,18 +220,16 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != TetrahedronCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Tetrahedron Cell number of points");
+          itkGenericExceptionMacro("Invalid Tetrahedron Cell number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                tetrahedronCell = new TetrahedronCellType;
+        CellType *& tetrahedronCellSlot = nextCell();
+        auto * tetrahedronCell = new itk::wasm::PooledCell<TetrahedronCellType>;
+        tetrahedronCellSlot = tetrahedronCell;
         for (unsigned int jj = 0; jj < TetrahedronCellType::NumberOfPoints; ++jj)
         {
           tetrahedronCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(tetrahedronCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::HEXAHEDRON_CELL:
@@ -196,18 +237,16 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != HexahedronCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Hexahedron Cell number of points");
+          itkGenericExceptionMacro("Invalid Hexahedron Cell number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                hexahedronCell = new HexahedronCellType;
+        CellType *& hexahedronCellSlot = nextCell();
+        auto * hexahedronCell = new itk::wasm::PooledCell<HexahedronCellType>;
+        hexahedronCellSlot = hexahedronCell;
         for (unsigned int jj = 0; jj < HexahedronCellType::NumberOfPoints; ++jj)
         {
           hexahedronCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(hexahedronCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::QUADRATIC_EDGE_CELL:
@@ -215,18 +254,16 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != QuadraticEdgeCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Quadratic edge Cell number of points");
+          itkGenericExceptionMacro("Invalid Quadratic edge Cell number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                quadraticEdgeCell = new QuadraticEdgeCellType;
+        CellType *& quadraticEdgeCellSlot = nextCell();
+        auto * quadraticEdgeCell = new itk::wasm::PooledCell<QuadraticEdgeCellType>;
+        quadraticEdgeCellSlot = quadraticEdgeCell;
         for (unsigned int jj = 0; jj < QuadraticEdgeCellType::NumberOfPoints; ++jj)
         {
           quadraticEdgeCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(quadraticEdgeCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       case itk::CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
@@ -234,23 +271,21 @@ populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType *
         auto cellPoints = static_cast<unsigned int>(cellsBufferPtr[index++]);
         if (cellPoints != QuadraticTriangleCellType::NumberOfPoints)
         {
-          throw std::runtime_error("Invalid Quadratic triangle Cell number of points");
+          itkGenericExceptionMacro("Invalid Quadratic triangle Cell number of points");
         }
 
-        CellAutoPointer cell;
-        auto *                quadraticTriangleCell = new QuadraticTriangleCellType;
+        CellType *& quadraticTriangleCellSlot = nextCell();
+        auto * quadraticTriangleCell = new itk::wasm::PooledCell<QuadraticTriangleCellType>;
+        quadraticTriangleCellSlot = quadraticTriangleCell;
         for (unsigned int jj = 0; jj < QuadraticTriangleCellType::NumberOfPoints; ++jj)
         {
           quadraticTriangleCell->SetPointId(jj, static_cast<PointIdentifier>(cellsBufferPtr[index++]));
         }
-
-        cell.TakeOwnership(quadraticTriangleCell);
-        mesh->SetCell(id++, cell);
         break;
       }
       default:
       {
-        throw std::runtime_error("Unknown cell type");
+        itkGenericExceptionMacro("Unknown cell type");
       }
     }
   }
@@ -369,7 +404,7 @@ WasmMeshToMeshFilter<TMesh>
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
 
   const std::string json(wasmMesh->GetJSON());
-  auto deserializedAttempt = glz::read_json<MeshJSON>(json);
+  auto deserializedAttempt = readDescriptor<MeshJSON>(json, wasmMesh->GetBinaryDescriptor());
   if (!deserializedAttempt)
   {
     const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -391,95 +426,96 @@ WasmMeshToMeshFilter<TMesh>
 
   if (dimension != MeshType::PointDimension)
   {
-    throw std::runtime_error("Unexpected dimension");
+    itkExceptionMacro("Unexpected dimension");
   }
   if (numberOfPointPixels && pointPixelComponentType != itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::JSONComponentEnum )
   {
-    throw std::runtime_error("Unexpected point pixel component type");
+    itkExceptionMacro("Unexpected point pixel component type");
   }
 
   if (numberOfPointPixels && pointPixelType != itk::wasm::MapPixelType<PointPixelType>::JSONPixelEnum )
   {
-    throw std::runtime_error("Unexpected point pixel type");
+    itkExceptionMacro("Unexpected point pixel type");
   }
 
   if (numberOfCellPixels && cellPixelComponentType != itk::wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::JSONComponentEnum )
   {
-    throw std::runtime_error("Unexpected cell pixel component type");
+    itkExceptionMacro("Unexpected cell pixel component type");
   }
 
   if (numberOfCellPixels && cellPixelType != itk::wasm::MapPixelType<CellPixelType>::JSONPixelEnum )
   {
-    throw std::runtime_error("Unexpected cell pixel type");
+    itkExceptionMacro("Unexpected cell pixel type");
   }
 
   mesh->SetObjectName(meshJSON.name);
-  mesh->GetPoints()->resize(meshJSON.numberOfPoints);
+  // The containers are filled in a single pass from the input buffers. ITK's
+  // VectorContainer owns its storage, so the buffers cannot be wrapped in place.
   using PointType = typename MeshType::PointType;
-  const std::string pointsString = meshJSON.points;
   if (numberOfPoints)
   {
     if (pointComponentType == itk::wasm::MapComponentType<typename MeshType::CoordRepType>::JSONFloatTypeEnum)
     {
-      const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      const auto * pointsPtr = descriptorArrayPointer<PointType>(meshJSON.points);
       mesh->GetPoints()->assign(pointsPtr, pointsPtr + meshJSON.numberOfPoints);
     }
     else if (pointComponentType == itk::wasm::MapComponentType<float>::JSONFloatTypeEnum)
     {
-      auto * pointsPtr = reinterpret_cast< float * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      auto * pointsPtr = descriptorArrayPointer<float>(meshJSON.points);
       const size_t pointComponents = numberOfPoints * dimension;
+      mesh->GetPoints()->resize(numberOfPoints);
       auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
     }
     else if (pointComponentType == itk::wasm::MapComponentType<double>::JSONFloatTypeEnum)
     {
-      auto * pointsPtr = reinterpret_cast< double * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      auto * pointsPtr = descriptorArrayPointer<double>(meshJSON.points);
       const size_t pointComponents = numberOfPoints * dimension;
+      mesh->GetPoints()->resize(numberOfPoints);
       auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
     }
     else
     {
-      throw std::runtime_error("Unexpected point component type");
+      itkExceptionMacro("Unexpected point component type");
     }
   }
+  else
+  {
+    mesh->GetPoints()->resize(0);
+  }
 
 
   const SizeValueType cellBufferSize = meshJSON.cellBufferSize;
-  const std::string cellsString = meshJSON.cells;
   using CellBufferType = typename WasmMeshType::CellBufferContainerType::Element;
-  CellBufferType * cellsBufferPtr = reinterpret_cast< CellBufferType * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
+  CellBufferType * cellsBufferPtr = descriptorArrayPointer<CellBufferType>(meshJSON.cells);
   if (cellComponentType == JSONIntTypesEnum::uint32)
   {
-    uint32_t * cellsBufferPtr = reinterpret_cast< uint32_t * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
+    uint32_t * cellsBufferPtr = descriptorArrayPointer<uint32_t>(meshJSON.cells);
     populateCells<MeshType, uint32_t>(mesh, cellBufferSize, cellsBufferPtr);
   }
   else if (cellComponentType == JSONIntTypesEnum::uint64)
   {
-    uint64_t * cellsBufferPtr = reinterpret_cast< uint64_t * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
+    uint64_t * cellsBufferPtr = descriptorArrayPointer<uint64_t>(meshJSON.cells);
     populateCells<MeshType, uint64_t>(mesh, cellBufferSize, cellsBufferPtr);
   }
   else
   {
-    throw std::runtime_error("Unexpected cell component type");
+    itkExceptionMacro("Unexpected cell component type");
   }
 
   using PointPixelType = typename TMesh::PixelType;
-  const std::string pointDataString = meshJSON.pointData;
-  auto pointDataPtr = reinterpret_cast< PointPixelType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
-  mesh->GetPointData()->resize(numberOfPointPixels);
+  auto pointDataPtr = descriptorArrayPointer<PointPixelType>(meshJSON.pointData);
   mesh->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels);
 
   using CellPixelType = typename TMesh::CellPixelType;
-  const std::string cellDataString = meshJSON.cellData;
-  auto cellDataPtr = reinterpret_cast< CellPixelType * >( std::strtoull(cellDataString.substr(35).c_str(), nullptr, 10) );
+  auto cellDataPtr = descriptorArrayPointer<CellPixelType>(meshJSON.cellData);
   if (mesh->GetCellData() == nullptr)
   {
     mesh->SetCellData(MeshType::CellDataContainer::New());
   }
   if (meshJSON.numberOfCellPixels)
   {
-    mesh->GetCellData()->resize(meshJSON.numberOfCellPixels);
     mesh->GetCellData()->assign(cellDataPtr, cellDataPtr + meshJSON.numberOfCellPixels);
   }
 
@@ -19,6 +19,7 @@
 #define itkWasmPointSetToPointSetFilter_hxx
 
 #include "itkWasmPointSetToPointSetFilter.h"
+#include "itkWasmDescriptor.h"
 #include "itkNumericTraits.h"
 #include "itkCommonEnums.h"
 
@@ -138,7 +139,7 @@ WasmPointSetToPointSetFilter<TPointSet>
   using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
 
   const std::string json(wasmPointSet->GetJSON());
-  auto deserializedAttempt = glz::read_json<PointSetJSON>(json);
+  auto deserializedAttempt = readDescriptor<PointSetJSON>(json, wasmPointSet->GetBinaryDescriptor());
   if (!deserializedAttempt)
   {
     const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -168,27 +169,29 @@ WasmPointSetToPointSetFilter<TPointSet>
   }
 
   pointSet->SetObjectName(pointSetJSON.name);
-  pointSet->GetPoints()->resize(pointSetJSON.numberOfPoints);
+  // The containers are filled in a single pass from the input buffers. ITK's
+  // VectorContainer owns its storage, so the buffers cannot be wrapped in place.
   using PointType = typename PointSetType::PointType;
-  const std::string pointsString = pointSetJSON.points;
   if (numberOfPoints)
   {
     if (pointComponentType == itk::wasm::MapComponentType<typename PointSetType::CoordRepType>::JSONFloatTypeEnum)
     {
-      const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      const auto * pointsPtr = descriptorArrayPointer<PointType>(pointSetJSON.points);
       pointSet->GetPoints()->assign(pointsPtr, pointsPtr + pointSetJSON.numberOfPoints);
     }
     else if (pointComponentType == itk::wasm::MapComponentType<float>::JSONFloatTypeEnum)
     {
-      auto * pointsPtr = reinterpret_cast< float * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      auto * pointsPtr = descriptorArrayPointer<float>(pointSetJSON.points);
       const size_t pointComponents = numberOfPoints * dimension;
+      pointSet->GetPoints()->resize(numberOfPoints);
       auto * pointsContainerPtr = reinterpret_cast<typename PointSetType::CoordRepType *>(&(pointSet->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
     }
     else if (pointComponentType == itk::wasm::MapComponentType<double>::JSONFloatTypeEnum)
     {
-      auto * pointsPtr = reinterpret_cast< double * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+      auto * pointsPtr = descriptorArrayPointer<double>(pointSetJSON.points);
       const size_t pointComponents = numberOfPoints * dimension;
+      pointSet->GetPoints()->resize(numberOfPoints);
       auto * pointsContainerPtr = reinterpret_cast<typename PointSetType::CoordRepType *>(&(pointSet->GetPoints()->at(0)) );
       std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
     }
@@ -197,12 +200,14 @@ WasmPointSetToPointSetFilter<TPointSet>
       throw std::runtime_error("Unexpected point component type");
     }
   }
+  else
+  {
+    pointSet->GetPoints()->resize(0);
+  }
 
 
   using PointPixelType = typename TPointSet::PixelType;
-  const std::string pointDataString = pointSetJSON.pointData;
-  auto pointDataPtr = reinterpret_cast< PointPixelType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
-  pointSet->GetPointData()->resize(numberOfPointPixels);
+  auto pointDataPtr = descriptorArrayPointer<PointPixelType>(pointSetJSON.pointData);
   pointSet->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels);
 
   auto dictionary = pointSet->GetMetaDataDictionary();
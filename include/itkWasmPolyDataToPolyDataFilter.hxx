@@ -19,6 +19,7 @@
 #define itkWasmPolyDataToPolyDataFilter_hxx
 
 #include "itkWasmPolyDataToPolyDataFilter.h"
+#include "itkWasmDescriptor.h"
 #include "itkNumericTraits.h"
 #include "itkCommonEnums.h"
 #include "itkHexahedronCell.h"
@@ -150,7 +151,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   using CellPixelType = typename PolyDataType::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
 
-  auto deserializedAttempt = glz::read_json<PolyDataJSON>(json);
+  auto deserializedAttempt = readDescriptor<PolyDataJSON>(json, wasmPolyData->GetBinaryDescriptor());
   if (!deserializedAttempt)
   {
     const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -182,8 +183,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   const SizeValueType numberOfPoints = polyDataJSON.numberOfPoints;
   if (numberOfPoints)
   {
-    const std::string pointsString = polyDataJSON.points;
-    const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+    const auto * pointsPtr = descriptorArrayPointer<PointType>(polyDataJSON.points);
     polyData->GetPoints()->resize(numberOfPoints);
     polyData->GetPoints()->assign(pointsPtr, pointsPtr + numberOfPoints);
   }
@@ -191,8 +191,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   const SizeValueType verticesBufferSize = polyDataJSON.verticesBufferSize;
   if (verticesBufferSize)
   {
-    const std::string verticesString = polyDataJSON.vertices;
-    auto verticesPtr = reinterpret_cast< uint32_t * >( std::strtoull(verticesString.substr(35).c_str(), nullptr, 10) );
+    auto verticesPtr = descriptorArrayPointer<uint32_t>(polyDataJSON.vertices);
     polyData->GetVertices()->resize(verticesBufferSize);
     polyData->GetVertices()->assign(verticesPtr, verticesPtr + verticesBufferSize);
   }
@@ -200,8 +199,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   const SizeValueType linesBufferSize = polyDataJSON.linesBufferSize;
   if (linesBufferSize)
   {
-    const std::string linesString = polyDataJSON.lines;
-    auto linesPtr = reinterpret_cast< uint32_t * >( std::strtoull(linesString.substr(35).c_str(), nullptr, 10) );
+    auto linesPtr = descriptorArrayPointer<uint32_t>(polyDataJSON.lines);
     polyData->GetLines()->resize(linesBufferSize);
     polyData->GetLines()->assign(linesPtr, linesPtr + linesBufferSize);
   }
@@ -209,8 +207,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   const SizeValueType polygonsBufferSize = polyDataJSON.polygonsBufferSize;
   if (polygonsBufferSize)
   {
-    const std::string polygonsString = polyDataJSON.polygons;
-    auto polygonsPtr = reinterpret_cast< uint32_t * >( std::strtoull(polygonsString.substr(35).c_str(), nullptr, 10) );
+    auto polygonsPtr = descriptorArrayPointer<uint32_t>(polyDataJSON.polygons);
     polyData->GetPolygons()->resize(polygonsBufferSize);
     polyData->GetPolygons()->assign(polygonsPtr, polygonsPtr + polygonsBufferSize);
   }
@@ -218,8 +215,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   const SizeValueType triangleStripsBufferSize = polyDataJSON.triangleStripsBufferSize;
   if (triangleStripsBufferSize)
   {
-    const std::string triangleStripsString = polyDataJSON.triangleStrips;
-    auto triangleStripsPtr = reinterpret_cast< uint32_t * >( std::strtoull(triangleStripsString.substr(35).c_str(), nullptr, 10) );
+    auto triangleStripsPtr = descriptorArrayPointer<uint32_t>(polyDataJSON.triangleStrips);
     polyData->GetTriangleStrips()->resize(triangleStripsBufferSize);
     polyData->GetTriangleStrips()->assign(triangleStripsPtr, triangleStripsPtr + triangleStripsBufferSize);
   }
@@ -230,8 +226,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
     const SizeValueType pointPixelComponents = polyDataType.pointPixelComponents;
     using PointPixelType = typename TPolyData::PixelType;
     using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-    const std::string pointDataString = polyDataJSON.pointData;
-    auto pointDataPtr = reinterpret_cast< typename ConvertPointPixelTraits::ComponentType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
+    auto pointDataPtr = descriptorArrayPointer<typename ConvertPointPixelTraits::ComponentType>(polyDataJSON.pointData);
     polyData->GetPointData()->resize(numberOfPointPixels * pointPixelComponents);
     polyData->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels * pointPixelComponents);
   }
@@ -242,8 +237,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
     const SizeValueType cellPixelComponents = polyDataType.cellPixelComponents;
     using CellPixelType = typename TPolyData::CellPixelType;
     using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-    const std::string cellDataString = polyDataJSON.cellData;
-    auto cellDataPtr = reinterpret_cast< typename ConvertCellPixelTraits::ComponentType * >( std::strtoull(cellDataString.substr(35).c_str(), nullptr, 10) );
+    auto cellDataPtr = descriptorArrayPointer<typename ConvertCellPixelTraits::ComponentType>(polyDataJSON.cellData);
     if (polyData->GetCellData() == nullptr)
     {
       polyData->SetCellData(PolyDataType::CellDataContainer::New());
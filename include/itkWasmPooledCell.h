@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPooledCell_h
+#define itkWasmPooledCell_h
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** \class CellSlabPool
+ *
+ * \brief Fixed size blocks carved from contiguous slabs.
+ *
+ * Blocks are handed out from a free list, and a new slab is allocated when
+ * it runs out. All slabs are released once every block has been returned.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <size_t TBlockSize>
+class CellSlabPool
+{
+public:
+  static constexpr size_t SlabBlocks = 4096;
+
+  static CellSlabPool &
+  Instance()
+  {
+    // Never destroyed, so cells of static meshes can still be released at exit
+    static auto * pool = new CellSlabPool;
+    return *pool;
+  }
+
+  void *
+  Allocate()
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_FreeList == nullptr)
+    {
+      m_Slabs.emplace_back(new Block[SlabBlocks]);
+      Block * slab = m_Slabs.back().get();
+      for (size_t ii = 0; ii < SlabBlocks; ++ii)
+      {
+        slab[ii].next = ii + 1 < SlabBlocks ? &slab[ii + 1] : nullptr;
+      }
+      m_FreeList = slab;
+    }
+    Block * block = m_FreeList;
+    m_FreeList = block->next;
+    ++m_AllocatedBlocks;
+    return block;
+  }
+
+  void
+  Deallocate(void * address)
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if (--m_AllocatedBlocks == 0)
+    {
+      m_FreeList = nullptr;
+      m_Slabs.clear();
+      return;
+    }
+    auto * block = static_cast<Block *>(address);
+    block->next = m_FreeList;
+    m_FreeList = block;
+  }
+
+private:
+  CellSlabPool() = default;
+
+  union Block
+  {
+    Block * next;
+    alignas(std::max_align_t) unsigned char storage[TBlockSize];
+  };
+
+  std::mutex                            m_Mutex;
+  std::vector<std::unique_ptr<Block[]>> m_Slabs;
+  Block *                               m_FreeList{ nullptr };
+  size_t                                m_AllocatedBlocks{ 0 };
+};
+
+/** \class PooledCell
+ *
+ * \brief A mesh cell allocated from a CellSlabPool.
+ *
+ * Cells are created in contiguous slabs instead of one heap allocation each.
+ * The Mesh still releases them one by one with delete through the cell
+ * interface, which is routed back to the pool by the virtual destructor.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TCell>
+class PooledCell final : public TCell
+{
+public:
+  using PoolType = CellSlabPool<sizeof(TCell)>;
+
+  static void *
+  operator new(size_t size)
+  {
+    static_assert(sizeof(PooledCell) == sizeof(TCell), "PooledCell must not add members");
+    static_assert(alignof(TCell) <= alignof(std::max_align_t), "Over-aligned cells cannot be pooled");
+    if (size != sizeof(PooledCell))
+    {
+      return ::operator new(size);
+    }
+    return PoolType::Instance().Allocate();
+  }
+
+  static void
+  operator delete(void * address, size_t size)
+  {
+    if (size != sizeof(PooledCell))
+    {
+      ::operator delete(address);
+      return;
+    }
+    PoolType::Instance().Deallocate(address);
+  }
+};
+
+} // end namespace wasm
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPrefilter_h
+#define itkWasmPrefilter_h
+// Reversible byte transforms applied to pixel data before compression
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace itk
+{
+
+/** Prefilters, as bit flags. The delta is applied before the byte shuffle.
+ *
+ * - Shuffle groups the i-th byte of every element together, so the slowly
+ *   varying high bytes of 16-bit samples form long, compressible runs.
+ * - Delta replaces each element with its difference to the element one row
+ *   before, with wrapping integer arithmetic on the element bits, so it is
+ *   lossless for any component type.
+ */
+enum class WasmPrefilterEnum : uint8_t
+{
+  None = 0,
+  Shuffle = 1,
+  Delta = 2,
+  DeltaShuffle = 3
+};
+
+/** Prefilter and the layout it was applied with. */
+struct WasmPrefilterParameters
+{
+  WasmPrefilterEnum prefilter{ WasmPrefilterEnum::None };
+  /** Size of the elements in bytes, e.g. the component size. */
+  uint8_t elementSize{ 1 };
+  /** Number of elements per row for the delta. */
+  uint32_t rowLength{ 1 };
+};
+
+/** Parse "none", "shuffle", "delta" or "delta-shuffle". Throws
+ * std::invalid_argument for other values. */
+WebAssemblyInterface_EXPORT
+WasmPrefilterEnum
+wasmPrefilterFromString(const std::string & prefilter);
+
+WebAssemblyInterface_EXPORT
+std::string
+wasmPrefilterToString(WasmPrefilterEnum prefilter);
+
+WebAssemblyInterface_EXPORT
+std::ostream &
+operator<<(std::ostream & out, WasmPrefilterEnum prefilter);
+
+/** Apply the prefilter to length bytes of input, writing to output, which
+ * must not overlap. Trailing bytes that do not form an element are copied. */
+WebAssemblyInterface_EXPORT
+void
+applyWasmPrefilter(const WasmPrefilterParameters & parameters, const void * input, void * output, size_t length);
+
+/** Undo the prefilter in place. */
+WebAssemblyInterface_EXPORT
+void
+undoWasmPrefilter(const WasmPrefilterParameters & parameters, void * data, size_t length);
+
+/** Size of the zstd skippable frame that records the prefilter parameters. */
+constexpr size_t WasmPrefilterFrameSize = 20;
+
+/** Encode the parameters in a zstd skippable frame, which decompressors that
+ * do not know it skip, of WasmPrefilterFrameSize bytes. */
+WebAssemblyInterface_EXPORT
+void
+writeWasmPrefilterFrame(const WasmPrefilterParameters & parameters, unsigned char * frame);
+
+/** Decode the parameters when data starts with a prefilter frame. Returns
+ * false, and leaves the parameters unchanged, when it does not. Throws
+ * std::runtime_error when the parameters cannot be undone. */
+WebAssemblyInterface_EXPORT
+bool
+readWasmPrefilterFrame(const unsigned char * data, size_t length, WasmPrefilterParameters & parameters);
+
+} // end namespace itk
+
+#endif // itkWasmPrefilter_h
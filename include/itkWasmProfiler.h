@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmProfiler_h
+#define itkWasmProfiler_h
+
+#include "itkProcessObject.h"
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+namespace wasm
+{
+
+/**
+ *\class Profiler
+ * \brief Record the stages of a pipeline invocation as trace events
+ *
+ * Each event has the wall time, the process CPU time, the bytes moved by the
+ * stage, and the allocations made on the thread that ran it. The events are
+ * written in the Chrome trace event format, which is loaded by
+ * chrome://tracing and https://ui.perfetto.dev.
+ *
+ * Allocations from the memory IO store are always counted. Other heap
+ * allocations are counted when the module is built with the
+ * ITKWASM_COUNT_ALLOCATIONS CMake option, which replaces the global operator
+ * new. Allocations made by the worker threads of a filter are not counted.
+ *
+ * A Pipeline called with `--profile <file>` creates a Profiler and writes it
+ * when the invocation ends.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT Profiler
+{
+public:
+  using ClockType = std::chrono::steady_clock;
+  using TimePoint = ClockType::time_point;
+
+  /** Allocations counted on a thread. */
+  struct AllocationCount
+  {
+    size_t allocations{ 0 };
+    size_t bytes{ 0 };
+  };
+
+  /** Event times are recorded relative to origin, e.g. the start of the
+   * invocation. */
+  Profiler(std::string fileName, TimePoint origin);
+
+  Profiler(const Profiler &) = delete;
+  Profiler & operator=(const Profiler &) = delete;
+
+  /** Record a stage that ran from start to end, and made the allocated
+   * allocations. */
+  void
+  AddEvent(std::string name, const char * category, TimePoint start, TimePoint end, double cpuSeconds, size_t bytes, AllocationCount allocated = {});
+
+  /** Count an allocation on the calling thread. */
+  static void
+  CountAllocation(size_t bytes) noexcept;
+
+  /** Allocations counted so far on the calling thread. Subtract two counts
+   * to get the allocations of a stage. */
+  static AllocationCount
+  GetAllocationCount() noexcept;
+
+  /** Record every update of the process object, from its StartEvent to its
+   * EndEvent. */
+  void
+  Observe(ProcessObject * process);
+
+  /** Write the events to the file. */
+  void
+  Write() const;
+
+  const std::string &
+  GetFileName() const
+  {
+    return m_FileName;
+  }
+
+private:
+  struct Event
+  {
+    std::string name;
+    const char * category;
+    double start;
+    double duration;
+    double cpuDuration;
+    size_t bytes;
+    AllocationCount allocated;
+    size_t thread;
+  };
+
+  std::string m_FileName;
+  TimePoint m_Origin;
+  std::vector<Event> m_Events;
+  mutable std::mutex m_Mutex;
+};
+
+/**
+ *\class ProfileScope
+ * \brief Record the lifetime of the scope as a stage of the current pipeline
+ * invocation when it is profiled
+ *
+ * Nothing is recorded when the invocation is not profiled.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT ProfileScope
+{
+public:
+  ProfileScope(const char * name, const char * category);
+  ~ProfileScope();
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope & operator=(const ProfileScope &) = delete;
+
+  /** Bytes read, converted, or written by the stage. */
+  void
+  SetBytes(size_t bytes)
+  {
+    m_Bytes = bytes;
+  }
+
+private:
+  Profiler *                m_Profiler;
+  const char *              m_Name;
+  const char *              m_Category;
+  Profiler::TimePoint       m_Start;
+  std::clock_t              m_CPUStart{ 0 };
+  size_t                    m_Bytes{ 0 };
+  Profiler::AllocationCount m_AllocationStart;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
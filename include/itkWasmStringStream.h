@@ -19,6 +19,7 @@
 #define itkWasmStringStream_h
 
 #include "itkWasmDataObject.h"
+#include "itkWasmDescriptor.h"
 #include <string_view>
 
 #include "WebAssemblyInterfaceExport.h"
@@ -30,7 +31,7 @@ namespace itk
   
 struct StringStreamJSON
 {
-  std::string data;
+  DescriptorArrayJSON data;
   size_t size;
 };
 
@@ -40,7 +41,7 @@ struct StringStreamJSON
  *
  * JSON representation for a std::stringstream for interfacing across programming languages and runtimes.
  * 
- * { size: sizeInBytes, data: stringDataURI }
+ * { size: sizeInBytes, data: dataAddress }
  * 
  * When representing text objects, `data` is not expected to include a C null termination character and sizeInBytes does not include this character.
  * 
@@ -90,8 +91,7 @@ public:
       throw std::runtime_error("Failed to deserialize StringStreamJSON: " + descriptiveError);
     }
     auto stringStream = deserializedAttempt.value();
-    const std::string dataString = stringStream.data;
-    const char * dataPtr = reinterpret_cast< char * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
+    const char * dataPtr = descriptorArrayPointer<char>(stringStream.data);
     size_t size = stringStream.size;
     const std::string_view string(dataPtr, size);
     m_StringStream.str(std::string{string});
@@ -105,9 +105,9 @@ protected:
   void UpdateJSON()
   {
     std::ostringstream jsonStream;
-    jsonStream << "{ \"data\": \"data:application/vnd.itk.address,0:";
+    jsonStream << "{ \"data\": ";
     jsonStream << reinterpret_cast< size_t >( m_StringStream.str().data() );
-    jsonStream << "\", \"size\": ";
+    jsonStream << ", \"size\": ";
     jsonStream << m_StringStream.str().size() + 1;
     jsonStream << "}";
     this->m_JSON = jsonStream.str();
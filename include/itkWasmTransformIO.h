@@ -110,7 +110,8 @@ protected:
   WriteParameters();
 
   void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  size_t WriteCBOR(const void * buffer = nullptr, unsigned char ** cborBuffer = nullptr, bool allocateCBORBuffer = false);
+  /** Stream the CBOR encoding of the transform list. */
+  void WriteCBOR(std::ostream & outputStream);
 
   cbor_item_t * m_CBORRoot{ nullptr };
 
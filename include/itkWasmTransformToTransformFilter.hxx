@@ -21,6 +21,7 @@
 #include "itkTransformFactoryBase.h"
 
 #include "itktransformParameterizationString.h"
+#include "itkWasmDescriptor.h"
 #include <exception>
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
@@ -136,7 +137,7 @@ WasmTransformToTransformFilter<TTransform>
   // Get the input and output pointers
   const WasmTransformType * wasmTransform = this->GetInput();
   const std::string json(wasmTransform->GetJSON());
-  auto deserializedAttempt = glz::read_json<TransformListJSON>(json);
+  auto deserializedAttempt = readDescriptor<TransformListJSON>(json, wasmTransform->GetBinaryDescriptor());
   if (!deserializedAttempt)
   {
     const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -236,9 +237,9 @@ WasmTransformToTransformFilter<TTransform>
       // Correct extra reference count from CreateInstance()
       ptr->UnRegister();
 
-      FixedParametersValueType * fixedPtr = reinterpret_cast< FixedParametersValueType * >( std::strtoull(transformJSON.fixedParameters.substr(35).c_str(), nullptr, 10) );
+      FixedParametersValueType * fixedPtr = descriptorArrayPointer<FixedParametersValueType>(transformJSON.fixedParameters);
       ptr->CopyInFixedParameters(fixedPtr, fixedPtr + transformJSON.numberOfFixedParameters);
-      ParametersValueType * paramsPtr = reinterpret_cast< ParametersValueType * >( std::strtoull(transformJSON.parameters.substr(35).c_str(), nullptr, 10) );
+      ParametersValueType * paramsPtr = descriptorArrayPointer<ParametersValueType>(transformJSON.parameters);
       ptr->CopyInParameters(paramsPtr, paramsPtr + transformJSON.numberOfParameters);
 
       using CompositeTransformType = CompositeTransform<ParametersValueType, TransformType::InputSpaceDimension>;
@@ -247,9 +248,9 @@ WasmTransformToTransformFilter<TTransform>
     }
     else
     {
-      FixedParametersValueType * fixedPtr = reinterpret_cast< FixedParametersValueType * >( std::strtoull(transformJSON.fixedParameters.substr(35).c_str(), nullptr, 10) );
+      FixedParametersValueType * fixedPtr = descriptorArrayPointer<FixedParametersValueType>(transformJSON.fixedParameters);
       transform->CopyInFixedParameters(fixedPtr, fixedPtr + transformJSON.numberOfFixedParameters);
-      ParametersValueType * paramsPtr = reinterpret_cast< ParametersValueType * >( std::strtoull(transformJSON.parameters.substr(35).c_str(), nullptr, 10) );
+      ParametersValueType * paramsPtr = descriptorArrayPointer<ParametersValueType>(transformJSON.parameters);
       transform->CopyInParameters(paramsPtr, paramsPtr + transformJSON.numberOfParameters);
 
       auto dictionary = transform->GetMetaDataDictionary();
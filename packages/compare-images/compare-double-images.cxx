@@ -85,6 +85,8 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   diff->SetDifferenceThreshold(differenceThreshold);
   diff->SetToleranceRadius(radiusTolerance);
   diff->SetIgnoreBoundaryPixels(ignoreBoundaryPixels);
+  differenceImage.UseOutputBuffer(diff);
+  pipeline.observe_process(diff);
 
   double minimumDifference = itk::NumericTraits<double>::max();
   double maximumDifference = itk::NumericTraits<double>::NonpositiveMin();
@@ -193,6 +195,8 @@ CompareImages(itk::wasm::Pipeline & pipeline, const TImage * testImage)
   const unsigned char unsignedCharMax = itk::NumericTraits<unsigned char>::max();
   rescale->SetOutputMaximum(unsignedCharMax);
   rescale->SetInput(extract->GetOutput());
+  differenceUchar2DImage.UseOutputBuffer(rescale);
+  pipeline.observe_process(rescale);
   ITK_WASM_CATCH_EXCEPTION(pipeline, rescale->UpdateLargestPossibleRegion());
 
   typename Uchar2DImageType::ConstPointer rescaled = rescale->GetOutput();
@@ -220,7 +224,7 @@ public:
   }
 };
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("compare-double-images", "Compare double pixel type images with a tolerance for regression testing.", argc, argv);
 
@@ -229,3 +233,5 @@ int main(int argc, char * argv[])
    double>
   ::Dimensions<2U,3U,4U,5U,6U>("test-image", pipeline);
 }
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
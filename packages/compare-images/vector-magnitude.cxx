@@ -48,6 +48,8 @@ public:
 
     auto magnitudeFilter = MagnitudeFilterType::New();
     magnitudeFilter->SetInput(vectorImage.Get());
+    magnitudeImage.UseOutputBuffer(magnitudeFilter);
+    pipeline.observe_process(magnitudeFilter);
     ITK_WASM_CATCH_EXCEPTION(pipeline, magnitudeFilter->UpdateLargestPossibleRegion());
 
     typename ScalarImageType::ConstPointer magnitude = magnitudeFilter->GetOutput();
@@ -57,11 +59,13 @@ public:
   }
 };
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("vector-magnitude", "Generate a scalar magnitude image based on the input vector's norm.", argc, argv);
 
   return itk::wasm::SupportInputImageTypes<PipelineFunctor,
   itk::VariableLengthVector<double> >
   ::Dimensions<2U,3U,4U,5U,6U>("vector-image", pipeline);
-}
\ No newline at end of file
+}
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
@@ -0,0 +1,198 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+// Compare compressing small payloads one by one, with a reused context, and
+// with a trained dictionary.
+//
+// Usage: compress-stringify-benchmark <samples directory> [block size] [iterations]
+//
+// The files in the directory, e.g. test/data/input, are split into blocks of
+// the block size. Every other block is used to train the dictionary, and the
+// remaining blocks are compressed.
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "zstd.h"
+#include "zdict.h"
+
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
+#include "itkTimeProbe.h"
+
+namespace
+{
+
+constexpr int CompressionLevel = 3;
+
+struct Result
+{
+  size_t compressedSize{ 0 };
+  double secondsPerBlock{ 0.0 };
+};
+
+template <typename TCompress>
+Result
+benchmark(const std::vector<std::string> & blocks, unsigned int iterations, TCompress compress)
+{
+  Result result;
+  std::vector<char> compressed;
+  itk::TimeProbe probe;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    result.compressedSize = 0;
+    probe.Start();
+    for (const auto & block : blocks)
+    {
+      compressed.resize(ZSTD_compressBound(block.size()));
+      result.compressedSize += compress(compressed, block);
+    }
+    probe.Stop();
+  }
+  result.secondsPerBlock = probe.GetMean() / blocks.size();
+  return result;
+}
+
+void
+report(const char * name, const Result & result, size_t inputSize)
+{
+  std::cout << name << ": " << result.compressedSize << " bytes, ratio "
+            << static_cast<double>(inputSize) / result.compressedSize << ", "
+            << result.secondsPerBlock * 1.0e6 << " us per block" << std::endl;
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <samples directory> [block size] [iterations]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string samplesDirectory = argv[1];
+  const size_t blockSize = argc > 2 ? std::stoul(argv[2]) : 4096;
+  const unsigned int iterations = argc > 3 ? std::stoul(argv[3]) : 20;
+
+  itksys::Directory directory;
+  if (!directory.Load(samplesDirectory))
+  {
+    std::cerr << "Could not read the samples directory: " << samplesDirectory << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<std::string> sampleFiles;
+  for (unsigned long ii = 0; ii < directory.GetNumberOfFiles(); ++ii)
+  {
+    const std::string sampleFile = samplesDirectory + "/" + directory.GetFile(ii);
+    if (!itksys::SystemTools::FileIsDirectory(sampleFile))
+    {
+      sampleFiles.push_back(sampleFile);
+    }
+  }
+  std::sort(sampleFiles.begin(), sampleFiles.end());
+
+  std::string trainingSamples;
+  std::vector<size_t> trainingSizes;
+  std::vector<std::string> blocks;
+  size_t inputSize = 0;
+  size_t blockIndex = 0;
+  for (const auto & sampleFile : sampleFiles)
+  {
+    std::ifstream sampleStream(sampleFile, std::ios::binary);
+    const std::string sample((std::istreambuf_iterator<char>(sampleStream)), std::istreambuf_iterator<char>());
+    for (size_t begin = 0; begin < sample.size(); begin += blockSize, ++blockIndex)
+    {
+      const std::string block = sample.substr(begin, blockSize);
+      if (blockIndex % 2 == 0)
+      {
+        trainingSamples += block;
+        trainingSizes.push_back(block.size());
+      }
+      else
+      {
+        inputSize += block.size();
+        blocks.push_back(block);
+      }
+    }
+  }
+  if (blocks.empty())
+  {
+    std::cerr << "No samples in " << samplesDirectory << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // zstd recommends about 100 times more training data than the dictionary size
+  const size_t dictionaryCapacity = std::clamp<size_t>(trainingSamples.size() / 100, 1024, 112640);
+  std::vector<char> dictionary(dictionaryCapacity);
+  const size_t dictionarySize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), trainingSamples.data(), trainingSizes.data(), static_cast<unsigned int>(trainingSizes.size()));
+  if (ZDICT_isError(dictionarySize))
+  {
+    std::cerr << "Dictionary training failed: " << ZDICT_getErrorName(dictionarySize) << std::endl;
+    return EXIT_FAILURE;
+  }
+  dictionary.resize(dictionarySize);
+
+  std::cout << blocks.size() << " blocks of up to " << blockSize << " bytes, " << inputSize << " bytes" << std::endl;
+  std::cout << "Dictionary: " << dictionarySize << " bytes from " << trainingSizes.size() << " samples" << std::endl;
+
+  const Result single = benchmark(blocks, iterations, [](std::vector<char> & compressed, const std::string & block) {
+    return ZSTD_compress(compressed.data(), compressed.size(), block.data(), block.size(), CompressionLevel);
+  });
+  report("ZSTD_compress", single, inputSize);
+
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+  const Result reused = benchmark(blocks, iterations, [&](std::vector<char> & compressed, const std::string & block) {
+    return ZSTD_compressCCtx(context.get(), compressed.data(), compressed.size(), block.data(), block.size(), CompressionLevel);
+  });
+  report("Reused context", reused, inputSize);
+
+  std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> compressionDictionary(ZSTD_createCDict(dictionary.data(), dictionary.size(), CompressionLevel), &ZSTD_freeCDict);
+  const Result withDictionary = benchmark(blocks, iterations, [&](std::vector<char> & compressed, const std::string & block) {
+    return ZSTD_compress_usingCDict(context.get(), compressed.data(), compressed.size(), block.data(), block.size(), compressionDictionary.get());
+  });
+  report("Dictionary", withDictionary, inputSize);
+
+  // The dictionary round trip
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> decompressionContext(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> decompressionDictionary(ZSTD_createDDict(dictionary.data(), dictionary.size()), &ZSTD_freeDDict);
+  std::vector<char> compressed;
+  std::vector<char> decompressed;
+  itk::TimeProbe decompressionProbe;
+  for (const auto & block : blocks)
+  {
+    compressed.resize(ZSTD_compressBound(block.size()));
+    compressed.resize(ZSTD_compress_usingCDict(context.get(), compressed.data(), compressed.size(), block.data(), block.size(), compressionDictionary.get()));
+    decompressed.resize(block.size());
+    decompressionProbe.Start();
+    const size_t decompressedSize = ZSTD_decompress_usingDDict(decompressionContext.get(), decompressed.data(), decompressed.size(), compressed.data(), compressed.size(), decompressionDictionary.get());
+    decompressionProbe.Stop();
+    if (ZSTD_isError(decompressedSize) || decompressedSize != block.size() || !std::equal(decompressed.begin(), decompressed.end(), block.begin()))
+    {
+      std::cerr << "The dictionary round trip failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "Dictionary decompression: " << decompressionProbe.GetMean() * 1.0e6 << " us per block" << std::endl;
+
+  return EXIT_SUCCESS;
+}
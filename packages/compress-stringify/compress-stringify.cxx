@@ -16,70 +16,181 @@
  *
  *=========================================================================*/
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <iostream>
 #include <sstream>
 #include <vector>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
 
 #include "zstd.h"
-#include "cpp-base64/base64.h"
+#include "zdict.h"
+#include "itksys/Directory.hxx"
+#include "itksys/SystemTools.hxx"
 
 #include "itkPipeline.h"
 #include "itkInputBinaryStream.h"
 #include "itkOutputTextStream.h"
 #include "itkOutputBinaryStream.h"
+#include "itkWasmBase64.h"
+#include "itkWasmPrefilter.h"
 
-int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel)
+// Compression context, and the prepared dictionary when one is used
+struct Compressor
 {
-  itk::wasm::OutputBinaryStream outputBinaryStream;
-  pipeline.add_option("output", outputBinaryStream, "Output compressed binary")->type_name("OUTPUT_BINARY_STREAM");
+  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context{ ZSTD_createCCtx(), &ZSTD_freeCCtx };
+  std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)> dictionary{ nullptr, &ZSTD_freeCDict };
+  int compressionLevel = 3;
+};
 
-  ITK_WASM_PARSE(pipeline);
+// Compress a block of input and write the compressed bytes, or, at the end,
+// finish the frame
+void compressBlock(ZSTD_CCtx * context, const char * data, size_t size, ZSTD_EndDirective directive, std::ostream & output, std::vector<char> & compressedBlock)
+{
+  ZSTD_inBuffer inputBuffer{ data, size, 0 };
+  bool finished = false;
+  while (!finished)
+  {
+    ZSTD_outBuffer outputBuffer{ compressedBlock.data(), compressedBlock.size(), 0 };
+    const size_t remaining = ZSTD_compressStream2(context, &outputBuffer, &inputBuffer, directive);
+    if (ZSTD_isError(remaining))
+    {
+      throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+    }
+    output.write(compressedBlock.data(), outputBuffer.pos);
+    finished = directive == ZSTD_e_end ? remaining == 0 : inputBuffer.pos == inputBuffer.size;
+  }
+}
+
+// Compress the input to the output in blocks, so neither is held in memory.
+// The prefilter, when used, is recorded in a skippable frame before the zstd
+// frame. It works on whole rows, so then the input is read at once.
+void compressStream(std::istream & input, std::ostream & output, const Compressor & compressor, const itk::WasmPrefilterParameters & prefilter)
+{
+  ZSTD_CCtx * context = compressor.context.get();
+  ZSTD_CCtx_reset(context, ZSTD_reset_session_and_parameters);
+  if (compressor.dictionary)
+  {
+    ZSTD_CCtx_refCDict(context, compressor.dictionary.get());
+  }
+  else
+  {
+    ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, compressor.compressionLevel);
+  }
+  std::vector<char> compressedBlock(ZSTD_CStreamOutSize());
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
+  if (prefilter.prefilter != itk::WasmPrefilterEnum::None)
+  {
+    const std::string inputBinary((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::vector<char> filteredBinary(inputBinary.size());
+    itk::applyWasmPrefilter(prefilter, inputBinary.data(), filteredBinary.data(), inputBinary.size());
+    unsigned char prefilterFrame[itk::WasmPrefilterFrameSize];
+    itk::writeWasmPrefilterFrame(prefilter, prefilterFrame);
+    output.write(reinterpret_cast<const char *>(prefilterFrame), itk::WasmPrefilterFrameSize);
+    compressBlock(context, filteredBinary.data(), filteredBinary.size(), ZSTD_e_end, output, compressedBlock);
+    return;
+  }
 
+  // Record the content size in the frame header when the input size is known
+  const std::streampos start = input.tellg();
+  if (start != std::streampos(-1))
+  {
+    input.seekg(0, std::ios::end);
+    const std::streampos end = input.tellg();
+    input.seekg(start);
+    if (end != std::streampos(-1))
+    {
+      ZSTD_CCtx_setPledgedSrcSize(context, static_cast<unsigned long long>(end - start));
+    }
+  }
+
+  std::vector<char> inputBlock(ZSTD_CStreamInSize());
+  do
+  {
+    input.read(inputBlock.data(), inputBlock.size());
+    const size_t count = static_cast<size_t>(input.gcount());
+    compressBlock(context, inputBlock.data(), count, input ? ZSTD_e_continue : ZSTD_e_end, output, compressedBlock);
+  } while (input);
+}
 
-  const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
-  std::vector<char> compressedBinary(compressedBufferSize);
+int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, const Compressor & compressor, const itk::WasmPrefilterParameters & prefilter)
+{
+  itk::wasm::OutputBinaryStream outputBinaryStream;
+  pipeline.add_option("output", outputBinaryStream, "Output compressed binary")->type_name("OUTPUT_BINARY_STREAM");
 
-  const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinary.size(), compressionLevel);
-  compressedBinary.resize(compressedSize);
+  ITK_WASM_PARSE(pipeline);
 
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+  compressStream(inputBinaryStream.Get(), outputBinaryStream.Get(), compressor, prefilter);
 
   return EXIT_SUCCESS;
 }
 
-int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, const std::string & dataURLPrefix)
+int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, const Compressor & compressor, const std::string & dataURLPrefix, const itk::WasmPrefilterParameters & prefilter)
 {
   itk::wasm::OutputTextStream outputTextStream;
   pipeline.add_option("output", outputTextStream, "Output dataURL+base64 compressed binary")->type_name("OUTPUT_TEXT_STREAM");
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) );
+  outputTextStream.Get() << dataURLPrefix;
+
+  // The compressed blocks are base64 encoded as they are written
+  itk::Base64OutputStreamBuffer base64Buffer(outputTextStream.Get());
+  std::ostream base64Stream(&base64Buffer);
+  compressStream(inputBinaryStream.Get(), base64Stream, compressor, prefilter);
+  base64Buffer.Finish();
+
+  return EXIT_SUCCESS;
+}
 
+// Train a dictionary on the files in a directory, each file is a sample
+int trainDictionary(itk::wasm::Pipeline & pipeline, const std::string & samplesDirectory, size_t dictionarySize)
+{
+  itk::wasm::OutputBinaryStream outputBinaryStream;
+  pipeline.add_option("output", outputBinaryStream, "Output dictionary")->type_name("OUTPUT_BINARY_STREAM");
 
-  const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
-  std::string compressedBinary;
-  compressedBinary.resize(compressedBufferSize);
+  ITK_WASM_PARSE(pipeline);
 
-  const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinary.size(), compressionLevel);
-  compressedBinary.resize(compressedSize);
+  itksys::Directory directory;
+  if (!directory.Load(samplesDirectory))
+  {
+    std::cerr << "Could not read the samples directory: " << samplesDirectory << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<std::string> sampleFiles;
+  for (unsigned long ii = 0; ii < directory.GetNumberOfFiles(); ++ii)
+  {
+    const std::string sampleFile = samplesDirectory + "/" + directory.GetFile(ii);
+    if (!itksys::SystemTools::FileIsDirectory(sampleFile))
+    {
+      sampleFiles.push_back(sampleFile);
+    }
+  }
+  // The dictionary does not depend on the directory listing order
+  std::sort(sampleFiles.begin(), sampleFiles.end());
 
-  // Do we want/need this?
-  constexpr bool urlFriendly = false;
-  auto outputText = base64_encode(compressedBinary, urlFriendly);
+  std::string samples;
+  std::vector<size_t> sampleSizes;
+  for (const auto & sampleFile : sampleFiles)
+  {
+    std::ifstream sampleStream(sampleFile, std::ios::binary);
+    const std::string sample((std::istreambuf_iterator<char>(sampleStream)), std::istreambuf_iterator<char>());
+    samples += sample;
+    sampleSizes.push_back(sample.size());
+  }
 
-  outputTextStream.Get() << dataURLPrefix;
-  outputTextStream.Get() << outputText;
+  std::vector<char> dictionary(dictionarySize);
+  const size_t trainedSize = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), samples.data(), sampleSizes.data(), static_cast<unsigned int>(sampleSizes.size()));
+  if (ZDICT_isError(trainedSize))
+  {
+    std::cerr << "Dictionary training failed: " << ZDICT_getErrorName(trainedSize) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  outputBinaryStream.Get().write(dictionary.data(), trainedSize);
 
   return EXIT_SUCCESS;
 }
@@ -100,11 +211,55 @@ int main(int argc, char * argv[])
   std::string dataURLPrefix("data:application/zstd;base64,");
   pipeline.add_option("-p,--data-url-prefix", dataURLPrefix, "dataURL prefix");
 
+  // Validator descriptions are cleared so the interface type stays a plain
+  // TEXT or UINT for the generated bindings
+  std::string prefilterName("none");
+  pipeline.add_option("--prefilter", prefilterName, "Prefilter applied before compression: none, shuffle, delta, or delta-shuffle")->check(CLI::IsMember({"none", "shuffle", "delta", "delta-shuffle"}).description(""));
+
+  unsigned int elementSize = 1;
+  pipeline.add_option("--element-size", elementSize, "Size in bytes of the elements shuffled and delta coded by the prefilter, e.g. 2 for 16-bit pixels")->check(CLI::IsMember({1, 2, 4, 8}).description(""));
+
+  unsigned int rowLength = 1;
+  pipeline.add_option("--row-length", rowLength, "Number of elements per row for the delta prefilter, e.g. the image width times the number of components")->check(CLI::PositiveNumber.description(""));
+
+  std::string dictionaryFile;
+  pipeline.add_option("--dictionary", dictionaryFile, "Dictionary trained with --train-dictionary, improves the compression of small inputs")->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
+  std::string samplesDirectory;
+  pipeline.add_option("--train-dictionary", samplesDirectory, "Train a dictionary on the files in this directory and output it instead of compressing the input")->check(CLI::ExistingDirectory.description(""));
+
+  size_t dictionarySize = 112640;
+  pipeline.add_option("--dictionary-size", dictionarySize, "Maximum size of the trained dictionary in bytes");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
+  if(!samplesDirectory.empty())
+  {
+    return trainDictionary(pipeline, samplesDirectory, dictionarySize);
+  }
+
+  Compressor compressor;
+  compressor.compressionLevel = compressionLevel;
+  if(!dictionaryFile.empty())
+  {
+    std::ifstream dictionaryStream(dictionaryFile, std::ios::binary);
+    const std::string dictionary((std::istreambuf_iterator<char>(dictionaryStream)), std::istreambuf_iterator<char>());
+    compressor.dictionary.reset(ZSTD_createCDict(dictionary.data(), dictionary.size(), compressionLevel));
+    if(!compressor.dictionary)
+    {
+      std::cerr << "Could not load the dictionary: " << dictionaryFile << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  itk::WasmPrefilterParameters prefilter;
+  prefilter.prefilter = itk::wasmPrefilterFromString(prefilterName);
+  prefilter.elementSize = static_cast<uint8_t>(elementSize);
+  prefilter.rowLength = rowLength;
+
   if(stringify)
   {
-    return compressStringify(pipeline, inputBinaryStream, compressionLevel, dataURLPrefix);
+    return compressStringify(pipeline, inputBinaryStream, compressor, dataURLPrefix, prefilter);
   }
-  return compress(pipeline, inputBinaryStream, compressionLevel);
+  return compress(pipeline, inputBinaryStream, compressor, prefilter);
 }
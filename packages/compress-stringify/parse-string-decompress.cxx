@@ -22,16 +22,97 @@
 #include <sstream>
 #include <vector>
 #include <iterator>
+#include <memory>
+#include <stdexcept>
 
 #include "zstd.h"
-#include "cpp-base64/base64.h"
 
 #include "itkPipeline.h"
 #include "itkInputBinaryStream.h"
 #include "itkInputTextStream.h"
 #include "itkOutputBinaryStream.h"
+#include "itkWasmBase64.h"
+#include "itkWasmPrefilter.h"
 
-int decompress(itk::wasm::Pipeline & pipeline)
+// Decompression context, and the prepared dictionary when one is used
+struct Decompressor
+{
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context{ ZSTD_createDCtx(), &ZSTD_freeDCtx };
+  std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)> dictionary{ nullptr, &ZSTD_freeDDict };
+};
+
+// Decompress the input to the output in blocks, so neither is held in memory.
+// When the input starts with a prefilter frame, the whole output is needed to
+// undo the prefilter, so it is written at the end.
+void decompressStream(std::istream & input, std::ostream & output, const Decompressor & decompressor)
+{
+  ZSTD_DCtx * context = decompressor.context.get();
+  ZSTD_DCtx_reset(context, ZSTD_reset_session_and_parameters);
+  if (decompressor.dictionary)
+  {
+    ZSTD_DCtx_refDDict(context, decompressor.dictionary.get());
+  }
+  std::vector<char> inputBlock(ZSTD_DStreamInSize());
+  std::vector<char> decompressedBlock(ZSTD_DStreamOutSize());
+
+  input.read(inputBlock.data(), inputBlock.size());
+  size_t count = static_cast<size_t>(input.gcount());
+  if (count == 0)
+  {
+    throw std::runtime_error("The input is empty");
+  }
+  const auto * header = reinterpret_cast<const unsigned char *>(inputBlock.data());
+  itk::WasmPrefilterParameters prefilter;
+  const size_t offset = itk::readWasmPrefilterFrame(header, count, prefilter) ? itk::WasmPrefilterFrameSize : 0;
+  const unsigned int dictionaryID = offset < count ? ZSTD_getDictID_fromFrame(header + offset, count - offset) : 0;
+  if (dictionaryID != 0 && !decompressor.dictionary)
+  {
+    throw std::runtime_error("The input was compressed with dictionary " + std::to_string(dictionaryID) + ", which is passed with --dictionary");
+  }
+
+  // Skippable frames, like the prefilter frame, produce no output
+  const bool prefiltered = prefilter.prefilter != itk::WasmPrefilterEnum::None;
+  std::vector<char> filteredBinary;
+  size_t frameRemaining = 0;
+  while (count > 0)
+  {
+    ZSTD_inBuffer inputBuffer{ inputBlock.data(), count, 0 };
+    bool flushing = false;
+    while (inputBuffer.pos < inputBuffer.size || flushing)
+    {
+      ZSTD_outBuffer outputBuffer{ decompressedBlock.data(), decompressedBlock.size(), 0 };
+      frameRemaining = ZSTD_decompressStream(context, &outputBuffer, &inputBuffer);
+      if (ZSTD_isError(frameRemaining))
+      {
+        throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(frameRemaining));
+      }
+      if (prefiltered)
+      {
+        filteredBinary.insert(filteredBinary.end(), decompressedBlock.data(), decompressedBlock.data() + outputBuffer.pos);
+      }
+      else
+      {
+        output.write(decompressedBlock.data(), outputBuffer.pos);
+      }
+      // A full output block may leave decompressed data in the context
+      flushing = outputBuffer.pos == outputBuffer.size && frameRemaining != 0;
+    }
+    input.read(inputBlock.data(), inputBlock.size());
+    count = static_cast<size_t>(input.gcount());
+  }
+  if (frameRemaining != 0)
+  {
+    throw std::runtime_error("The input ends within a zstd frame");
+  }
+
+  if (prefiltered)
+  {
+    itk::undoWasmPrefilter(prefilter, filteredBinary.data(), filteredBinary.size());
+    output.write(filteredBinary.data(), filteredBinary.size());
+  }
+}
+
+int decompress(itk::wasm::Pipeline & pipeline, const Decompressor & decompressor)
 {
   itk::wasm::InputBinaryStream inputBinaryStream;
   pipeline.add_option("input", inputBinaryStream, "Compressed input")->type_name("INPUT_BINARY_STREAM");
@@ -41,24 +122,12 @@ int decompress(itk::wasm::Pipeline & pipeline)
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
-
-
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
-
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  decompressStream(inputBinaryStream.Get(), outputBinaryStream.Get(), decompressor);
 
   return EXIT_SUCCESS;
 }
 
-int decodeDecompress(itk::wasm::Pipeline & pipeline)
+int decodeDecompress(itk::wasm::Pipeline & pipeline, const Decompressor & decompressor)
 {
   itk::wasm::InputTextStream inputTextStream;
   pipeline.add_option("input", inputTextStream, "Compressed input")->type_name("INPUT_TEXT_STREAM");
@@ -69,27 +138,19 @@ int decodeDecompress(itk::wasm::Pipeline & pipeline)
   ITK_WASM_PARSE(pipeline);
 
   // Skip dataURLPrefix
-  auto inputTextIt = std::istream_iterator<char>(inputTextStream.Get());
-  while (*inputTextIt != ',')
+  std::string dataURLPrefix;
+  std::getline(inputTextStream.Get(), dataURLPrefix, ',');
+  if (inputTextStream.Get().eof())
   {
-    inputTextIt++;
+    std::cerr << "The input is not a dataURL" << std::endl;
+    return EXIT_FAILURE;
   }
-  inputTextIt++;
-
-  std::string inputText;
-  inputText.assign( (inputTextIt), 
-                    (std::istream_iterator<char>()) ); 
 
-  auto inputBinary = base64_decode(inputText);
-
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
-
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  // The base64 text is decoded as it is read. Decoding errors are rethrown
+  itk::Base64InputStreamBuffer base64Buffer(inputTextStream.Get());
+  std::istream base64Stream(&base64Buffer);
+  base64Stream.exceptions(std::ios::badbit);
+  decompressStream(base64Stream, outputBinaryStream.Get(), decompressor);
 
   return EXIT_SUCCESS;
 }
@@ -101,12 +162,28 @@ int main(int argc, char * argv[])
   bool parseString = false;
   pipeline.add_flag("-s,--parse-string", parseString, "Parse the input string before decompression");
 
+  std::string dictionaryFile;
+  pipeline.add_option("--dictionary", dictionaryFile, "Dictionary the input was compressed with")->check(CLI::ExistingFile)->type_name("INPUT_BINARY_FILE");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
+  Decompressor decompressor;
+  if(!dictionaryFile.empty())
+  {
+    std::ifstream dictionaryStream(dictionaryFile, std::ios::binary);
+    const std::string dictionary((std::istreambuf_iterator<char>(dictionaryStream)), std::istreambuf_iterator<char>());
+    decompressor.dictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    if(!decompressor.dictionary)
+    {
+      std::cerr << "Could not load the dictionary: " << dictionaryFile << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   if(parseString)
   {
-    return decodeDecompress(pipeline);
+    return decodeDecompress(pipeline, decompressor);
   }
-  return decompress(pipeline);
+  return decompress(pipeline, decompressor);
 }
 
@@ -14,6 +14,7 @@ from itkwasm.pyodide import (
 from itkwasm import (
     InterfaceTypes,
     BinaryStream,
+    BinaryFile,
 )
 
 async def compress_stringify_async(
@@ -21,6 +22,12 @@ async def compress_stringify_async(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    prefilter: str = "none",
+    element_size: int = 1,
+    row_length: int = 1,
+    dictionary: Optional[os.PathLike] = None,
+    train_dictionary: str = "",
+    dictionary_size: int = 112640,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +43,24 @@ async def compress_stringify_async(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param prefilter: Prefilter applied before compression: none, shuffle, delta, or delta-shuffle
+    :type  prefilter: str
+
+    :param element_size: Size in bytes of the elements shuffled and delta coded by the prefilter, e.g. 2 for 16-bit pixels
+    :type  element_size: int
+
+    :param row_length: Number of elements per row for the delta prefilter, e.g. the image width times the number of components
+    :type  row_length: int
+
+    :param dictionary: Dictionary trained with --train-dictionary, improves the compression of small inputs
+    :type  dictionary: os.PathLike
+
+    :param train_dictionary: Train a dictionary on the files in this directory and output it instead of compressing the input
+    :type  train_dictionary: str
+
+    :param dictionary_size: Maximum size of the trained dictionary in bytes
+    :type  dictionary_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -49,6 +74,18 @@ async def compress_stringify_async(
         kwargs["compressionLevel"] = to_js(compression_level)
     if data_url_prefix:
         kwargs["dataUrlPrefix"] = to_js(data_url_prefix)
+    if prefilter:
+        kwargs["prefilter"] = to_js(prefilter)
+    if element_size:
+        kwargs["elementSize"] = to_js(element_size)
+    if row_length:
+        kwargs["rowLength"] = to_js(row_length)
+    if dictionary is not None:
+        kwargs["dictionary"] = to_js(BinaryFile(dictionary))
+    if train_dictionary:
+        kwargs["trainDictionary"] = to_js(train_dictionary)
+    if dictionary_size:
+        kwargs["dictionarySize"] = to_js(dictionary_size)
 
     outputs = await js_module.compressStringify(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -14,11 +14,13 @@ from itkwasm.pyodide import (
 from itkwasm import (
     InterfaceTypes,
     BinaryStream,
+    BinaryFile,
 )
 
 async def parse_string_decompress_async(
     input: bytes,
     parse_string: bool = False,
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -28,6 +30,9 @@ async def parse_string_decompress_async(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param dictionary: Dictionary the input was compressed with
+    :type  dictionary: os.PathLike
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
@@ -37,6 +42,8 @@ async def parse_string_decompress_async(
     kwargs = {}
     if parse_string:
         kwargs["parseString"] = to_js(parse_string)
+    if dictionary is not None:
+        kwargs["dictionary"] = to_js(BinaryFile(dictionary))
 
     outputs = await js_module.parseStringDecompress(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
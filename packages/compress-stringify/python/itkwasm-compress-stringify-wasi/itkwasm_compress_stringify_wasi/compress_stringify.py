@@ -14,6 +14,7 @@ from itkwasm import (
     PipelineInput,
     Pipeline,
     BinaryStream,
+    BinaryFile,
 )
 
 def compress_stringify(
@@ -21,6 +22,12 @@ def compress_stringify(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    prefilter: str = "none",
+    element_size: int = 1,
+    row_length: int = 1,
+    dictionary: Optional[os.PathLike] = None,
+    train_dictionary: str = "",
+    dictionary_size: int = 112640,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +43,24 @@ def compress_stringify(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param prefilter: Prefilter applied before compression: none, shuffle, delta, or delta-shuffle
+    :type  prefilter: str
+
+    :param element_size: Size in bytes of the elements shuffled and delta coded by the prefilter, e.g. 2 for 16-bit pixels
+    :type  element_size: int
+
+    :param row_length: Number of elements per row for the delta prefilter, e.g. the image width times the number of components
+    :type  row_length: int
+
+    :param dictionary: Dictionary trained with --train-dictionary, improves the compression of small inputs
+    :type  dictionary: os.PathLike
+
+    :param train_dictionary: Train a dictionary on the files in this directory and output it instead of compressing the input
+    :type  train_dictionary: str
+
+    :param dictionary_size: Maximum size of the trained dictionary in bytes
+    :type  dictionary_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -71,6 +96,32 @@ def compress_stringify(
         args.append('--data-url-prefix')
         args.append(str(data_url_prefix))
 
+    if prefilter:
+        args.append('--prefilter')
+        args.append(str(prefilter))
+
+    if element_size:
+        args.append('--element-size')
+        args.append(str(element_size))
+
+    if row_length:
+        args.append('--row-length')
+        args.append(str(row_length))
+
+    if dictionary is not None:
+        input_file = str(PurePosixPath(dictionary))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(dictionary)))
+        args.append('--dictionary')
+        args.append(input_file)
+
+    if train_dictionary:
+        args.append('--train-dictionary')
+        args.append(str(train_dictionary))
+
+    if dictionary_size:
+        args.append('--dictionary-size')
+        args.append(str(dictionary_size))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
@@ -14,11 +14,13 @@ from itkwasm import (
     PipelineInput,
     Pipeline,
     BinaryStream,
+    BinaryFile,
 )
 
 def parse_string_decompress(
     input: bytes,
     parse_string: bool = False,
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -28,6 +30,9 @@ def parse_string_decompress(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param dictionary: Dictionary the input was compressed with
+    :type  dictionary: os.PathLike
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
@@ -55,6 +60,12 @@ def parse_string_decompress(
     if parse_string:
         args.append('--parse-string')
 
+    if dictionary is not None:
+        input_file = str(PurePosixPath(dictionary))
+        pipeline_inputs.append(PipelineInput(InterfaceTypes.BinaryFile, BinaryFile(dictionary)))
+        args.append('--dictionary')
+        args.append(input_file)
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
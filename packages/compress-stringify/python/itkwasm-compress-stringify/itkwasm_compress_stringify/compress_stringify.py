@@ -6,6 +6,7 @@ from typing import Dict, Tuple, Optional, List, Any
 from itkwasm import (
     environment_dispatch,
     BinaryStream,
+    BinaryFile,
 )
 
 def compress_stringify(
@@ -13,6 +14,12 @@ def compress_stringify(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    prefilter: str = "none",
+    element_size: int = 1,
+    row_length: int = 1,
+    dictionary: Optional[os.PathLike] = None,
+    train_dictionary: str = "",
+    dictionary_size: int = 112640,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -28,9 +35,27 @@ def compress_stringify(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param prefilter: Prefilter applied before compression: none, shuffle, delta, or delta-shuffle
+    :type  prefilter: str
+
+    :param element_size: Size in bytes of the elements shuffled and delta coded by the prefilter, e.g. 2 for 16-bit pixels
+    :type  element_size: int
+
+    :param row_length: Number of elements per row for the delta prefilter, e.g. the image width times the number of components
+    :type  row_length: int
+
+    :param dictionary: Dictionary trained with --train-dictionary, improves the compression of small inputs
+    :type  dictionary: os.PathLike
+
+    :param train_dictionary: Train a dictionary on the files in this directory and output it instead of compressing the input
+    :type  train_dictionary: str
+
+    :param dictionary_size: Maximum size of the trained dictionary in bytes
+    :type  dictionary_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
     func = environment_dispatch("itkwasm_compress_stringify", "compress_stringify")
-    output = func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix)
+    output = func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix, prefilter=prefilter, element_size=element_size, row_length=row_length, dictionary=dictionary, train_dictionary=train_dictionary, dictionary_size=dictionary_size)
     return output
@@ -6,11 +6,13 @@ from typing import Dict, Tuple, Optional, List, Any
 from itkwasm import (
     environment_dispatch,
     BinaryStream,
+    BinaryFile,
 )
 
 def parse_string_decompress(
     input: bytes,
     parse_string: bool = False,
+    dictionary: Optional[os.PathLike] = None,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -20,9 +22,12 @@ def parse_string_decompress(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param dictionary: Dictionary the input was compressed with
+    :type  dictionary: os.PathLike
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
     func = environment_dispatch("itkwasm_compress_stringify", "parse_string_decompress")
-    output = func(input, parse_string=parse_string)
+    output = func(input, parse_string=parse_string, dictionary=dictionary)
     return output
@@ -1,5 +1,7 @@
 // Generated file. To retain edits, remove this comment.
 
+import { BinaryFile } from 'itk-wasm'
+
 interface CompressStringifyNodeOptions {
   /** Stringify the output */
   stringify?: boolean
@@ -10,6 +12,24 @@ interface CompressStringifyNodeOptions {
   /** dataURL prefix */
   dataUrlPrefix?: string
 
+  /** Prefilter applied before compression: none, shuffle, delta, or delta-shuffle */
+  prefilter?: string
+
+  /** Size in bytes of the elements shuffled and delta coded by the prefilter, e.g. 2 for 16-bit pixels */
+  elementSize?: number
+
+  /** Number of elements per row for the delta prefilter, e.g. the image width times the number of components */
+  rowLength?: number
+
+  /** Dictionary trained with --train-dictionary, improves the compression of small inputs */
+  dictionary?: string | File | BinaryFile
+
+  /** Train a dictionary on the files in this directory and output it instead of compressing the input */
+  trainDictionary?: string
+
+  /** Maximum size of the trained dictionary in bytes */
+  dictionarySize?: number
+
 }
 
 export default CompressStringifyNodeOptions
@@ -1,11 +1,14 @@
 // Generated file. To retain edits, remove this comment.
 
-import { WorkerPoolFunctionOption } from 'itk-wasm'
+import { BinaryFile, WorkerPoolFunctionOption } from 'itk-wasm'
 
 interface ParseStringDecompressOptions extends WorkerPoolFunctionOption {
   /** Parse the input string before decompression */
   parseString?: boolean
 
+  /** Dictionary the input was compressed with */
+  dictionary?: string | File | BinaryFile
+
 }
 
 export default ParseStringDecompressOptions
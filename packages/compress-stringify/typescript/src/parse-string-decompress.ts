@@ -2,6 +2,7 @@
 
 import {
   BinaryStream,
+  BinaryFile,
   InterfaceTypes,
   PipelineOutput,
   PipelineInput,
@@ -51,6 +52,20 @@ async function parseStringDecompress(
   if (options.parseString) {
     options.parseString && args.push('--parse-string')
   }
+  if (options.dictionary) {
+    const dictionary = options.dictionary
+    let dictionaryFile = dictionary
+    if (dictionary instanceof File) {
+      const dictionaryBuffer = await dictionary.arrayBuffer()
+      dictionaryFile = { path: dictionary.name, data: new Uint8Array(dictionaryBuffer) }
+    }
+    args.push('--dictionary')
+
+    inputs.push({ type: InterfaceTypes.BinaryFile, data: dictionaryFile as BinaryFile })
+    const name = dictionary instanceof File ? dictionary.name : (dictionary as BinaryFile).path
+    args.push(name)
+
+  }
 
   const pipelinePath = 'parse-string-decompress'
 
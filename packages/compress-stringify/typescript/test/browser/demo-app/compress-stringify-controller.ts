@@ -65,6 +65,43 @@ class CompressStringifyController {
         model.options.set("dataUrlPrefix", dataUrlPrefixElement.value)
     })
 
+    const prefilterElement = document.querySelector('#compressStringifyInputs sl-input[name=prefilter]')
+    prefilterElement.addEventListener('sl-change', (event) => {
+        model.options.set("prefilter", prefilterElement.value)
+    })
+
+    const elementSizeElement = document.querySelector('#compressStringifyInputs sl-input[name=element-size]')
+    elementSizeElement.addEventListener('sl-change', (event) => {
+        model.options.set("elementSize", parseInt(elementSizeElement.value))
+    })
+
+    const rowLengthElement = document.querySelector('#compressStringifyInputs sl-input[name=row-length]')
+    rowLengthElement.addEventListener('sl-change', (event) => {
+        model.options.set("rowLength", parseInt(rowLengthElement.value))
+    })
+
+    const dictionaryElement = document.querySelector('#compressStringifyInputs input[name=dictionary-file]')
+    dictionaryElement.addEventListener('change', async (event) => {
+        const dataTransfer = event.dataTransfer
+        const files = event.target.files || dataTransfer.files
+
+        const arrayBuffer = await files[0].arrayBuffer()
+        model.options.set("dictionary", { data: new Uint8Array(arrayBuffer), path: files[0].name })
+        const details = document.getElementById("compressStringify-dictionary-details")
+        details.innerHTML = `<pre>${globalThis.escapeHtml(model.options.get("dictionary").data.subarray(0, 50).toString() + ' ...')}</pre>`
+        details.disabled = false
+    })
+
+    const trainDictionaryElement = document.querySelector('#compressStringifyInputs sl-input[name=train-dictionary]')
+    trainDictionaryElement.addEventListener('sl-change', (event) => {
+        model.options.set("trainDictionary", trainDictionaryElement.value)
+    })
+
+    const dictionarySizeElement = document.querySelector('#compressStringifyInputs sl-input[name=dictionary-size]')
+    dictionarySizeElement.addEventListener('sl-change', (event) => {
+        model.options.set("dictionarySize", parseInt(dictionarySizeElement.value))
+    })
+
     // ----------------------------------------------
     // Outputs
     const outputOutputDownload = document.querySelector('#compressStringifyOutputs sl-button[name=output-download]')
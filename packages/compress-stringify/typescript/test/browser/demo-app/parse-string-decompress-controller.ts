@@ -55,6 +55,18 @@ class ParseStringDecompressController {
         model.options.set("parseString", parseStringElement.checked)
     })
 
+    const dictionaryElement = document.querySelector('#parseStringDecompressInputs input[name=dictionary-file]')
+    dictionaryElement.addEventListener('change', async (event) => {
+        const dataTransfer = event.dataTransfer
+        const files = event.target.files || dataTransfer.files
+
+        const arrayBuffer = await files[0].arrayBuffer()
+        model.options.set("dictionary", { data: new Uint8Array(arrayBuffer), path: files[0].name })
+        const details = document.getElementById("parseStringDecompress-dictionary-details")
+        details.innerHTML = `<pre>${globalThis.escapeHtml(model.options.get("dictionary").data.subarray(0, 50).toString() + ' ...')}</pre>`
+        details.disabled = false
+    })
+
     // ----------------------------------------------
     // Outputs
     const outputOutputDownload = document.querySelector('#parseStringDecompressOutputs sl-button[name=output-download]')
@@ -0,0 +1,115 @@
+import struct
+from typing import Any, Dict, List
+
+from .float_types import FloatTypes
+from .int_types import IntTypes
+from .pixel_types import PixelTypes
+
+# Binary descriptors store enumerations as their value in the C++ enum
+_component_types = [str(t) for t in IntTypes] + [str(t) for t in FloatTypes]
+_int_types = [str(t) for t in IntTypes]
+_float_types = [str(t) for t in FloatTypes]
+_pixel_types = [str(t) for t in PixelTypes]
+
+_enumerations: Dict[str, List[str]] = {
+    "componentType": _component_types,
+    "pointPixelComponentType": _component_types,
+    "cellPixelComponentType": _component_types,
+    "pointComponentType": _float_types,
+    "cellComponentType": _int_types,
+    "pixelType": _pixel_types,
+    "pointPixelType": _pixel_types,
+    "cellPixelType": _pixel_types,
+}
+
+_number_formats = {
+    (0, 4): "<f",
+    (0, 8): "<d",
+    (1, 1): "<b",
+    (1, 2): "<h",
+    (1, 4): "<i",
+    (1, 8): "<q",
+    (2, 1): "<B",
+    (2, 2): "<H",
+    (2, 4): "<I",
+    (2, 8): "<Q",
+}
+
+
+class _BeveReader:
+    def __init__(self, data: bytes):
+        self._data = data
+        self._offset = 0
+
+    def read_size(self) -> int:
+        # Sizes use their two low bits for their byte count
+        byte_count = 1 << (self._data[self._offset] & 0b11)
+        size = int.from_bytes(self._data[self._offset : self._offset + byte_count], "little") >> 2
+        self._offset += byte_count
+        return size
+
+    def read_string(self) -> str:
+        size = self.read_size()
+        value = self._data[self._offset : self._offset + size].decode()
+        self._offset += size
+        return value
+
+    def read_number(self, number_type: int, byte_count: int):
+        number_format = _number_formats.get((number_type, byte_count))
+        if number_format is None:
+            raise ValueError(f"Unsupported binary descriptor number: type {number_type}, {byte_count} bytes")
+        (value,) = struct.unpack_from(number_format, self._data, self._offset)
+        self._offset += byte_count
+        return value
+
+    def read_value(self) -> Any:
+        header = self._data[self._offset]
+        self._offset += 1
+        value_type = header & 0b111
+        if value_type == 0:
+            # null, or a boolean with its value in bit 4
+            return None if header == 0 else bool(header & 0b10000)
+        if value_type == 1:
+            return self.read_number((header >> 3) & 0b11, 1 << (header >> 5))
+        if value_type == 2:
+            return self.read_string()
+        if value_type == 3:
+            key_type = (header >> 3) & 0b11
+            size = self.read_size()
+            result = {}
+            for _ in range(size):
+                if key_type == 0:
+                    key = self.read_string()
+                else:
+                    key = str(self.read_number(key_type, 1 << (header >> 5)))
+                value = self.read_value()
+                enumeration = _enumerations.get(key)
+                if enumeration is not None and isinstance(value, int) and not isinstance(value, bool):
+                    value = enumeration[value]
+                result[key] = value
+            return result
+        if value_type == 4:
+            number_type = (header >> 3) & 0b11
+            size = self.read_size()
+            if number_type == 3:
+                if header & 0b100000:
+                    return [self.read_string() for _ in range(size)]
+                # Booleans are packed eight per byte
+                packed = self._data[self._offset : self._offset + (size + 7) // 8]
+                self._offset += len(packed)
+                return [bool(packed[ii >> 3] & (1 << (ii & 7))) for ii in range(size)]
+            byte_count = 1 << (header >> 5)
+            return [self.read_number(number_type, byte_count) for _ in range(size)]
+        if value_type == 5:
+            size = self.read_size()
+            return [self.read_value() for _ in range(size)]
+        if value_type == 6 and header >> 3 == 1:
+            # Variants are a type tag extension: the alternative index, then the value
+            self.read_size()
+            return self.read_value()
+        raise ValueError(f"Unsupported binary descriptor header: {header}")
+
+
+def read_binary_descriptor(data: bytes) -> Any:
+    """Decode a binary (BEVE) interface object descriptor into the object its JSON descriptor would parse to."""
+    return _BeveReader(data).read_value()
@@ -1,10 +1,11 @@
 import json
 from pathlib import Path, PurePosixPath
 from dataclasses import asdict
-from typing import List, Union, Dict, Tuple, Set
+from typing import Callable, List, Optional, Union, Dict, Tuple, Set
 import ctypes
 import sys
 import os
+import threading
 
 import numpy as np
 
@@ -26,6 +27,7 @@ from .polydata import PolyData
 from .json_compatible import JsonCompatible
 from .int_types import IntTypes
 from .float_types import FloatTypes
+from .binary_descriptor import read_binary_descriptor
 from .to_numpy_array import (
     buffer_to_numpy_array,
     array_like_to_numpy_array,
@@ -53,6 +55,34 @@ if sys.platform != "emscripten":
     _module_store_dir.mkdir(parents=True, exist_ok=True)
 
 
+# Bit of itk_wasm_descriptor_encodings for array addresses as integers
+_integer_address_descriptors = 1
+
+# Seconds between reads of the status block of a running pipeline
+_status_poll_interval = 0.05
+
+
+def _monitor_status(
+    status: Tuple[ctypes.c_float, ctypes.c_uint32],
+    progress: Optional[Callable[[float], None]],
+    abort: Optional[threading.Event],
+    finished: threading.Event,
+) -> None:
+    """Report the progress of a running pipeline and forward an abort request."""
+    progress_value, abort_flag = status
+    last_progress = None
+    while True:
+        done = finished.is_set()
+        if abort is not None and abort.is_set():
+            abort_flag.value = 1
+        if progress is not None and progress_value.value != last_progress:
+            last_progress = progress_value.value
+            progress(last_progress)
+        if done:
+            return
+        finished.wait(_status_poll_interval)
+
+
 def array_like_to_bytes(arr: ArrayLike) -> bytes:
     """Convert a numpy array-like to bytes."""
     if hasattr(arr, "tobytes"):
@@ -96,10 +126,21 @@ class RunInstance:
         self._output_array_size = instance.exports(store)["itk_wasm_output_array_size"]
         self._output_json_address = instance.exports(store)["itk_wasm_output_json_address"]
         self._output_json_size = instance.exports(store)["itk_wasm_output_json_size"]
+        # Not exported by modules built before host-provided output buffers
+        self._output_array_alloc = instance.exports(store).get("itk_wasm_output_array_alloc")
+        self._output_metadata_address = instance.exports(store).get("itk_wasm_output_metadata_address")
+        self._output_metadata_size = instance.exports(store).get("itk_wasm_output_metadata_size")
+        # Not exported by modules built before per-slot release
+        self._output_release = instance.exports(store).get("itk_wasm_output_release")
+        # Not exported by modules built before the progress status block
+        self._progress_address = instance.exports(store).get("itk_wasm_progress_address")
 
         _initialize = instance.exports(store)["_initialize"]
         _initialize(store)
 
+        descriptor_encodings = instance.exports(store).get("itk_wasm_descriptor_encodings")
+        self.descriptor_encodings = 0 if descriptor_encodings is None else descriptor_encodings(store)
+
     def wasmtime_lift(self, ptr: int, size: int):
         ptr = ptr & 0xFFFFFFFF
         size = size & 0xFFFFFFFF
@@ -130,19 +171,56 @@ class RunInstance:
         json_ptr = self._input_json_alloc(self._store, 0, input_index, len(data_json))
         self.wasmtime_lower(json_ptr, data_json)
 
-    def get_output_json(self, output_index: int) -> Dict:
+    def set_output_array_buffer(self, output_index: int, output_sub_index: int, size: int) -> int:
+        if self._output_array_alloc is None:
+            return 0
+        return self._output_array_alloc(self._store, 0, output_index, output_sub_index, size)
+
+    def array_address(self, ptr: int) -> Union[int, str]:
+        if self.descriptor_encodings & _integer_address_descriptors:
+            return ptr
+        return f"data:application/vnd.itk.address,0:{ptr}"
+
+    def get_output_json(self, output_index: int, binary_descriptor: bool = False) -> Dict:
         json_ptr = self._output_json_address(self._store, 0, output_index)
         json_len = self._output_json_size(self._store, 0, output_index)
+        if binary_descriptor:
+            return read_binary_descriptor(self.wasmtime_lift(json_ptr, json_len))
         json_str = self.wasmtime_lift(json_ptr, json_len).decode()
         json_result = json.loads(json_str)
         return json_result
 
+    def get_output_metadata(self, output_index: int) -> List:
+        metadata_ptr = self._output_metadata_address(self._store, 0, output_index)
+        metadata_len = self._output_metadata_size(self._store, 0, output_index)
+        metadata_str = self.wasmtime_lift(metadata_ptr, metadata_len).decode()
+        return json.loads(metadata_str)
+
+    def release_output(self, output_index: int) -> None:
+        # Modules without itk_wasm_output_release hold their outputs until
+        # the instance is dropped
+        if self._output_release is not None:
+            self._output_release(self._store, 0, output_index)
+
     def get_output_array_address(self, memory: int, output_index: int, output_sub_index: int) -> Dict:
         return self._output_array_address(self._store, memory, output_index, output_sub_index)
 
     def get_output_array_size(self, memory: int, output_index: int, output_sub_index: int) -> Dict:
         return self._output_array_size(self._store, memory, output_index, output_sub_index)
 
+    def status_block(self) -> Optional[Tuple[ctypes.c_float, ctypes.c_uint32]]:
+        """Progress and abort fields of the status block, or None.
+
+        They are accessed from another thread while the pipeline runs, so only
+        32-bit memories are supported: their base address does not move as
+        they grow."""
+        if self._progress_address is None or self._memory.type(self._store).is_64:
+            return None
+        address = self._progress_address(self._store) & 0xFFFFFFFF
+        raw_base = self._memory.data_ptr(self._store)
+        base = ctypes.addressof(raw_base.contents) + address
+        return ctypes.c_float.from_address(base), ctypes.c_uint32.from_address(base + 4)
+
     def delayed_start(self):
         func = self._instance.exports(self._store)["itk_wasm_delayed_start"]
         return_code = func(self._store)
@@ -184,14 +262,25 @@ class Pipeline:
             self.module = Module(self.engine, wasm_bytes)
             with module_cache.open("wb") as fp:
                 fp.write(self.module.serialize())
+        # Modules that export itk_wasm_descriptor_encodings can write binary
+        # output descriptors
+        self._binary_descriptors = any(
+            export.name == "itk_wasm_descriptor_encodings" for export in self.module.exports
+        )
 
     def run(
         self,
         args: List[str],
         outputs: List[PipelineOutput] = [],
         inputs: List[PipelineInput] = [],
+        progress: Optional[Callable[[float], None]] = None,
+        abort: Optional[threading.Event] = None,
     ) -> Tuple[PipelineOutput]:
-        """Run the itk-wasm pipeline."""
+        """Run the itk-wasm pipeline.
+
+        progress is called from another thread with the progress, in [0, 1],
+        of the processes the pipeline observes. Setting abort stops them, and
+        the pipeline fails."""
 
         preopen_directories = set()
         for index, input_ in enumerate(inputs):
@@ -202,7 +291,14 @@ class Pipeline:
                 preopen_directories.add(str(PurePosixPath(output.data.path).parent))
         preopen_directories = list(preopen_directories)
 
-        ri = RunInstance(self.engine, self.linker, self.module, args, preopen_directories)
+        # Output descriptors are decoded without formatting or escaping when the
+        # module can write them in the binary encoding
+        binary_descriptors = self._binary_descriptors and "--memory-io" in args
+        pipeline_args = list(args)
+        if binary_descriptors and "--binary-descriptors" not in pipeline_args:
+            pipeline_args.append("--binary-descriptors")
+
+        ri = RunInstance(self.engine, self.linker, self.module, pipeline_args, preopen_directories)
 
         for index, input_ in enumerate(inputs):
             if input_.type == InterfaceTypes.TextStream:
@@ -210,7 +306,7 @@ class Pipeline:
                 array_ptr = ri.set_input_array(data_array, index, 0)
                 data_json = {
                     "size": len(data_array),
-                    "data": f"data:application/vnd.itk.address,0:{array_ptr}",
+                    "data": ri.array_address(array_ptr),
                 }
                 ri.set_input_json(data_json, index)
             elif input_.type == InterfaceTypes.BinaryStream:
@@ -218,7 +314,7 @@ class Pipeline:
                 array_ptr = ri.set_input_array(data_array, index, 0)
                 data_json = {
                     "size": len(data_array),
-                    "data": f"data:application/vnd.itk.address,0:{array_ptr}",
+                    "data": ri.array_address(array_ptr),
                 }
                 ri.set_input_json(data_json, index)
             elif input_.type == InterfaceTypes.TextFile:
@@ -236,9 +332,9 @@ class Pipeline:
                     "name": image.name,
                     "origin": image.origin,
                     "spacing": image.spacing,
-                    "direction": f"data:application/vnd.itk.address,0:{direction_ptr}",
+                    "direction": ri.array_address(direction_ptr),
                     "size": image.size,
-                    "data": f"data:application/vnd.itk.address,0:{data_ptr}",
+                    "data": ri.array_address(data_ptr),
                 }
                 ri.set_input_json(image_json, index)
             elif input_.type == InterfaceTypes.Mesh:
@@ -267,14 +363,14 @@ class Pipeline:
                     "meshType": asdict(mesh.meshType),
                     "name": mesh.name,
                     "numberOfPoints": mesh.numberOfPoints,
-                    "points": f"data:application/vnd.itk.address,0:{points_ptr}",
+                    "points": ri.array_address(points_ptr),
                     "numberOfCells": mesh.numberOfCells,
-                    "cells": f"data:application/vnd.itk.address,0:{cells_ptr}",
+                    "cells": ri.array_address(cells_ptr),
                     "cellBufferSize": mesh.cellBufferSize,
                     "numberOfPointPixels": mesh.numberOfPointPixels,
-                    "pointData": f"data:application/vnd.itk.address,0:{point_data_ptr}",
+                    "pointData": ri.array_address(point_data_ptr),
                     "numberOfCellPixels": mesh.numberOfCellPixels,
-                    "cellData": f"data:application/vnd.itk.address,0:{cell_data_ptr}",
+                    "cellData": ri.array_address(cell_data_ptr),
                 }
                 ri.set_input_json(mesh_json, index)
             elif input_.type == InterfaceTypes.PolyData:
@@ -325,19 +421,19 @@ class Pipeline:
                     "polyDataType": asdict(polydata.polyDataType),
                     "name": polydata.name,
                     "numberOfPoints": polydata.numberOfPoints,
-                    "points": f"data:application/vnd.itk.address,0:{points_ptr}",
+                    "points": ri.array_address(points_ptr),
                     "verticesBufferSize": polydata.verticesBufferSize,
-                    "vertices": f"data:application/vnd.itk.address,0:{vertices_ptr}",
+                    "vertices": ri.array_address(vertices_ptr),
                     "linesBufferSize": polydata.linesBufferSize,
-                    "lines": f"data:application/vnd.itk.address,0:{lines_ptr}",
+                    "lines": ri.array_address(lines_ptr),
                     "polygonsBufferSize": polydata.polygonsBufferSize,
-                    "polygons": f"data:application/vnd.itk.address,0:{polygons_ptr}",
+                    "polygons": ri.array_address(polygons_ptr),
                     "triangleStripsBufferSize": polydata.triangleStripsBufferSize,
-                    "triangleStrips": f"data:application/vnd.itk.address,0:{triangleStrips_ptr}",
+                    "triangleStrips": ri.array_address(triangleStrips_ptr),
                     "numberOfPointPixels": polydata.numberOfPointPixels,
-                    "pointData": f"data:application/vnd.itk.address,0:{pointData_ptr}",
+                    "pointData": ri.array_address(pointData_ptr),
                     "numberOfCellPixels": polydata.numberOfCellPixels,
-                    "cellData": f"data:application/vnd.itk.address,0:{cellData_ptr}",
+                    "cellData": ri.array_address(cellData_ptr),
                 }
                 ri.set_input_json(polydata_json, index)
             elif input_.type == InterfaceTypes.JsonCompatible:
@@ -345,13 +441,31 @@ class Pipeline:
                 array_ptr = ri.set_input_array(data_array, index, 0)
                 data_json = {
                     "size": len(data_array),
-                    "data": f"data:application/vnd.itk.address,0:{array_ptr}",
+                    "data": ri.array_address(array_ptr),
                 }
                 ri.set_input_json(data_json, index)
             else:
                 raise ValueError(f"Unexpected/not yet supported input.type {input_.type}")
 
-        return_code = ri.delayed_start()
+        for index, output in enumerate(outputs):
+            if output.type == InterfaceTypes.Image and output.buffer_size:
+                ri.set_output_array_buffer(index, 0, output.buffer_size)
+
+        status = ri.status_block() if progress is not None or abort is not None else None
+        finished = threading.Event()
+        monitor = None
+        if status is not None:
+            monitor = threading.Thread(target=_monitor_status, args=(status, progress, abort, finished), daemon=True)
+            monitor.start()
+        try:
+            return_code = ri.delayed_start()
+        finally:
+            finished.set()
+            if monitor is not None:
+                monitor.join()
+
+        # With --lazy-metadata, output descriptors are written without metadata
+        lazy_metadata = "--lazy-metadata" in args
 
         populated_outputs: List[PipelineOutput] = []
         if len(outputs) and return_code == 0:
@@ -372,9 +486,11 @@ class Pipeline:
                 elif output.type == InterfaceTypes.BinaryFile:
                     output_data = PipelineOutput(InterfaceTypes.BinaryFile, BinaryFile(output.data.path))
                 elif output.type == InterfaceTypes.Image:
-                    image_json = ri.get_output_json(index)
+                    image_json = ri.get_output_json(index, binary_descriptors)
 
                     image = Image(**image_json)
+                    if lazy_metadata and output.read_metadata:
+                        image.metadata = ri.get_output_metadata(index)
 
                     data_ptr = ri.get_output_array_address(0, index, 0)
                     data_size = ri.get_output_array_size(0, index, 0)
@@ -399,8 +515,10 @@ class Pipeline:
 
                     output_data = PipelineOutput(InterfaceTypes.Image, image)
                 elif output.type == InterfaceTypes.Mesh:
-                    mesh_json = ri.get_output_json(index)
+                    mesh_json = ri.get_output_json(index, binary_descriptors)
                     mesh = Mesh(**mesh_json)
+                    if lazy_metadata and output.read_metadata:
+                        mesh.metadata = ri.get_output_metadata(index)
 
                     if mesh.numberOfPoints > 0:
                         data_ptr = ri.get_output_array_address(0, index, 0)
@@ -443,7 +561,7 @@ class Pipeline:
 
                     output_data = PipelineOutput(InterfaceTypes.Mesh, mesh)
                 elif output.type == InterfaceTypes.PolyData:
-                    polydata_json = ri.get_output_json(index)
+                    polydata_json = ri.get_output_json(index, binary_descriptors)
                     polydata = PolyData(**polydata_json)
 
                     if polydata.numberOfPoints > 0:
@@ -522,6 +640,10 @@ class Pipeline:
                 else:
                     raise ValueError(f"Unexpected/not yet supported output.type {output.type}")
 
+                # The output has been copied out of the module memory, free it
+                # before the next output is copied so peak memory is one output
+                # at a time
+                ri.release_output(index)
                 populated_outputs.append(output_data)
 
         ri.delayed_exit(return_code)
@@ -28,3 +28,9 @@ class PipelineOutput:
         ]
     ] = None
     path: Optional[str] = None
+    # Size in bytes of a buffer the host pre-allocates for the output image
+    # pixel data, which pipelines that opt in write into in place
+    buffer_size: Optional[int] = None
+    # When the pipeline runs with --lazy-metadata, the image or mesh metadata
+    # is only serialized when the host reads it
+    read_metadata: bool = True
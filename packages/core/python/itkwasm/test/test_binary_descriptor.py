@@ -0,0 +1,55 @@
+import struct
+
+from itkwasm.binary_descriptor import read_binary_descriptor
+
+
+def _size(value: int) -> bytes:
+    return bytes([value << 2])
+
+
+def _string(value: str) -> bytes:
+    return b"\x02" + _size(len(value)) + value.encode()
+
+
+def _key(value: str) -> bytes:
+    return _size(len(value)) + value.encode()
+
+
+def _uint32(value: int) -> bytes:
+    return b"\x51" + struct.pack("<I", value)
+
+
+def _uint64(value: int) -> bytes:
+    return b"\x71" + struct.pack("<Q", value)
+
+
+def test_read_binary_descriptor():
+    image_type = b"\x03" + _size(4)
+    image_type += _key("dimension") + _uint32(2)
+    image_type += _key("componentType") + _uint32(8)
+    image_type += _key("pixelType") + _uint32(1)
+    image_type += _key("components") + _uint32(1)
+
+    metadata_entry = b"\x05" + _size(2) + _string("key") + b"\x0e" + _size(2) + _string("value")
+
+    descriptor = b"\x03" + _size(6)
+    descriptor += _key("imageType") + image_type
+    descriptor += _key("name") + _string("Image")
+    descriptor += _key("origin") + b"\x64" + _size(2) + struct.pack("<2d", 0.5, -1.0)
+    descriptor += _key("direction") + b"\x0e" + _size(0) + _uint64(1024)
+    descriptor += _key("size") + b"\x74" + _size(2) + struct.pack("<2Q", 4, 5)
+    descriptor += _key("metadata") + b"\x05" + _size(1) + metadata_entry
+
+    assert read_binary_descriptor(descriptor) == {
+        "imageType": {
+            "dimension": 2,
+            "componentType": "float32",
+            "pixelType": "Scalar",
+            "components": 1,
+        },
+        "name": "Image",
+        "origin": [0.5, -1.0],
+        "direction": 1024,
+        "size": [4, 5],
+        "metadata": [["key", "value"]],
+    }
@@ -2,6 +2,7 @@ from pathlib import Path, PurePosixPath
 import tempfile
 from dataclasses import asdict
 import sys
+import threading
 
 import pytest
 
@@ -80,6 +81,43 @@ def test_pipeline_input_output_streams():
     assert outputs[1].data.data[3], 239
 
 
+def test_pipeline_progress_abort():
+    pipeline = Pipeline(test_input_dir / "input-output-files-test.wasi.wasm")
+
+    pipeline_inputs = [
+        PipelineInput(InterfaceTypes.TextStream, TextStream("The answer is 42.")),
+        PipelineInput(InterfaceTypes.BinaryStream, BinaryStream(bytes([222, 173, 190, 239]))),
+    ]
+
+    pipeline_outputs = [
+        PipelineOutput(InterfaceTypes.TextStream),
+        PipelineOutput(InterfaceTypes.BinaryStream),
+    ]
+
+    args = [
+        "--memory-io",
+        "--input-text-stream",
+        "0",
+        "--input-binary-stream",
+        "1",
+        "--output-text-stream",
+        "0",
+        "--output-binary-stream",
+        "1",
+    ]
+
+    progress = []
+    outputs = pipeline.run(args, pipeline_outputs, pipeline_inputs, progress=progress.append)
+    assert all(0.0 <= value <= 1.0 for value in progress)
+    assert outputs[0].data.data == "The answer is 42."
+
+    # The pipeline does not observe a process, so an abort request has nothing to stop
+    abort = threading.Event()
+    abort.set()
+    outputs = pipeline.run(args, pipeline_outputs, pipeline_inputs, abort=abort)
+    assert outputs[0].data.data == "The answer is 42."
+
+
 @pytest.mark.skipif(
     sys.platform == "win32",
     reason="Windows tempfile resource, https://github.com/bytecodealliance/wasmtime-py/issues/132",
@@ -1,4 +1,5 @@
 import MeshType from './mesh-type.js'
+import Metadata from './metadata.js'
 import type TypedArray from '../typed-array.js'
 
 class Mesh {
@@ -17,6 +18,8 @@ class Mesh {
   numberOfCellPixels: number
   cellData: null | TypedArray
 
+  metadata: Metadata
+
   constructor (public readonly meshType = new MeshType()) {
     this.name = 'Mesh'
 
@@ -32,6 +35,8 @@ class Mesh {
 
     this.numberOfCellPixels = 0
     this.cellData = null
+
+    this.metadata = new Map()
   }
 }
 
@@ -0,0 +1,178 @@
+import FloatTypes from '../../interface-types/float-types.js'
+import IntTypes from '../../interface-types/int-types.js'
+import PixelTypes from '../../interface-types/pixel-types.js'
+
+// Binary descriptors store enumerations as their value in the C++ enum
+const componentTypes = [
+  IntTypes.Int8,
+  IntTypes.UInt8,
+  IntTypes.Int16,
+  IntTypes.UInt16,
+  IntTypes.Int32,
+  IntTypes.UInt32,
+  IntTypes.Int64,
+  IntTypes.UInt64,
+  FloatTypes.Float32,
+  FloatTypes.Float64
+]
+const intTypes = componentTypes.slice(0, 8)
+const floatTypes = [FloatTypes.Float32, FloatTypes.Float64]
+const pixelTypes = Object.values(PixelTypes)
+
+const enumerations: Record<string, readonly string[]> = {
+  componentType: componentTypes,
+  pointPixelComponentType: componentTypes,
+  cellPixelComponentType: componentTypes,
+  pointComponentType: floatTypes,
+  cellComponentType: intTypes,
+  pixelType: pixelTypes,
+  pointPixelType: pixelTypes,
+  cellPixelType: pixelTypes
+}
+
+const decoder = new TextDecoder('utf-8')
+
+class BeveReader {
+  private offset = 0
+  private readonly view: DataView
+
+  constructor (private readonly bytes: Uint8Array) {
+    this.view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength)
+  }
+
+  // Sizes use their two low bits for their byte count
+  readSize (): number {
+    const byteCount = 1 << (this.bytes[this.offset] & 0b11)
+    let size = 0
+    switch (byteCount) {
+      case 1:
+        size = this.view.getUint8(this.offset) >>> 2
+        break
+      case 2:
+        size = this.view.getUint16(this.offset, true) >>> 2
+        break
+      case 4:
+        size = this.view.getUint32(this.offset, true) >>> 2
+        break
+      default:
+        size = Number(this.view.getBigUint64(this.offset, true) >> 2n)
+    }
+    this.offset += byteCount
+    return size
+  }
+
+  readString (): string {
+    const size = this.readSize()
+    const value = decoder.decode(this.bytes.subarray(this.offset, this.offset + size))
+    this.offset += size
+    return value
+  }
+
+  readNumber (numberType: number, byteCount: number): number {
+    const offset = this.offset
+    this.offset += byteCount
+    if (numberType === 0) {
+      switch (byteCount) {
+        case 4:
+          return this.view.getFloat32(offset, true)
+        case 8:
+          return this.view.getFloat64(offset, true)
+      }
+    } else if (numberType === 1) {
+      switch (byteCount) {
+        case 1:
+          return this.view.getInt8(offset)
+        case 2:
+          return this.view.getInt16(offset, true)
+        case 4:
+          return this.view.getInt32(offset, true)
+        case 8:
+          return Number(this.view.getBigInt64(offset, true))
+      }
+    } else if (numberType === 2) {
+      switch (byteCount) {
+        case 1:
+          return this.view.getUint8(offset)
+        case 2:
+          return this.view.getUint16(offset, true)
+        case 4:
+          return this.view.getUint32(offset, true)
+        case 8:
+          return Number(this.view.getBigUint64(offset, true))
+      }
+    }
+    throw new Error(`Unsupported binary descriptor number: type ${numberType}, ${byteCount} bytes`)
+  }
+
+  readValue (): any {
+    const header = this.bytes[this.offset++]
+    switch (header & 0b111) {
+      case 0:
+        // null, or a boolean with its value in bit 4
+        return header === 0 ? null : (header & 0b10000) !== 0
+      case 1:
+        return this.readNumber((header >> 3) & 0b11, 1 << (header >> 5))
+      case 2:
+        return this.readString()
+      case 3: {
+        const keyType = (header >> 3) & 0b11
+        const size = this.readSize()
+        const object: Record<string, any> = {}
+        for (let ii = 0; ii < size; ii++) {
+          const key = keyType === 0 ? this.readString() : String(this.readNumber(keyType, 1 << (header >> 5)))
+          const value = this.readValue()
+          const enumeration = enumerations[key]
+          object[key] = enumeration !== undefined && typeof value === 'number' ? enumeration[value] : value
+        }
+        return object
+      }
+      case 4: {
+        const numberType = (header >> 3) & 0b11
+        const size = this.readSize()
+        const array: any[] = new Array(size)
+        if (numberType === 3) {
+          if ((header & 0b100000) !== 0) {
+            for (let ii = 0; ii < size; ii++) {
+              array[ii] = this.readString()
+            }
+          } else {
+            // Booleans are packed eight per byte
+            for (let ii = 0; ii < size; ii++) {
+              array[ii] = (this.bytes[this.offset + (ii >> 3)] & (1 << (ii & 7))) !== 0
+            }
+            this.offset += Math.ceil(size / 8)
+          }
+          return array
+        }
+        const byteCount = 1 << (header >> 5)
+        for (let ii = 0; ii < size; ii++) {
+          array[ii] = this.readNumber(numberType, byteCount)
+        }
+        return array
+      }
+      case 5: {
+        const size = this.readSize()
+        const array: any[] = new Array(size)
+        for (let ii = 0; ii < size; ii++) {
+          array[ii] = this.readValue()
+        }
+        return array
+      }
+      case 6:
+        // Variants are a type tag extension: the alternative index, then the value
+        if (header >> 3 === 1) {
+          this.readSize()
+          return this.readValue()
+        }
+    }
+    throw new Error(`Unsupported binary descriptor header: ${header}`)
+  }
+}
+
+/** Decode a binary (BEVE) interface object descriptor into the object its
+ * JSON descriptor would parse to. */
+function readBinaryDescriptor (bytes: Uint8Array): any {
+  return new BeveReader(bytes).readValue()
+}
+
+export default readBinaryDescriptor
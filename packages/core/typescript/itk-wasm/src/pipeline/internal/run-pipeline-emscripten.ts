@@ -15,11 +15,16 @@ import PipelineEmscriptenModule from '../pipeline-emscripten-module.js'
 import PipelineInput from '../pipeline-input.js'
 import PipelineOutput from '../pipeline-output.js'
 import RunPipelineResult from '../run-pipeline-result.js'
+import readBinaryDescriptor from './read-binary-descriptor.js'
 
 const haveSharedArrayBuffer = typeof globalThis.SharedArrayBuffer === 'function'
 const encoder = new TextEncoder()
 const decoder = new TextDecoder('utf-8')
 
+// Bits of itk_wasm_descriptor_encodings
+const integerAddressDescriptors = 1
+const binaryOutputDescriptors = 2
+
 function readFileSharedArray (
   emscriptenModule: PipelineEmscriptenModule,
   path: string
@@ -96,6 +101,25 @@ function setPipelineModuleInputJSON (
   emscriptenModule.stringToUTF8(dataJSON, jsonPtr, length)
 }
 
+function setPipelineModuleOutputBuffer (
+  emscriptenModule: PipelineEmscriptenModule,
+  byteLength: number,
+  outputIndex: number,
+  subIndex: number
+): void {
+  // Modules built before itk_wasm_output_array_alloc was exported allocate
+  // their outputs themselves
+  if (typeof (emscriptenModule as any)._itk_wasm_output_array_alloc !== 'function') {
+    return
+  }
+  emscriptenModule.ccall(
+    'itk_wasm_output_array_alloc',
+    'number',
+    ['number', 'number', 'number', 'number'],
+    [0, outputIndex, subIndex, byteLength]
+  )
+}
+
 function getPipelineModuleOutputArray (
   emscriptenModule: PipelineEmscriptenModule,
   outputIndex: number,
@@ -121,9 +145,26 @@ function getPipelineModuleOutputArray (
   return data
 }
 
+function getPipelineModuleDescriptorEncodings (
+  emscriptenModule: PipelineEmscriptenModule
+): number {
+  // Modules built before itk_wasm_descriptor_encodings was exported read
+  // array addresses from data URIs and only write JSON descriptors
+  if (typeof (emscriptenModule as any)._itk_wasm_descriptor_encodings !== 'function') {
+    return 0
+  }
+  return emscriptenModule.ccall(
+    'itk_wasm_descriptor_encodings',
+    'number',
+    [],
+    []
+  )
+}
+
 function getPipelineModuleOutputJSON (
   emscriptenModule: PipelineEmscriptenModule,
-  outputIndex: number
+  outputIndex: number,
+  binaryDescriptor: boolean
 ): object {
   const jsonPtr = emscriptenModule.ccall(
     'itk_wasm_output_json_address',
@@ -131,17 +172,101 @@ function getPipelineModuleOutputJSON (
     ['number', 'number'],
     [0, outputIndex]
   )
+  if (binaryDescriptor) {
+    const descriptorSize = emscriptenModule.ccall(
+      'itk_wasm_output_json_size',
+      'number',
+      ['number', 'number'],
+      [0, outputIndex]
+    )
+    return readBinaryDescriptor(
+      new Uint8Array(emscriptenModule.HEAPU8.buffer, jsonPtr, descriptorSize)
+    )
+  }
   const dataJSON = emscriptenModule.UTF8ToString(jsonPtr)
   const dataObject = JSON.parse(dataJSON)
   return dataObject
 }
 
+function getPipelineModuleOutputMetadata (
+  emscriptenModule: PipelineEmscriptenModule,
+  outputIndex: number
+): Array<[string, any]> {
+  const metadataPtr = emscriptenModule.ccall(
+    'itk_wasm_output_metadata_address',
+    'number',
+    ['number', 'number'],
+    [0, outputIndex]
+  )
+  const metadataSize = emscriptenModule.ccall(
+    'itk_wasm_output_metadata_size',
+    'number',
+    ['number', 'number'],
+    [0, outputIndex]
+  )
+  const metadataView = new Uint8Array(
+    emscriptenModule.HEAPU8.buffer,
+    metadataPtr,
+    metadataSize
+  )
+  return JSON.parse(decoder.decode(metadataView))
+}
+
+function releasePipelineModuleInput (
+  emscriptenModule: PipelineEmscriptenModule,
+  inputIndex: number
+): void {
+  // Modules built before itk_wasm_input_release was exported hold their
+  // inputs until the next itk_wasm_free_all
+  if (typeof (emscriptenModule as any)._itk_wasm_input_release !== 'function') {
+    return
+  }
+  emscriptenModule.ccall(
+    'itk_wasm_input_release',
+    null,
+    ['number', 'number'],
+    [0, inputIndex]
+  )
+}
+
+function releasePipelineModuleOutput (
+  emscriptenModule: PipelineEmscriptenModule,
+  outputIndex: number
+): void {
+  // Modules built before itk_wasm_output_release was exported hold their
+  // outputs until the next itk_wasm_free_all
+  if (typeof (emscriptenModule as any)._itk_wasm_output_release !== 'function') {
+    return
+  }
+  emscriptenModule.ccall(
+    'itk_wasm_output_release',
+    null,
+    ['number', 'number'],
+    [0, outputIndex]
+  )
+}
+
 function runPipelineEmscripten (
   pipelineModule: PipelineEmscriptenModule,
   args: string[],
   outputs: PipelineOutput[] | null,
   inputs: PipelineInput[] | null
 ): RunPipelineResult {
+  const descriptorEncodings = getPipelineModuleDescriptorEncodings(pipelineModule)
+  const arrayAddress = (address: number): number | string =>
+    (descriptorEncodings & integerAddressDescriptors) !== 0
+      ? address
+      : `data:application/vnd.itk.address,0:${address}`
+  // Output descriptors are decoded without formatting or escaping when the
+  // module can write them in the binary encoding
+  const binaryDescriptors =
+    (descriptorEncodings & binaryOutputDescriptors) !== 0 &&
+    args.includes('--memory-io')
+  const pipelineArgs =
+    binaryDescriptors && !args.includes('--binary-descriptors')
+      ? [...args, '--binary-descriptors']
+      : args.slice()
+
   if (!(inputs == null) && inputs.length > 0) {
     inputs.forEach(function (input, index) {
       switch (input.type) {
@@ -155,7 +280,7 @@ function runPipelineEmscripten (
           )
           const dataJSON = {
             size: dataArray.buffer.byteLength,
-            data: `data:application/vnd.itk.address,0:${arrayPtr}`
+            data: arrayAddress(arrayPtr)
           }
           setPipelineModuleInputJSON(pipelineModule, dataJSON, index)
           break
@@ -170,7 +295,7 @@ function runPipelineEmscripten (
           )
           const dataJSON = {
             size: dataArray.buffer.byteLength,
-            data: `data:application/vnd.itk.address,0:${arrayPtr}`
+            data: arrayAddress(arrayPtr)
           }
           setPipelineModuleInputJSON(pipelineModule, dataJSON, index)
           break
@@ -185,7 +310,7 @@ function runPipelineEmscripten (
           )
           const dataJSON = {
             size: dataArray.buffer.byteLength,
-            data: `data:application/vnd.itk.address,0:${arrayPtr}`
+            data: arrayAddress(arrayPtr)
           }
           setPipelineModuleInputJSON(pipelineModule, dataJSON, index)
           break
@@ -227,9 +352,9 @@ function runPipelineEmscripten (
             name: image.name,
             origin: image.origin,
             spacing: image.spacing,
-            direction: `data:application/vnd.itk.address,0:${directionPtr}`,
+            direction: arrayAddress(directionPtr),
             size: image.size,
-            data: `data:application/vnd.itk.address,0:${dataPtr}`,
+            data: arrayAddress(dataPtr),
             metadata
           }
           setPipelineModuleInputJSON(pipelineModule, imageJSON, index)
@@ -261,22 +386,28 @@ function runPipelineEmscripten (
             index,
             3
           )
+          const metadata =
+            typeof mesh.metadata?.entries !== 'undefined'
+              ? Array.from(mesh.metadata.entries())
+              : []
           const meshJSON = {
             meshType: mesh.meshType,
             name: mesh.name,
 
             numberOfPoints: mesh.numberOfPoints,
-            points: `data:application/vnd.itk.address,0:${pointsPtr}`,
+            points: arrayAddress(pointsPtr),
 
             numberOfCells: mesh.numberOfCells,
-            cells: `data:application/vnd.itk.address,0:${cellsPtr}`,
+            cells: arrayAddress(cellsPtr),
             cellBufferSize: mesh.cellBufferSize,
 
             numberOfPointPixels: mesh.numberOfPointPixels,
-            pointData: `data:application/vnd.itk.address,0:${pointDataPtr}`,
+            pointData: arrayAddress(pointDataPtr),
 
             numberOfCellPixels: mesh.numberOfCellPixels,
-            cellData: `data:application/vnd.itk.address,0:${cellDataPtr}`
+            cellData: arrayAddress(cellDataPtr),
+
+            metadata
           }
           setPipelineModuleInputJSON(pipelineModule, meshJSON, index)
           break
@@ -330,25 +461,25 @@ function runPipelineEmscripten (
             name: polyData.name,
 
             numberOfPoints: polyData.numberOfPoints,
-            points: `data:application/vnd.itk.address,0:${pointsPtr}`,
+            points: arrayAddress(pointsPtr),
 
             verticesBufferSize: polyData.verticesBufferSize,
-            vertices: `data:application/vnd.itk.address,0:${verticesPtr}`,
+            vertices: arrayAddress(verticesPtr),
 
             linesBufferSize: polyData.linesBufferSize,
-            lines: `data:application/vnd.itk.address,0:${linesPtr}`,
+            lines: arrayAddress(linesPtr),
 
             polygonsBufferSize: polyData.polygonsBufferSize,
-            polygons: `data:application/vnd.itk.address,0:${polygonsPtr}`,
+            polygons: arrayAddress(polygonsPtr),
 
             triangleStripsBufferSize: polyData.triangleStripsBufferSize,
-            triangleStrips: `data:application/vnd.itk.address,0:${triangleStripsPtr}`,
+            triangleStrips: arrayAddress(triangleStripsPtr),
 
             numberOfPointPixels: polyData.numberOfPointPixels,
-            pointData: `data:application/vnd.itk.address,0:${pointDataPtr}`,
+            pointData: arrayAddress(pointDataPtr),
 
             numberOfCellPixels: polyData.numberOfCellPixels,
-            cellData: `data:application/vnd.itk.address,0:${cellDataPtr}`
+            cellData: arrayAddress(cellDataPtr)
           }
           setPipelineModuleInputJSON(pipelineModule, polyDataJSON, index)
           break
@@ -359,12 +490,29 @@ function runPipelineEmscripten (
     })
   }
 
+  if (!(outputs == null) && outputs.length > 0) {
+    outputs.forEach(function (output, index) {
+      if (
+        output.type === InterfaceTypes.Image &&
+        typeof output.bufferByteLength === 'number' &&
+        output.bufferByteLength > 0
+      ) {
+        setPipelineModuleOutputBuffer(
+          pipelineModule,
+          output.bufferByteLength,
+          index,
+          0
+        )
+      }
+    })
+  }
+
   pipelineModule.resetModuleStdout()
   pipelineModule.resetModuleStderr()
   const stackPtr = pipelineModule.stackSave()
   let returnValue = 0
   try {
-    returnValue = pipelineModule.callMain(args.slice())
+    returnValue = pipelineModule.callMain(pipelineArgs)
   } catch (exception) {
     // Note: Module must be built with CMAKE_BUILD_TYPE set to Debug.
     // e.g.: itk-wasm build my/project -- -DCMAKE_BUILD_TYPE:STRING=Debug
@@ -386,10 +534,22 @@ function runPipelineEmscripten (
     throw exception
   } finally {
     pipelineModule.stackRestore(stackPtr)
+    // The pipeline has consumed its inputs, so their memory is returned to
+    // the module for the next invocation. Copying the outputs out below does
+    // not allocate module memory, so an output that references an input
+    // buffer is still intact when it is read.
+    if (!(inputs == null)) {
+      inputs.forEach(function (input, index) {
+        releasePipelineModuleInput(pipelineModule, index)
+      })
+    }
   }
   const stdout = pipelineModule.getModuleStdout()
   const stderr = pipelineModule.getModuleStderr()
 
+  // With --lazy-metadata, output descriptors are written without metadata
+  const lazyMetadata = args.includes('--lazy-metadata')
+
   const populatedOutputs: PipelineOutput[] = []
   if (!(outputs == null) && outputs.length > 0 && returnValue === 0) {
     outputs.forEach(function (output, index) {
@@ -477,7 +637,8 @@ function runPipelineEmscripten (
         case InterfaceTypes.Image: {
           const image = getPipelineModuleOutputJSON(
             pipelineModule,
-            index
+            index,
+            binaryDescriptors
           ) as Image
           image.data = getPipelineModuleOutputArray(
             pipelineModule,
@@ -491,6 +652,12 @@ function runPipelineEmscripten (
             1,
             FloatTypes.Float64
           ) as Float64Array
+          if (lazyMetadata && output.readMetadata !== false) {
+            image.metadata = getPipelineModuleOutputMetadata(
+              pipelineModule,
+              index
+            ) as any
+          }
           image.metadata = new Map(image.metadata)
           outputData = image
           break
@@ -498,7 +665,8 @@ function runPipelineEmscripten (
         case InterfaceTypes.Mesh: {
           const mesh = getPipelineModuleOutputJSON(
             pipelineModule,
-            index
+            index,
+            binaryDescriptors
           ) as Mesh
           if (mesh.numberOfPoints > 0) {
             mesh.points = getPipelineModuleOutputArray(
@@ -552,13 +720,21 @@ function runPipelineEmscripten (
               new ArrayBuffer(0)
             )
           }
+          if (lazyMetadata && output.readMetadata !== false) {
+            mesh.metadata = getPipelineModuleOutputMetadata(
+              pipelineModule,
+              index
+            ) as any
+          }
+          mesh.metadata = new Map(mesh.metadata)
           outputData = mesh
           break
         }
         case InterfaceTypes.PolyData: {
           const polyData = getPipelineModuleOutputJSON(
             pipelineModule,
-            index
+            index,
+            binaryDescriptors
           ) as PolyData
           if (polyData.numberOfPoints > 0) {
             polyData.points = getPipelineModuleOutputArray(
@@ -642,6 +818,9 @@ function runPipelineEmscripten (
         default:
           throw Error('Unsupported output InterfaceType')
       }
+      // The output has been copied out of the module memory, free it before
+      // the next output is copied so peak memory is one output at a time
+      releasePipelineModuleOutput(pipelineModule, index)
       const populatedOutput = {
         type: output.type,
         data: outputData
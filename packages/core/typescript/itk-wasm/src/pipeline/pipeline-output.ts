@@ -23,6 +23,14 @@ interface PipelineOutput {
   | Mesh
   | PolyData
   | Transform
+  /** Byte length of a buffer the host pre-allocates for the output image
+   * pixel data before the pipeline runs. Pipelines that opt in with
+   * OutputImage::UseOutputBuffer write their result into it in place. */
+  bufferByteLength?: number
+  /** When the pipeline runs with --lazy-metadata, the image or mesh
+   * metadata is only serialized when the host reads it. Set to false to
+   * skip it. */
+  readMetadata?: boolean
 }
 
 export default PipelineOutput
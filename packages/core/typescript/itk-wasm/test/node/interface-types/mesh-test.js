@@ -57,3 +57,8 @@ test('cellBufferSize should have a default value of 0', t => {
   const mesh = new Mesh()
   t.is(mesh.cellBufferSize, 0)
 })
+
+test('metadata should be an object', t => {
+  const mesh = new Mesh()
+  t.is(typeof mesh.metadata, 'object')
+})
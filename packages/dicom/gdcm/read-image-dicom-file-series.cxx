@@ -288,6 +288,7 @@ int runPipeline(itk::wasm::Pipeline & pipeline, std::vector<std::string> & input
   auto gdcmImageIO = itk::GDCMImageIO::New();
   reader->SetImageIO(gdcmImageIO);
 
+  pipeline.observe_process(reader);
   ITK_WASM_CATCH_EXCEPTION(pipeline, reader->Update());
   outputImage.Set(reader->GetOutput());
 
@@ -55,6 +55,8 @@ public:
     {
       filter->SetShrinkFactor(i, shrinkFactors[i]);
     }
+    downsampledImage.UseOutputBuffer(filter);
+    pipeline.observe_process(filter);
 
     if (informationOnly)
     {
@@ -72,7 +74,7 @@ public:
   }
 };
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("downsample-bin-shrink", "Apply local averaging and subsample the input image.", argc, argv);
 
@@ -90,3 +92,5 @@ int main(int argc, char * argv[])
     >
   ::Dimensions<2U, 3U, 4U, 5U>("input", pipeline);
 }
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
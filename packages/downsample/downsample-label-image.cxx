@@ -81,6 +81,8 @@ public:
     shrinkFilter->SetSize(outputSize);
     shrinkFilter->SetOutputStartIndex(inputImage.Get()->GetLargestPossibleRegion().GetIndex());
 
+    downsampledImage.UseOutputBuffer(shrinkFilter);
+    pipeline.observe_process(shrinkFilter);
     ITK_WASM_CATCH_EXCEPTION(pipeline, shrinkFilter->UpdateLargestPossibleRegion());
 
     typename ImageType::ConstPointer result = shrinkFilter->GetOutput();
@@ -90,7 +92,7 @@ public:
   }
 };
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("downsample-label-image", "Subsample the input label image a according to weighted voting of local labels.", argc, argv);
 
@@ -107,3 +109,5 @@ int main(int argc, char * argv[])
     >
   ::Dimensions<2U, 3U, 4U, 5U>("input", pipeline);
 }
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
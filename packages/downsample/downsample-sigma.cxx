@@ -24,7 +24,7 @@
 
 #include "downsampleSigma.h"
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("downsample-sigma", "Compute gaussian kernel sigma values in pixel units for downsampling.", argc, argv);
 
@@ -54,3 +54,5 @@ int main(int argc, char * argv[])
 
   return EXIT_SUCCESS;
 }
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
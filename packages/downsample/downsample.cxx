@@ -94,6 +94,9 @@ public:
     shrinkFilter->SetSize(outputSize);
     shrinkFilter->SetOutputStartIndex(inputImage.Get()->GetLargestPossibleRegion().GetIndex());
 
+    downsampledImage.UseOutputBuffer(shrinkFilter);
+    pipeline.observe_process(gaussianFilter);
+    pipeline.observe_process(shrinkFilter);
     ITK_WASM_CATCH_EXCEPTION(pipeline, shrinkFilter->UpdateLargestPossibleRegion());
 
     typename ImageType::ConstPointer result = shrinkFilter->GetOutput();
@@ -103,7 +106,7 @@ public:
   }
 };
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("downsample", "Apply a smoothing anti-alias filter and subsample the input image.", argc, argv);
 
@@ -120,4 +123,6 @@ int main(int argc, char * argv[])
     double
     >
   ::Dimensions<2U, 3U, 4U, 5U>("input", pipeline);
-}
\ No newline at end of file
+}
+
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
@@ -26,7 +26,7 @@
 #include "rapidjson/writer.h"
 
 
-int main(int argc, char * argv[])
+int pipelineMain(int argc, char * argv[])
 {
   itk::wasm::Pipeline pipeline("gaussian-kernel-radius", "Radius in pixels required for effective discrete gaussian filtering.", argc, argv);
 
@@ -81,3 +81,4 @@ int main(int argc, char * argv[])
   return EXIT_SUCCESS;
 }
 
+ITK_WASM_PIPELINE_MAIN(pipelineMain)
@@ -24,6 +24,7 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
+#include "itkWasmDescriptor.h"
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #endif
@@ -73,7 +74,7 @@ bool lexical_cast(const std::string &input, InputImageIO &inputImageIO)
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
     auto json = getMemoryStoreInputJSON(0, index);
-    auto        deserializedAttempt = glz::read_json<itk::ImageJSON>(json);
+    auto        deserializedAttempt = readDescriptor<itk::ImageJSON>(json);
     if (!deserializedAttempt)
     {
       const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -87,20 +88,14 @@ bool lexical_cast(const std::string &input, InputImageIO &inputImageIO)
     const unsigned int dimension = wasmImageIO->GetNumberOfDimensions();
 
     auto wasmImageIOBase = itk::WasmImageIOBase::New();
-    const std::string directionString = imageJSON.direction;
-    const double * directionPtr = reinterpret_cast< double * >( std::strtoull(directionString.substr(35).c_str(), nullptr, 10) );
-    WasmImageIOBase::DirectionContainerType * directionContainer = wasmImageIOBase->GetDirectionContainer();
-    directionContainer->resize(dimension*dimension);
-    directionContainer->assign(directionPtr, directionPtr + dimension*dimension);
-
-    const std::string dataString = imageJSON.data;
-    const char * dataPtr = reinterpret_cast< char * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
+    const double * directionPtr = descriptorArrayPointer<double>(imageJSON.direction);
+    wasmImageIOBase->SetDirectionView(directionPtr, dimension*dimension);
+
+    const char * dataPtr = descriptorArrayPointer<char>(imageJSON.data);
     if (dataPtr != nullptr)
     {
-      WasmImageIOBase::PixelDataContainerType * pixelDataContainer = wasmImageIOBase->GetPixelDataContainer();
-      const size_t pixelDataBytes = wasmImageIO->GetImageSizeInBytes();
-      pixelDataContainer->resize(pixelDataBytes);
-      pixelDataContainer->assign(dataPtr, dataPtr + pixelDataBytes);
+      // Reference the memory store input, which outlives the pipeline, without a copy
+      wasmImageIOBase->SetPixelDataView(dataPtr, wasmImageIO->GetImageSizeInBytes());
     }
     wasmImageIOBase->SetImageIO(wasmImageIO, false);
     wasmImageIOBase->SetJSON(json);
@@ -79,6 +79,7 @@ public:
     {
     const auto index = std::stoi(this->m_Identifier);
     auto wasmImageIOBase = itk::WasmImageIOBase::New();
+    wasmImageIOBase->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
     wasmImageIOBase->SetImageIO(this->m_ImageIO);
     setMemoryStoreOutputDataObject(0, index, wasmImageIOBase);
 
@@ -18,6 +18,7 @@
 #include "itkWasmImageIOBase.h"
 
 #include "itkWasmImageIO.h"
+#include "itkWasmDescriptor.h"
 
 #include <sstream>
 
@@ -66,11 +67,7 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
       this->m_DirectionContainer->SetElement(ii+dimension*jj, dimensionDirection[jj]);
     }
   }
-  const auto directionAddress = reinterpret_cast< size_t >( &(this->m_DirectionContainer->at(0)) );
-  std::ostringstream directionStream;
-  directionStream << "data:application/vnd.itk.address,0:";
-  directionStream << directionAddress;
-  imageJSON.direction = directionStream.str();
+  imageJSON.direction = descriptorArray(&(this->m_DirectionContainer->at(0)));
 
   ImageIORegion ioRegion( dimension );
   for(unsigned int dim = 0; dim < dimension; ++dim)
@@ -81,14 +78,10 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
   this->m_PixelDataContainer->resize( imageIO->GetImageSizeInBytes() );
   imageIO->Read( reinterpret_cast< void * >( &(this->m_PixelDataContainer->at(0)) ));
 
-  const auto pixelDataAddress = reinterpret_cast< size_t >( &(this->m_PixelDataContainer->at(0)) );
-  std::ostringstream dataStream;
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << pixelDataAddress;
-  imageJSON.data = dataStream.str();
+  imageJSON.data = descriptorArray(&(this->m_PixelDataContainer->at(0)));
 
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(imageJSON, serialized);
+  auto ec = writeDescriptor(imageJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize TransformListJSON");
@@ -96,6 +89,50 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
   this->SetJSON(serialized);
 }
 
+void
+WasmImageIOBase::SetDirectionView(const double * direction, SizeValueType size)
+{
+  this->m_DirectionView = direction;
+  this->m_DirectionViewSize = size;
+}
+
+const double *
+WasmImageIOBase::GetDirectionData() const
+{
+  if (this->m_DirectionView != nullptr)
+  {
+    return this->m_DirectionView;
+  }
+  return this->m_DirectionContainer->size() == 0 ? nullptr : &(this->m_DirectionContainer->at(0));
+}
+
+void
+WasmImageIOBase::SetPixelDataView(const char * pixelData, SizeValueType size)
+{
+  this->m_PixelDataView = pixelData;
+  this->m_PixelDataViewSize = size;
+}
+
+const char *
+WasmImageIOBase::GetPixelData() const
+{
+  if (this->m_PixelDataView != nullptr)
+  {
+    return this->m_PixelDataView;
+  }
+  return this->m_PixelDataContainer->size() == 0 ? nullptr : &(this->m_PixelDataContainer->at(0));
+}
+
+SizeValueType
+WasmImageIOBase::GetPixelDataSize() const
+{
+  if (this->m_PixelDataView != nullptr)
+  {
+    return this->m_PixelDataViewSize;
+  }
+  return this->m_PixelDataContainer->size();
+}
+
 void
 WasmImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
@@ -105,6 +142,8 @@ WasmImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
   this->m_DirectionContainer->Print(os, indent);
   os << indent << "PixelDataContainer";
   this->m_PixelDataContainer->Print(os, indent);
+  os << indent << "DirectionView: " << static_cast<const void *>(this->m_DirectionView) << " (" << this->m_DirectionViewSize << ")" << std::endl;
+  os << indent << "PixelDataView: " << static_cast<const void *>(this->m_PixelDataView) << " (" << this->m_PixelDataViewSize << ")" << std::endl;
 }
 
 } // end namespace itk
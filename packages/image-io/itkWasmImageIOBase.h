@@ -37,6 +37,10 @@ namespace itk
  * 
  * - 0: Pixel buffer `data`
  * - 1: Orientation `direction`
+ *
+ * Either array can instead reference an externally owned buffer, such as a
+ * memory IO input, to avoid copying the pixel data. The referenced buffer
+ * must outlive this object.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -81,6 +85,17 @@ public:
     return this->m_PixelDataContainer.GetPointer();
   }
 
+  /** Reference an externally owned direction buffer instead of the DirectionContainer. */
+  void SetDirectionView(const double * direction, SizeValueType size);
+  /** Direction buffer, the view when set, otherwise the DirectionContainer. */
+  const double * GetDirectionData() const;
+
+  /** Reference an externally owned pixel buffer instead of the PixelDataContainer. */
+  void SetPixelDataView(const char * pixelData, SizeValueType size);
+  /** Pixel buffer, the view when set, otherwise the PixelDataContainer. */
+  const char * GetPixelData() const;
+  SizeValueType GetPixelDataSize() const;
+
 protected:
   WasmImageIOBase();
   ~WasmImageIOBase() override = default;
@@ -91,6 +106,11 @@ protected:
   DirectionContainerType::Pointer m_DirectionContainer;
   PixelDataContainerType::Pointer m_PixelDataContainer;
 
+  const double * m_DirectionView{ nullptr };
+  SizeValueType m_DirectionViewSize{ 0 };
+  const char * m_PixelDataView{ nullptr };
+  SizeValueType m_PixelDataViewSize{ 0 };
+
   ImageIOBase::ConstPointer m_ImageIOBase;
 };
 
@@ -19,14 +19,213 @@
 #include "itkWasmZstdImageIO.h"
 #include "zstd.h"
 
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+
 namespace itk
 {
 
+namespace
+{
+
+/** Counts the bytes written, e.g. to pledge the frame content size. */
+class CountingStreamBuffer: public std::streambuf
+{
+public:
+  size_t GetCount() const
+  {
+    return m_Count;
+  }
+
+protected:
+  std::streamsize xsputn(const char *, std::streamsize count) override
+  {
+    m_Count += count;
+    return count;
+  }
+
+  int_type overflow(int_type character) override
+  {
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      ++m_Count;
+    }
+    return traits_type::not_eof(character);
+  }
+
+private:
+  size_t m_Count{ 0 };
+};
+
+/** Compresses the bytes written to it into a zstd frame on the sink.
+ *
+ * Writes are passed directly to ZSTD_compressStream2, so large buffers are
+ * not copied before they are compressed. */
+class ZstdOutputStreamBuffer: public std::streambuf
+{
+public:
+  ZstdOutputStreamBuffer(std::ostream & sink, ZSTD_CCtx * context)
+    : m_Sink(sink), m_Context(context), m_OutputBuffer(ZSTD_CStreamOutSize())
+  {}
+
+  /** Flush the remaining data and the frame epilogue. */
+  void Finish()
+  {
+    this->Compress(nullptr, 0, ZSTD_e_end);
+  }
+
+protected:
+  std::streamsize xsputn(const char * data, std::streamsize count) override
+  {
+    this->Compress(data, static_cast<size_t>(count), ZSTD_e_continue);
+    return count;
+  }
+
+  int_type overflow(int_type character) override
+  {
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      const char value = traits_type::to_char_type(character);
+      this->Compress(&value, 1, ZSTD_e_continue);
+    }
+    return traits_type::not_eof(character);
+  }
+
+private:
+  void Compress(const char * data, size_t size, ZSTD_EndDirective mode)
+  {
+    ZSTD_inBuffer input{ data, size, 0 };
+    bool finished = false;
+    while (!finished)
+    {
+      ZSTD_outBuffer output{ m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+      const size_t remaining = ZSTD_compressStream2(m_Context, &output, &input, mode);
+      if (ZSTD_isError(remaining))
+      {
+        throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+      }
+      m_Sink.write(m_OutputBuffer.data(), output.pos);
+      finished = mode == ZSTD_e_end ? remaining == 0 : input.pos == input.size;
+    }
+  }
+
+  std::ostream & m_Sink;
+  ZSTD_CCtx * m_Context;
+  std::vector<char> m_OutputBuffer;
+};
+
+/** Decompress a zstd file by streaming it through a small input buffer.
+ *
+ * Throws std::runtime_error when the data is invalid or the file ends within
+ * a frame. */
+std::vector<unsigned char>
+decompressZstdFile(std::ifstream & inputStream)
+{
+  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  std::vector<char> inputBuffer(ZSTD_DStreamInSize());
+  std::vector<unsigned char> decompressed;
+  size_t decompressedSize = 0;
+  size_t frameRemaining = 0;
+  bool firstChunk = true;
+
+  while (inputStream)
+  {
+    inputStream.read(inputBuffer.data(), inputBuffer.size());
+    const size_t readSize = static_cast<size_t>(inputStream.gcount());
+    if (readSize == 0)
+    {
+      break;
+    }
+    if (firstChunk)
+    {
+      const unsigned long long contentSize = ZSTD_getFrameContentSize(inputBuffer.data(), readSize);
+      if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR)
+      {
+        decompressed.resize(contentSize);
+      }
+      firstChunk = false;
+    }
+
+    ZSTD_inBuffer input{ inputBuffer.data(), readSize, 0 };
+    bool flushing = false;
+    while (input.pos < input.size || flushing)
+    {
+      if (decompressedSize == decompressed.size())
+      {
+        decompressed.resize(std::max(2 * decompressed.size(), decompressed.size() + ZSTD_DStreamOutSize()));
+      }
+      ZSTD_outBuffer output{ decompressed.data(), decompressed.size(), decompressedSize };
+      frameRemaining = ZSTD_decompressStream(context.get(), &output, &input);
+      if (ZSTD_isError(frameRemaining))
+      {
+        throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(frameRemaining));
+      }
+      decompressedSize = output.pos;
+      // A full output buffer may leave decompressed data in the context
+      flushing = output.pos == output.size && frameRemaining != 0;
+    }
+  }
+  if (frameRemaining != 0)
+  {
+    throw std::runtime_error("The file ends within a zstd frame");
+  }
+  decompressed.resize(decompressedSize);
+
+  return decompressed;
+}
+
+constexpr uint32_t SkippableFrameMagicNumber = 0x184D2A5E;
+constexpr uint32_t SeekableMagicNumber = 0x8F92EAB1;
+constexpr size_t SeekTableFooterSize = 9;
+
+void
+writeUInt32LE(std::ostream & outputStream, uint32_t value)
+{
+  const char bytes[4] = { static_cast<char>(value & 0xff),
+                          static_cast<char>((value >> 8) & 0xff),
+                          static_cast<char>((value >> 16) & 0xff),
+                          static_cast<char>((value >> 24) & 0xff) };
+  outputStream.write(bytes, 4);
+}
+
+uint32_t
+readUInt32LE(const unsigned char * bytes)
+{
+  return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+std::vector<char>
+compressFrame(const char * data, size_t size, int compressionLevel)
+{
+  std::vector<char> compressed(ZSTD_compressBound(size));
+  const size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data, size, compressionLevel);
+  if (ZSTD_isError(compressedSize))
+  {
+    throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(compressedSize));
+  }
+  compressed.resize(compressedSize);
+  return compressed;
+}
+
+} // end anonymous namespace
+
 WasmZstdImageIO
 ::WasmZstdImageIO()
 {
   this->AddSupportedWriteExtension(".iwi.cbor.zst");
   this->AddSupportedReadExtension(".iwi.cbor.zst");
+
+  this->Self::SetMaximumCompressionLevel(ZSTD_maxCLevel());
+  this->Self::SetCompressionLevel(ZSTD_CLEVEL_DEFAULT);
 }
 
 
@@ -75,17 +274,34 @@ WasmZstdImageIO
     std::ifstream dataStream;
     this->OpenFileForReading( dataStream, this->GetFileName() );
 
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
-
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+    this->ReadSeekTable( dataStream );
+    if ( !this->m_SeekTable.empty() )
+    {
+      std::vector<unsigned char>().swap(this->m_DecompressedCBOR);
+      this->m_DecompressedFileName.clear();
+
+      // Only the first frame, with the image information, is decompressed
+      const std::vector<char> header = this->ReadFrame( dataStream, 0 );
+      std::vector<unsigned char> decompressedHeader( this->m_SeekTable[0].decompressedSize );
+      this->DecompressFrame( header, 0, decompressedHeader.data() );
+      this->ReadCBOR(nullptr, decompressedHeader.data(), decompressedHeader.size(), true);
+      return;
+    }
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
+    // Kept for the following Read so the file is only decompressed once
+    dataStream.clear();
+    dataStream.seekg( 0 );
+    try
+    {
+      this->m_DecompressedCBOR = decompressZstdFile(dataStream);
+    }
+    catch ( const std::runtime_error & error )
+    {
+      itkExceptionMacro(<< error.what() << ": " << this->GetFileName());
+    }
+    this->m_DecompressedFileName = path;
 
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+    this->ReadCBOR(nullptr, this->m_DecompressedCBOR.data(), this->m_DecompressedCBOR.size());
     return;
   }
 
@@ -102,21 +318,29 @@ WasmZstdImageIO
   if ( ( zstdPos != std::string::npos )
        && ( zstdPos == path.length() - 4 ) )
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
-
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
-
-
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+    if ( !this->m_SeekTable.empty() )
+    {
+      this->ReadFrames( buffer );
+      return;
+    }
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
+    if ( this->m_DecompressedFileName != path )
+    {
+      std::ifstream dataStream;
+      this->OpenFileForReading( dataStream, this->GetFileName() );
+      try
+      {
+        this->m_DecompressedCBOR = decompressZstdFile(dataStream);
+      }
+      catch ( const std::runtime_error & error )
+      {
+        itkExceptionMacro(<< error.what() << ": " << this->GetFileName());
+      }
+    }
 
-    this->ReadCBOR(buffer, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+    this->ReadCBOR(buffer, this->m_DecompressedCBOR.data(), this->m_DecompressedCBOR.size());
+    std::vector<unsigned char>().swap(this->m_DecompressedCBOR);
+    this->m_DecompressedFileName.clear();
     return;
   }
 
@@ -170,25 +394,445 @@ WasmZstdImageIO
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 4 ) )
   {
-    unsigned char * inputBinary;
-    const size_t inputBinarySize = this->WriteCBOR(buffer, &inputBinary, true);
+    if ( this->m_SlicesPerFrame > 0 || this->m_Prefilter != WasmPrefilterEnum::None )
+    {
+      this->WriteFrames( buffer );
+      return;
+    }
 
-    const size_t compressedBufferSize = ZSTD_compressBound(inputBinarySize);
-    std::vector<char> compressedBinary(compressedBufferSize);
+    std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, this->GetCompressionLevel());
+#if !defined(__EMSCRIPTEN__) && !defined(__wasi__)
+    // Fails, and compression stays single-threaded, when zstd is built
+    // without multithreading support
+    ZSTD_CCtx_setParameter(context.get(), ZSTD_c_nbWorkers, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+#endif
 
-    constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary, inputBinarySize, compressionLevel);
-    free(inputBinary);
-    compressedBinary.resize(compressedSize);
+    // The content size in the frame header lets readers allocate up front
+    CountingStreamBuffer countingBuffer;
+    std::ostream countingStream(&countingBuffer);
+    this->WriteCBOR(countingStream, buffer);
+    ZSTD_CCtx_setPledgedSrcSize(context.get(), countingBuffer.GetCount());
 
     std::ofstream outputStream;
     this->OpenFileForWriting( outputStream, path.c_str(), true, false );
-    std::ostream_iterator<char> oIt(outputStream);
-    std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+    ZstdOutputStreamBuffer compressingBuffer(outputStream, context.get());
+    std::ostream compressingStream(&compressingBuffer);
+    this->WriteCBOR(compressingStream, buffer);
+    compressingBuffer.Finish();
+    if ( !outputStream )
+    {
+      itkExceptionMacro(<< "Failed to write " << path);
+    }
     return;
   }
 
   Superclass::Write( buffer );
 }
 
+
+bool
+WasmZstdImageIO
+::CanStreamRead()
+{
+  const std::string path = this->GetFileName();
+  std::string::size_type zstdPos = path.rfind(".zst");
+  if ( ( zstdPos != std::string::npos )
+       && ( zstdPos == path.length() - 4 ) )
+  {
+    // Regions can only be read without decompressing the whole image
+    // when it is split into frames
+    return !this->m_SeekTable.empty();
+  }
+
+  return Superclass::CanStreamRead();
+}
+
+
+std::string
+WasmZstdImageIO
+::GetChunkCompression() const
+{
+  return this->GetUseCompression() ? "zstd" : "";
+}
+
+
+void
+WasmZstdImageIO
+::ReadChunk( const std::string & fileName, const std::string & compression, void * buffer, SizeValueType numberOfBytes )
+{
+  if ( compression != "zstd" )
+  {
+    Superclass::ReadChunk( fileName, compression, buffer, numberOfBytes );
+    return;
+  }
+
+  std::ifstream inputStream;
+  this->OpenFileForReading( inputStream, fileName );
+  const std::vector<char> compressed( ( std::istreambuf_iterator<char>( inputStream ) ), std::istreambuf_iterator<char>() );
+  const size_t result = ZSTD_decompress( buffer, numberOfBytes, compressed.data(), compressed.size() );
+  if ( ZSTD_isError( result ) || result != numberOfBytes )
+  {
+    itkExceptionMacro(<< "Could not decompress zstd chunk " << fileName);
+  }
+}
+
+
+void
+WasmZstdImageIO
+::WriteChunk( const std::string & fileName, const std::string & compression, const void * buffer, SizeValueType numberOfBytes )
+{
+  if ( compression != "zstd" )
+  {
+    Superclass::WriteChunk( fileName, compression, buffer, numberOfBytes );
+    return;
+  }
+
+  const std::vector<char> compressed = compressFrame( static_cast<const char *>( buffer ), numberOfBytes, this->GetCompressionLevel() );
+  std::ofstream outputStream;
+  this->OpenFileForWriting( outputStream, fileName, true, false );
+  outputStream.write( compressed.data(), compressed.size() );
+  if ( !outputStream )
+  {
+    itkExceptionMacro(<< "Write failed: could not write " << compressed.size() << " bytes to " << fileName);
+  }
+}
+
+
+void
+WasmZstdImageIO
+::ReadSeekTable( std::ifstream & inputStream )
+{
+  this->m_SeekTable.clear();
+  this->m_ReadPrefilter = WasmPrefilterParameters();
+
+  inputStream.seekg( 0, std::ios::end );
+  const uint64_t fileSize = static_cast<uint64_t>( inputStream.tellg() );
+  if ( fileSize < SeekTableFooterSize + 8 )
+  {
+    inputStream.seekg( 0 );
+    return;
+  }
+
+  unsigned char footer[SeekTableFooterSize];
+  inputStream.seekg( fileSize - SeekTableFooterSize );
+  inputStream.read( reinterpret_cast<char *>(footer), SeekTableFooterSize );
+  if ( !inputStream || readUInt32LE( footer + 5 ) != SeekableMagicNumber )
+  {
+    inputStream.clear();
+    inputStream.seekg( 0 );
+    return;
+  }
+
+  const uint32_t numberOfFrames = readUInt32LE( footer );
+  const bool hasChecksums = ( footer[4] & 0x80 ) != 0;
+  const size_t entrySize = hasChecksums ? 12 : 8;
+  const uint64_t seekTableSize = 8 + static_cast<uint64_t>(numberOfFrames) * entrySize + SeekTableFooterSize;
+  if ( numberOfFrames == 0 || seekTableSize > fileSize )
+  {
+    itkExceptionMacro(<< "Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  std::vector<unsigned char> seekTable( seekTableSize - SeekTableFooterSize );
+  inputStream.seekg( fileSize - seekTableSize );
+  inputStream.read( reinterpret_cast<char *>(seekTable.data()), seekTable.size() );
+  if ( !inputStream || readUInt32LE( seekTable.data() ) != SkippableFrameMagicNumber ||
+       readUInt32LE( seekTable.data() + 4 ) != seekTableSize - 8 )
+  {
+    itkExceptionMacro(<< "Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  uint64_t framesSize = 0;
+  this->m_SeekTable.resize( numberOfFrames );
+  for ( uint32_t frame = 0; frame < numberOfFrames; ++frame )
+  {
+    const unsigned char * entry = seekTable.data() + 8 + frame * entrySize;
+    this->m_SeekTable[frame].compressedSize = readUInt32LE( entry );
+    this->m_SeekTable[frame].decompressedSize = readUInt32LE( entry + 4 );
+    framesSize += this->m_SeekTable[frame].compressedSize;
+  }
+  if ( framesSize + seekTableSize > fileSize )
+  {
+    this->m_SeekTable.clear();
+    itkExceptionMacro(<< "Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  // The frames follow the skippable frames at the start of the file, e.g.
+  // the prefilter frame
+  uint64_t offset = fileSize - seekTableSize - framesSize;
+  if ( offset >= WasmPrefilterFrameSize )
+  {
+    unsigned char prefilterFrame[WasmPrefilterFrameSize];
+    inputStream.seekg( 0 );
+    inputStream.read( reinterpret_cast<char *>(prefilterFrame), WasmPrefilterFrameSize );
+    try
+    {
+      if ( !inputStream || !readWasmPrefilterFrame( prefilterFrame, WasmPrefilterFrameSize, this->m_ReadPrefilter ) )
+      {
+        itkExceptionMacro(<< "Unknown data before the zstd frames of " << this->GetFileName());
+      }
+    }
+    catch ( const std::runtime_error & error )
+    {
+      itkExceptionMacro(<< error.what() << " of " << this->GetFileName());
+    }
+  }
+  for ( auto & frame : this->m_SeekTable )
+  {
+    frame.offset = offset;
+    offset += frame.compressedSize;
+  }
+  inputStream.seekg( 0 );
+}
+
+
+std::vector<char>
+WasmZstdImageIO
+::ReadFrame( std::ifstream & inputStream, size_t frame ) const
+{
+  std::vector<char> compressed( this->m_SeekTable[frame].compressedSize );
+  inputStream.seekg( this->m_SeekTable[frame].offset );
+  inputStream.read( compressed.data(), compressed.size() );
+  if ( !inputStream )
+  {
+    itkExceptionMacro(<< "Could not read zstd frame " << frame << " of " << this->GetFileName());
+  }
+  return compressed;
+}
+
+
+void
+WasmZstdImageIO
+::DecompressFrame( const std::vector<char> & compressed, size_t frame, unsigned char * decompressed ) const
+{
+  const size_t decompressedSize = this->m_SeekTable[frame].decompressedSize;
+  const size_t result = ZSTD_decompress( decompressed, decompressedSize, compressed.data(), compressed.size() );
+  if ( ZSTD_isError( result ) || result != decompressedSize )
+  {
+    itkExceptionMacro(<< "Could not decompress zstd frame " << frame << " of " << this->GetFileName());
+  }
+}
+
+
+void
+WasmZstdImageIO
+::ReadFrames( void * buffer )
+{
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const unsigned int sliceAxis = dimension - 1;
+  const SizeValueType pixelSize = this->GetPixelSize();
+
+  ImageIORegion ioRegion = this->GetIORegion();
+  if ( ioRegion.GetImageDimension() != dimension )
+  {
+    ioRegion = ImageIORegion( dimension );
+    for ( unsigned int dim = 0; dim < dimension; ++dim )
+    {
+      ioRegion.SetSize( dim, this->GetDimensions( dim ) );
+    }
+  }
+
+  // Slices are along the slowest axis, rows along the fastest axis
+  SizeValueType sliceBytes = pixelSize;
+  for ( unsigned int dim = 0; dim < sliceAxis; ++dim )
+  {
+    sliceBytes *= this->GetDimensions( dim );
+  }
+  const SizeValueType rowBytes = sliceAxis > 0 ? ioRegion.GetSize( 0 ) * pixelSize : pixelSize;
+  SizeValueType rowsPerSlice = 1;
+  for ( unsigned int dim = 1; dim < sliceAxis; ++dim )
+  {
+    rowsPerSlice *= ioRegion.GetSize( dim );
+  }
+  const SizeValueType regionSliceBytes = rowBytes * rowsPerSlice;
+  const bool regionIsContiguous = regionSliceBytes == sliceBytes;
+
+  const SizeValueType regionBegin = ioRegion.GetIndex( sliceAxis );
+  const SizeValueType regionEnd = regionBegin + ioRegion.GetSize( sliceAxis );
+
+  // The frames after the image information frame that overlap the region
+  struct FrameSlices
+  {
+    size_t frame;
+    SizeValueType begin;
+    SizeValueType end;
+  };
+  std::vector<FrameSlices> frames;
+  SizeValueType sliceBegin = 0;
+  for ( size_t frame = 1; frame < this->m_SeekTable.size(); ++frame )
+  {
+    const SizeValueType decompressedSize = this->m_SeekTable[frame].decompressedSize;
+    if ( decompressedSize % sliceBytes != 0 )
+    {
+      itkExceptionMacro(<< "zstd frame " << frame << " of " << this->GetFileName() << " does not hold whole slices");
+    }
+    const SizeValueType sliceEnd = sliceBegin + decompressedSize / sliceBytes;
+    if ( sliceEnd > regionBegin && sliceBegin < regionEnd )
+    {
+      frames.push_back( FrameSlices{ frame, sliceBegin, sliceEnd } );
+    }
+    sliceBegin = sliceEnd;
+  }
+  if ( sliceBegin < regionEnd )
+  {
+    itkExceptionMacro(<< "Read failed: the zstd frames of " << this->GetFileName() << " hold " << sliceBegin
+                      << " slices, but the region ends at slice " << regionEnd);
+  }
+
+  auto * output = static_cast<unsigned char *>( buffer );
+  const auto readFrame = [&]( SizeValueType ii ) {
+    const FrameSlices & frameSlices = frames[ii];
+    std::vector<char> compressed;
+    {
+      std::ifstream inputStream;
+      this->OpenFileForReading( inputStream, this->GetFileName() );
+      compressed = this->ReadFrame( inputStream, frameSlices.frame );
+    }
+
+    const SizeValueType copyBegin = std::max( frameSlices.begin, regionBegin );
+    const SizeValueType copyEnd = std::min( frameSlices.end, regionEnd );
+    if ( regionIsContiguous && copyBegin == frameSlices.begin && copyEnd == frameSlices.end )
+    {
+      // The whole frame lands in the buffer
+      unsigned char * frameOutput = output + ( frameSlices.begin - regionBegin ) * regionSliceBytes;
+      this->DecompressFrame( compressed, frameSlices.frame, frameOutput );
+      undoWasmPrefilter( this->m_ReadPrefilter, frameOutput, this->m_SeekTable[frameSlices.frame].decompressedSize );
+      return;
+    }
+
+    std::vector<unsigned char> decompressed( this->m_SeekTable[frameSlices.frame].decompressedSize );
+    this->DecompressFrame( compressed, frameSlices.frame, decompressed.data() );
+    undoWasmPrefilter( this->m_ReadPrefilter, decompressed.data(), decompressed.size() );
+    for ( SizeValueType slice = copyBegin; slice < copyEnd; ++slice )
+    {
+      for ( SizeValueType row = 0; row < rowsPerSlice; ++row )
+      {
+        SizeValueType sourceOffset = ( slice - frameSlices.begin ) * sliceBytes;
+        SizeValueType destinationOffset = ( slice - regionBegin ) * regionSliceBytes;
+        if ( sliceAxis > 0 )
+        {
+          sourceOffset += ioRegion.GetIndex( 0 ) * pixelSize;
+          SizeValueType remainder = row;
+          SizeValueType sourceStride = this->GetDimensions( 0 ) * pixelSize;
+          SizeValueType destinationStride = rowBytes;
+          for ( unsigned int dim = 1; dim < sliceAxis; ++dim )
+          {
+            const SizeValueType index = remainder % ioRegion.GetSize( dim );
+            remainder /= ioRegion.GetSize( dim );
+            sourceOffset += ( ioRegion.GetIndex( dim ) + index ) * sourceStride;
+            destinationOffset += index * destinationStride;
+            sourceStride *= this->GetDimensions( dim );
+            destinationStride *= ioRegion.GetSize( dim );
+          }
+        }
+        std::memcpy( output + destinationOffset, decompressed.data() + sourceOffset, rowBytes );
+      }
+    }
+  };
+
+  MultiThreaderBase::New()->ParallelizeArray( 0, frames.size(), readFrame, nullptr );
+}
+
+
+void
+WasmZstdImageIO
+::WriteFrames( const void * buffer )
+{
+  const std::string path( this->GetFileName() );
+  const int compressionLevel = this->GetCompressionLevel();
+
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const SizeValueType numberOfSlices = this->GetDimensions( dimension - 1 );
+  const SizeValueType sliceBytes = static_cast<SizeValueType>( this->GetImageSizeInBytes() ) / numberOfSlices;
+  const SizeValueType slicesPerFrame = this->m_SlicesPerFrame > 0 ? this->m_SlicesPerFrame : numberOfSlices;
+  const SizeValueType frameBytes = slicesPerFrame * sliceBytes;
+  if ( frameBytes > std::numeric_limits<uint32_t>::max() )
+  {
+    itkExceptionMacro(<< "zstd frames of " << slicesPerFrame << " slices exceed the 4 GB frame size limit");
+  }
+
+  std::ofstream outputStream;
+  this->OpenFileForWriting( outputStream, path.c_str(), true, false );
+
+  // Delta across the rows of each frame and shuffle by component size
+  WasmPrefilterParameters prefilter;
+  prefilter.prefilter = this->m_Prefilter;
+  prefilter.elementSize = static_cast<uint8_t>( this->GetComponentSize() );
+  prefilter.rowLength = static_cast<uint32_t>( this->GetDimensions( 0 ) * this->GetNumberOfComponents() );
+  if ( prefilter.prefilter != WasmPrefilterEnum::None )
+  {
+    unsigned char prefilterFrame[WasmPrefilterFrameSize];
+    writeWasmPrefilterFrame( prefilter, prefilterFrame );
+    outputStream.write( reinterpret_cast<const char *>( prefilterFrame ), WasmPrefilterFrameSize );
+  }
+
+  std::vector<uint32_t> compressedSizes;
+  std::vector<uint32_t> decompressedSizes;
+  const auto writeFrame = [&]( const std::vector<char> & compressed, size_t decompressedSize ) {
+    outputStream.write( compressed.data(), compressed.size() );
+    compressedSizes.push_back( static_cast<uint32_t>( compressed.size() ) );
+    decompressedSizes.push_back( static_cast<uint32_t>( decompressedSize ) );
+  };
+
+  // The image information, up to the data byte string head, is the first frame,
+  // so the frames decompress to the same CBOR as the unsplit format.
+  std::ostringstream headerStream;
+  this->WriteCBORHeader( headerStream, true );
+  const std::string header = headerStream.str();
+  writeFrame( compressFrame( header.data(), header.size(), compressionLevel ), header.size() );
+
+  // Frames are compressed in parallel in batches to bound the memory held
+  const auto * data = static_cast<const char *>( buffer );
+  const SizeValueType numberOfFrames = ( numberOfSlices + slicesPerFrame - 1 ) / slicesPerFrame;
+  const SizeValueType batchSize = std::max( MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), 1u );
+  std::vector<std::vector<char>> batch( batchSize );
+  for ( SizeValueType batchBegin = 0; batchBegin < numberOfFrames; batchBegin += batchSize )
+  {
+    const SizeValueType batchEnd = std::min( batchBegin + batchSize, numberOfFrames );
+    const auto frameSize = [&]( SizeValueType frame ) {
+      const SizeValueType sliceEnd = std::min( ( frame + 1 ) * slicesPerFrame, numberOfSlices );
+      return ( sliceEnd - frame * slicesPerFrame ) * sliceBytes;
+    };
+    MultiThreaderBase::New()->ParallelizeArray(
+      batchBegin,
+      batchEnd,
+      [&]( SizeValueType frame ) {
+        const char * frameData = data + frame * frameBytes;
+        std::vector<char> filtered;
+        if ( prefilter.prefilter != WasmPrefilterEnum::None )
+        {
+          filtered.resize( frameSize( frame ) );
+          applyWasmPrefilter( prefilter, frameData, filtered.data(), filtered.size() );
+          frameData = filtered.data();
+        }
+        batch[frame - batchBegin] = compressFrame( frameData, frameSize( frame ), compressionLevel );
+      },
+      nullptr );
+    for ( SizeValueType frame = batchBegin; frame < batchEnd; ++frame )
+    {
+      writeFrame( batch[frame - batchBegin], frameSize( frame ) );
+    }
+  }
+
+  // Seek table in the zstd seekable format, a skippable frame that
+  // decompressors ignore
+  const auto frameCount = static_cast<uint32_t>( compressedSizes.size() );
+  writeUInt32LE( outputStream, SkippableFrameMagicNumber );
+  writeUInt32LE( outputStream, frameCount * 8 + SeekTableFooterSize );
+  for ( uint32_t frame = 0; frame < frameCount; ++frame )
+  {
+    writeUInt32LE( outputStream, compressedSizes[frame] );
+    writeUInt32LE( outputStream, decompressedSizes[frame] );
+  }
+  writeUInt32LE( outputStream, frameCount );
+  const char seekTableDescriptor = 0;
+  outputStream.write( &seekTableDescriptor, 1 );
+  writeUInt32LE( outputStream, SeekableMagicNumber );
+
+  if ( !outputStream )
+  {
+    itkExceptionMacro(<< "Failed to write " << path);
+  }
+}
+
 } // end namespace itk
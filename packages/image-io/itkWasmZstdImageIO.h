@@ -20,6 +20,10 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkWasmImageIO.h"
+#include "itkWasmPrefilter.h"
+
+#include <string>
+#include <vector>
 
 namespace itk
 {
@@ -32,6 +36,20 @@ namespace itk
  * filesystem with JSON files and binary files for TypedArrays.
  *
  * This class extends WasmImageIO by adding support for zstandard compression.
+ * The compression level is set with SetCompressionLevel, and native builds
+ * compress with the global default number of threads.
+ *
+ * With SlicesPerFrame set, the pixel data is split into independently
+ * compressed frames along the slowest axis, followed by a seek table in the
+ * zstd seekable format. The frames still decompress to the .iwi.cbor
+ * encoding, and regions are read by decompressing only the frames that
+ * overlap them, in parallel.
+ *
+ * A Prefilter, a delta across rows and/or a byte shuffle by component size,
+ * is applied to each frame of pixel data before it is compressed, which
+ * improves the compression of e.g. 16-bit CT and MR volumes. It is recorded in
+ * a zstd skippable frame at the start of the file, and files with a prefilter
+ * are always split into frames.
  *
  * The file extensions used are .iwi, .iwi.cbor, and .iwi.cbor.zst.
  *
@@ -62,6 +80,19 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void *buffer) override;
 
+  /** Whether regions can be read, i.e. the file has a seek table. */
+  bool CanStreamRead() override;
+
+  /** Number of slices along the slowest axis per compressed frame when
+   * writing. Zero, the default, writes a single frame. */
+  itkSetMacro(SlicesPerFrame, SizeValueType);
+  itkGetConstMacro(SlicesPerFrame, SizeValueType);
+
+  /** Prefilter applied to the pixel data before compression when writing.
+   * None by default. */
+  itkSetMacro(Prefilter, WasmPrefilterEnum);
+  itkGetConstMacro(Prefilter, WasmPrefilterEnum);
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool CanWriteFile(const char *) override;
@@ -77,7 +108,38 @@ protected:
   WasmZstdImageIO();
   ~WasmZstdImageIO() override;
 
+  /** Chunks of the .iwi directory format are compressed when
+   * UseCompression is enabled. */
+  std::string GetChunkCompression() const override;
+  void ReadChunk(const std::string & fileName, const std::string & compression, void * buffer, SizeValueType numberOfBytes) override;
+  void WriteChunk(const std::string & fileName, const std::string & compression, const void * buffer, SizeValueType numberOfBytes) override;
+
 private:
+  /** Location of a frame in the file and its decompressed size. */
+  struct ZstdFrame
+  {
+    uint64_t offset{ 0 };
+    uint32_t compressedSize{ 0 };
+    uint32_t decompressedSize{ 0 };
+  };
+
+  void ReadSeekTable(std::ifstream & inputStream);
+  std::vector<char> ReadFrame(std::ifstream & inputStream, size_t frame) const;
+  void DecompressFrame(const std::vector<char> & compressed, size_t frame, unsigned char * decompressed) const;
+  void ReadFrames(void * buffer);
+  void WriteFrames(const void * buffer);
+
+  SizeValueType m_SlicesPerFrame{ 0 };
+  WasmPrefilterEnum m_Prefilter{ WasmPrefilterEnum::None };
+  /** Prefilter of the file read, from its prefilter frame. */
+  WasmPrefilterParameters m_ReadPrefilter;
+  /** Frames of a file with a seek table, the first holds the image information. */
+  std::vector<ZstdFrame> m_SeekTable;
+
+  /** Decompressed CBOR of the file read by ReadImageInformation, until it is Read. */
+  std::vector<unsigned char> m_DecompressedCBOR;
+  std::string m_DecompressedFileName;
+
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdImageIO);
 };
 } // end namespace itk
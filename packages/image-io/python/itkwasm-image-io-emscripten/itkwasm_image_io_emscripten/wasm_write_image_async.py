@@ -22,6 +22,8 @@ async def wasm_write_image_async(
     serialized_image: str,
     information_only: bool = False,
     use_compression: bool = False,
+    chunk_size: Optional[List[int]] = None,
+    resolution_levels: int = 1,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an image file format
 
@@ -37,6 +39,12 @@ async def wasm_write_image_async(
     :param use_compression: Use compression in the written file
     :type  use_compression: bool
 
+    :param chunk_size: Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension
+    :type  chunk_size: int
+
+    :param resolution_levels: Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel.
+    :type  resolution_levels: int
+
     :return: Whether the input could be written. If false, the output image is not valid.
     :rtype:  Any
     """
@@ -48,6 +56,10 @@ async def wasm_write_image_async(
         kwargs["informationOnly"] = to_js(information_only)
     if use_compression:
         kwargs["useCompression"] = to_js(use_compression)
+    if chunk_size:
+        kwargs["chunkSize"] = to_js(chunk_size)
+    if resolution_levels:
+        kwargs["resolutionLevels"] = to_js(resolution_levels)
 
     outputs = await js_module.wasmWriteImage(to_js(image), to_js(serialized_image), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -20,6 +20,7 @@ from itkwasm import (
 async def wasm_zstd_read_image_async(
     serialized_image: os.PathLike,
     information_only: bool = False,
+    resolution_level: int = 0,
 ) -> Tuple[Any, Image]:
     """Read an image file format and convert it to the itk-wasm file format
 
@@ -29,6 +30,9 @@ async def wasm_zstd_read_image_async(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param resolution_level: Resolution level of a chunked, multiscale .iwi image to read, 0 is full resolution.
+    :type  resolution_level: int
+
     :return: Whether the input could be read. If false, the output image is not valid.
     :rtype:  Any
 
@@ -41,6 +45,8 @@ async def wasm_zstd_read_image_async(
     kwargs = {}
     if information_only:
         kwargs["informationOnly"] = to_js(information_only)
+    if resolution_level:
+        kwargs["resolutionLevel"] = to_js(resolution_level)
 
     outputs = await js_module.wasmZstdReadImage(to_js(BinaryFile(serialized_image)), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -20,6 +20,7 @@ from itkwasm import (
 def wasm_zstd_read_image(
     serialized_image: os.PathLike,
     information_only: bool = False,
+    resolution_level: int = 0,
 ) -> Tuple[Any, Image]:
     """Read an image file format and convert it to the itk-wasm file format
 
@@ -29,6 +30,9 @@ def wasm_zstd_read_image(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param resolution_level: Resolution level of a chunked, multiscale .iwi image to read, 0 is full resolution.
+    :type  resolution_level: int
+
     :return: Whether the input could be read. If false, the output image is not valid.
     :rtype:  Any
 
@@ -65,6 +69,10 @@ def wasm_zstd_read_image(
     if information_only:
         args.append('--information-only')
 
+    if resolution_level:
+        args.append('--resolution-level')
+        args.append(str(resolution_level))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
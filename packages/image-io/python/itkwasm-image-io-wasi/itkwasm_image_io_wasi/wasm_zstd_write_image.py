@@ -22,6 +22,10 @@ def wasm_zstd_write_image(
     serialized_image: str,
     information_only: bool = False,
     use_compression: bool = False,
+    prefilter: str = "none",
+    compression_level: int = 3,
+    chunk_size: Optional[List[int]] = None,
+    resolution_levels: int = 1,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an image file format
 
@@ -37,6 +41,18 @@ def wasm_zstd_write_image(
     :param use_compression: Use compression in the written file
     :type  use_compression: bool
 
+    :param prefilter: Prefilter applied to the pixel data before compression: none, shuffle, delta, or delta-shuffle. Only used by the .iwi.cbor.zst format.
+    :type  prefilter: str
+
+    :param compression_level: Zstandard compression level, from 1 (fastest) to 22 (smallest)
+    :type  compression_level: int
+
+    :param chunk_size: Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension
+    :type  chunk_size: int
+
+    :param resolution_levels: Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel.
+    :type  resolution_levels: int
+
     :return: Whether the input could be written. If false, the output image is not valid.
     :rtype:  Any
     """
@@ -71,6 +87,25 @@ def wasm_zstd_write_image(
     if use_compression:
         args.append('--use-compression')
 
+    if prefilter:
+        args.append('--prefilter')
+        args.append(str(prefilter))
+
+    if compression_level:
+        args.append('--compression-level')
+        args.append(str(compression_level))
+
+    if chunk_size is not None and len(chunk_size) < 1:
+       raise ValueError('"chunk-size" kwarg must have a length > 1')
+    if chunk_size is not None and len(chunk_size) > 0:
+        args.append('--chunk-size')
+        for value in chunk_size:
+            args.append(str(value))
+
+    if resolution_levels:
+        args.append('--resolution-levels')
+        args.append(str(resolution_levels))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
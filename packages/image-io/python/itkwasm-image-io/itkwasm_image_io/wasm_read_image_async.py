@@ -12,6 +12,7 @@ from itkwasm import (
 async def wasm_read_image_async(
     serialized_image: os.PathLike,
     information_only: bool = False,
+    resolution_level: int = 0,
 ) -> Tuple[Any, Image]:
     """Read an image file format and convert it to the itk-wasm file format
 
@@ -21,6 +22,9 @@ async def wasm_read_image_async(
     :param information_only: Only read image metadata -- do not read pixel data.
     :type  information_only: bool
 
+    :param resolution_level: Resolution level of a chunked, multiscale .iwi image to read, 0 is full resolution.
+    :type  resolution_level: int
+
     :return: Whether the input could be read. If false, the output image is not valid.
     :rtype:  Any
 
@@ -28,5 +32,5 @@ async def wasm_read_image_async(
     :rtype:  Image
     """
     func = environment_dispatch("itkwasm_image_io", "wasm_read_image_async")
-    output = await func(serialized_image, information_only=information_only)
+    output = await func(serialized_image, information_only=information_only, resolution_level=resolution_level)
     return output
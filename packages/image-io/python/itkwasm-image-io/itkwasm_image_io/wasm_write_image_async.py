@@ -14,6 +14,8 @@ async def wasm_write_image_async(
     serialized_image: str,
     information_only: bool = False,
     use_compression: bool = False,
+    chunk_size: Optional[List[int]] = None,
+    resolution_levels: int = 1,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an image file format
 
@@ -29,9 +31,15 @@ async def wasm_write_image_async(
     :param use_compression: Use compression in the written file
     :type  use_compression: bool
 
+    :param chunk_size: Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension
+    :type  chunk_size: int
+
+    :param resolution_levels: Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel.
+    :type  resolution_levels: int
+
     :return: Whether the input could be written. If false, the output image is not valid.
     :rtype:  Any
     """
     func = environment_dispatch("itkwasm_image_io", "wasm_write_image_async")
-    output = await func(image, serialized_image, information_only=information_only, use_compression=use_compression)
+    output = await func(image, serialized_image, information_only=information_only, use_compression=use_compression, chunk_size=chunk_size, resolution_levels=resolution_levels)
     return output
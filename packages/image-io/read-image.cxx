@@ -82,11 +82,14 @@
 #include "itkOutputImage.h"
 
 template <typename TImageIO>
-int readImage(const std::string & inputFileName, itk::wasm::OutputTextStream & couldRead, itk::wasm::OutputImageIO & outputImageIO, bool informationOnly)
+int readImage(const std::string & inputFileName, itk::wasm::OutputTextStream & couldRead, itk::wasm::OutputImageIO & outputImageIO, bool informationOnly, unsigned int resolutionLevel)
 {
   using ImageIOType = TImageIO;
 
   auto imageIO = ImageIOType::New();
+#if IMAGE_IO_CLASS == 21 || IMAGE_IO_CLASS == 22
+  imageIO->SetResolutionLevel(resolutionLevel);
+#endif
 
   outputImageIO.SetInformationOnly(informationOnly);
 
@@ -123,54 +126,59 @@ int main (int argc, char * argv[])
   bool informationOnly = false;
   pipeline.add_flag("-i,--information-only", informationOnly, "Only read image metadata -- do not read pixel data.");
 
+  unsigned int resolutionLevel = 0;
+#if IMAGE_IO_CLASS == 21 || IMAGE_IO_CLASS == 22
+  pipeline.add_option("--resolution-level", resolutionLevel, "Resolution level of a chunked, multiscale .iwi image to read, 0 is full resolution.");
+#endif
+
   ITK_WASM_PARSE(pipeline);
 
 #if IMAGE_IO_CLASS == 0
-  return readImage<itk::PNGImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::PNGImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 1
-  return readImage<itk::MetaImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::MetaImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 2
-  return readImage<itk::TIFFImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::TIFFImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 3
-  return readImage<itk::NiftiImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::NiftiImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 4
-  return readImage<itk::JPEGImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::JPEGImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 5
-  return readImage<itk::NrrdImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::NrrdImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 6
-  return readImage<itk::VTKImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::VTKImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 7
-  return readImage<itk::BMPImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::BMPImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 8
-  return readImage<itk::HDF5ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::HDF5ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 9
-  return readImage<itk::MINCImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::MINCImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 10
-  return readImage<itk::MRCImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::MRCImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 11
-  return readImage<itk::LSMImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::LSMImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 12
-  return readImage<itk::MGHImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::MGHImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 13
-  return readImage<itk::BioRadImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::BioRadImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 14
-  return readImage<itk::GiplImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::GiplImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 15
-  return readImage<itk::GE4ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::GE4ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 16
-  return readImage<itk::GE5ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::GE5ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 17
-  return readImage<itk::GEAdwImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::GEAdwImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 18
-  return readImage<itk::GDCMImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::GDCMImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 19
-  return readImage<itk::ScancoImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::ScancoImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 20
-  return readImage<itk::FDFImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::FDFImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 21
-  return readImage<itk::WasmImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::WasmImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #elif IMAGE_IO_CLASS == 22
-  return readImage<itk::WasmZstdImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+  return readImage<itk::WasmZstdImageIO>(inputFileName, couldRead, outputImageIO, informationOnly, resolutionLevel);
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
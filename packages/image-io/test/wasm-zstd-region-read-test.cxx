@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmZstdImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <string>
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " OutputPrefix" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputPrefix = argv[1];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = uint16_t;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 23;
+  size[2] = 29;
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::SizeValueType ii = 0; ii < image->GetPixelContainer()->Size(); ++ii)
+  {
+    image->GetBufferPointer()[ii] = static_cast<PixelType>(ii * 7919);
+  }
+
+  // Starts in the middle of a frame, and only part of each row is read
+  ImageType::RegionType region;
+  region.SetIndex(0, 3);
+  region.SetIndex(1, 2);
+  region.SetIndex(2, 5);
+  region.SetSize(0, 20);
+  region.SetSize(1, 10);
+  region.SetSize(2, 11);
+
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  using ReaderType = itk::ImageFileReader<ImageType>;
+
+  // A single frame cannot be streamed
+  const std::string singleFrameFile = outputPrefix + ".single-frame.iwi.cbor.zst";
+  auto singleFrameWriter = WriterType::New();
+  singleFrameWriter->SetImageIO(itk::WasmZstdImageIO::New());
+  singleFrameWriter->SetFileName(singleFrameFile);
+  singleFrameWriter->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleFrameWriter->Update());
+  auto singleFrameIO = itk::WasmZstdImageIO::New();
+  singleFrameIO->SetFileName(singleFrameFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleFrameIO->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(!singleFrameIO->CanStreamRead());
+
+  for (const auto prefilter : { itk::WasmPrefilterEnum::None, itk::WasmPrefilterEnum::DeltaShuffle })
+  {
+    const std::string fileName = outputPrefix + ".prefilter-" + std::to_string(static_cast<int>(prefilter)) + ".iwi.cbor.zst";
+    auto writeIO = itk::WasmZstdImageIO::New();
+    writeIO->SetSlicesPerFrame(4);
+    writeIO->SetPrefilter(prefilter);
+    auto writer = WriterType::New();
+    writer->SetImageIO(writeIO);
+    writer->SetFileName(fileName);
+    writer->SetInput(image);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    auto fullReader = ReaderType::New();
+    fullReader->SetImageIO(itk::WasmZstdImageIO::New());
+    fullReader->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(fullReader->Update());
+    const ImageType * fullImage = fullReader->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(fullImage->GetBufferedRegion(), image->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_TRUE(std::equal(image->GetBufferPointer(),
+                                    image->GetBufferPointer() + image->GetPixelContainer()->Size(),
+                                    fullImage->GetBufferPointer()));
+
+    auto regionIO = itk::WasmZstdImageIO::New();
+    auto regionReader = ReaderType::New();
+    regionReader->SetImageIO(regionIO);
+    regionReader->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(regionReader->UpdateOutputInformation());
+    ITK_TEST_EXPECT_TRUE(regionIO->CanStreamRead());
+    regionReader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(regionReader->Update());
+    const ImageType * regionImage = regionReader->GetOutput();
+
+    // Only the region was read
+    ITK_TEST_EXPECT_EQUAL(regionImage->GetBufferedRegion(), region);
+    itk::ImageRegionConstIteratorWithIndex<ImageType> regionIt(regionImage, region);
+    for (; !regionIt.IsAtEnd(); ++regionIt)
+    {
+      if (regionIt.Get() != fullImage->GetPixel(regionIt.GetIndex()))
+      {
+        std::cerr << "Region pixel mismatch at " << regionIt.GetIndex() << " with prefilter "
+                  << static_cast<int>(prefilter) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
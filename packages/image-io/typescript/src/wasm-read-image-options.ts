@@ -6,6 +6,9 @@ interface WasmReadImageOptions extends WorkerPoolFunctionOption {
   /** Only read image metadata -- do not read pixel data. */
   informationOnly?: boolean
 
+  /** Resolution level of a chunked, multiscale .iwi image to read, 0 is full resolution. */
+  resolutionLevel?: number
+
 }
 
 export default WasmReadImageOptions
@@ -62,6 +62,10 @@ async function wasmReadImage(
   if (options.informationOnly) {
     options.informationOnly && args.push('--information-only')
   }
+  if (options.resolutionLevel) {
+    args.push('--resolution-level', options.resolutionLevel.toString())
+
+  }
 
   const pipelinePath = 'wasm-read-image'
 
@@ -7,6 +7,12 @@ interface WasmWriteImageNodeOptions {
   /** Use compression in the written file */
   useCompression?: boolean
 
+  /** Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension */
+  chunkSize?: number[]
+
+  /** Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel. */
+  resolutionLevels?: number
+
 }
 
 export default WasmWriteImageNodeOptions
@@ -61,6 +61,21 @@ async function wasmWriteImageNode(
   if (options.useCompression) {
     options.useCompression && args.push('--use-compression')
   }
+  if (options.chunkSize) {
+    if(options.chunkSize.length < 1) {
+      throw new Error('"chunk-size" option must have a length > 1')
+    }
+    args.push('--chunk-size')
+
+    options.chunkSize.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+  if (options.resolutionLevels) {
+    args.push('--resolution-levels', options.resolutionLevels.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'wasm-write-image')
 
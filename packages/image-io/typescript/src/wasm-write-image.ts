@@ -62,6 +62,21 @@ async function wasmWriteImage(
   if (options.useCompression) {
     options.useCompression && args.push('--use-compression')
   }
+  if (options.chunkSize) {
+    if(options.chunkSize.length < 1) {
+      throw new Error('"chunk-size" option must have a length > 1')
+    }
+    args.push('--chunk-size')
+
+    await Promise.all(options.chunkSize.map(async (value) => {
+      args.push(value.toString())
+
+    }))
+  }
+  if (options.resolutionLevels) {
+    args.push('--resolution-levels', options.resolutionLevels.toString())
+
+  }
 
   const pipelinePath = 'wasm-write-image'
 
@@ -57,6 +57,10 @@ async function wasmZstdReadImageNode(
   if (options.informationOnly) {
     options.informationOnly && args.push('--information-only')
   }
+  if (options.resolutionLevel) {
+    args.push('--resolution-level', options.resolutionLevel.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'wasm-zstd-read-image')
 
@@ -62,6 +62,10 @@ async function wasmZstdReadImage(
   if (options.informationOnly) {
     options.informationOnly && args.push('--information-only')
   }
+  if (options.resolutionLevel) {
+    args.push('--resolution-level', options.resolutionLevel.toString())
+
+  }
 
   const pipelinePath = 'wasm-zstd-read-image'
 
@@ -7,6 +7,18 @@ interface WasmZstdWriteImageNodeOptions {
   /** Use compression in the written file */
   useCompression?: boolean
 
+  /** Prefilter applied to the pixel data before compression: none, shuffle, delta, or delta-shuffle. Only used by the .iwi.cbor.zst format. */
+  prefilter?: string
+
+  /** Zstandard compression level, from 1 (fastest) to 22 (smallest) */
+  compressionLevel?: number
+
+  /** Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension */
+  chunkSize?: number[]
+
+  /** Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel. */
+  resolutionLevels?: number
+
 }
 
 export default WasmZstdWriteImageNodeOptions
@@ -61,6 +61,29 @@ async function wasmZstdWriteImageNode(
   if (options.useCompression) {
     options.useCompression && args.push('--use-compression')
   }
+  if (options.prefilter) {
+    args.push('--prefilter', options.prefilter.toString())
+
+  }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.chunkSize) {
+    if(options.chunkSize.length < 1) {
+      throw new Error('"chunk-size" option must have a length > 1')
+    }
+    args.push('--chunk-size')
+
+    options.chunkSize.forEach((value) => {
+      args.push(value.toString())
+
+    })
+  }
+  if (options.resolutionLevels) {
+    args.push('--resolution-levels', options.resolutionLevels.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'wasm-zstd-write-image')
 
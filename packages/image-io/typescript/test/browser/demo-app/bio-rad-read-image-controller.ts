@@ -56,6 +56,11 @@ class BioRadReadImageController {
         model.options.set("informationOnly", informationOnlyElement.checked)
     })
 
+    const resolutionLevelElement = document.querySelector('#bioRadReadImageInputs sl-input[name=resolution-level]')
+    resolutionLevelElement.addEventListener('sl-change', (event) => {
+        model.options.set("resolutionLevel", parseInt(resolutionLevelElement.value))
+    })
+
     // ----------------------------------------------
     // Outputs
     const couldReadOutputDownload = document.querySelector('#bioRadReadImageOutputs sl-button[name=could-read-download]')
@@ -57,6 +57,11 @@ class BmpReadImageController {
         model.options.set("informationOnly", informationOnlyElement.checked)
     })
 
+    const resolutionLevelElement = document.querySelector('#bmpReadImageInputs sl-input[name=resolution-level]')
+    resolutionLevelElement.addEventListener('sl-change', (event) => {
+        model.options.set("resolutionLevel", parseInt(resolutionLevelElement.value))
+    })
+
     // ----------------------------------------------
     // Outputs
     const couldReadOutputDownload = document.querySelector('#bmpReadImageOutputs sl-button[name=could-read-download]')
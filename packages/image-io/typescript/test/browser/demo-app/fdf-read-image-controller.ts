@@ -58,6 +58,11 @@ class FdfReadImageController {
         model.options.set("informationOnly", informationOnlyElement.checked)
     })
 
+    const resolutionLevelElement = document.querySelector('#fdfReadImageInputs sl-input[name=resolution-level]')
+    resolutionLevelElement.addEventListener('sl-change', (event) => {
+        model.options.set("resolutionLevel", parseInt(resolutionLevelElement.value))
+    })
+
     // ----------------------------------------------
     // Outputs
     const couldReadOutputDownload = document.querySelector('#fdfReadImageOutputs sl-button[name=could-read-download]')
@@ -57,6 +57,11 @@ class GeAdwReadImageController {
         model.options.set("informationOnly", informationOnlyElement.checked)
     })
 
+    const resolutionLevelElement = document.querySelector('#geAdwReadImageInputs sl-input[name=resolution-level]')
+    resolutionLevelElement.addEventListener('sl-change', (event) => {
+        model.options.set("resolutionLevel", parseInt(resolutionLevelElement.value))
+    })
+
     // ----------------------------------------------
     // Outputs
     const couldReadOutputDownload = document.querySelector('#geAdwReadImageOutputs sl-button[name=could-read-download]')
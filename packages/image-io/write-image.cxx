@@ -84,7 +84,7 @@
 #include "itkImageIOBase.h"
 
 template <typename TImageIO>
-int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression)
+int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, const std::string & prefilter, int compressionLevel, const std::vector<itk::SizeValueType> & chunkSize, unsigned int numberOfResolutionLevels)
 {
   using ImageIOType = TImageIO;
 
@@ -102,22 +102,35 @@ int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStre
 
   imageIO->SetFileName(outputFileName);
   imageIO->SetUseCompression(useCompression);
+#if IMAGE_IO_CLASS == 22
+  imageIO->SetPrefilter(itk::wasmPrefilterFromString(prefilter));
+  imageIO->SetCompressionLevel(compressionLevel);
+#endif
 
   const itk::WasmImageIOBase * inputWasmImageIOBase = inputImageIO.Get();
   const itk::ImageIOBase * inputImageIOBase = inputWasmImageIOBase->GetImageIO();
 
   const unsigned int dimension = inputImageIOBase->GetNumberOfDimensions();
+#if IMAGE_IO_CLASS == 21 || IMAGE_IO_CLASS == 22
+  if (chunkSize.size() > 1 && chunkSize.size() != dimension)
+  {
+    std::cerr << "The chunk size has " << chunkSize.size() << " values, but the image has " << dimension << " dimensions" << std::endl;
+    return EXIT_FAILURE;
+  }
+  imageIO->SetChunkSize(chunkSize);
+  imageIO->SetNumberOfResolutionLevels(numberOfResolutionLevels);
+#endif
   imageIO->SetNumberOfDimensions(dimension);
   imageIO->SetComponentType(inputImageIOBase->GetComponentType());
   imageIO->SetNumberOfComponents(inputImageIOBase->GetNumberOfComponents());
   imageIO->SetPixelType(inputImageIOBase->GetPixelType());
   std::vector<double> direction(dimension);
-  const auto directionContainer = inputWasmImageIOBase->GetDirectionContainer();
+  const double * directionData = inputWasmImageIOBase->GetDirectionData();
   for (unsigned int dim = 0; dim < dimension; ++dim)
   {
     for (unsigned int dd = 0; dd < dimension; ++dd)
     {
-      direction[dd] = directionContainer->GetElement(dim + dimension*dd);
+      direction[dd] = directionData[dim + dimension*dd];
     }
     imageIO->SetDirection(dim, direction);
     imageIO->SetOrigin(dim, inputImageIOBase->GetOrigin(dim));
@@ -134,7 +147,7 @@ int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStre
   imageIO->WriteImageInformation();
   if (!informationOnly)
   {
-    imageIO->Write( reinterpret_cast< const void * >( &(inputWasmImageIOBase->GetPixelDataContainer()->at(0)) ));
+    imageIO->Write( reinterpret_cast< const void * >( inputWasmImageIOBase->GetPixelData() ));
   }
 
   return EXIT_SUCCESS;
@@ -161,54 +174,69 @@ int main (int argc, char * argv[])
   bool useCompression = false;
   pipeline.add_flag("-c,--use-compression", useCompression, "Use compression in the written file");
 
+  std::string prefilter("none");
+  int compressionLevel = 3;
+#if IMAGE_IO_CLASS == 22
+  // The blank validator description keeps the interface type TEXT
+  pipeline.add_option("--prefilter", prefilter, "Prefilter applied to the pixel data before compression: none, shuffle, delta, or delta-shuffle. Only used by the .iwi.cbor.zst format.")->check(CLI::IsMember({"none", "shuffle", "delta", "delta-shuffle"}).description(""));
+  pipeline.add_option("--compression-level", compressionLevel, "Zstandard compression level, from 1 (fastest) to 22 (smallest)");
+#endif
+
+  std::vector<itk::SizeValueType> chunkSize;
+  unsigned int numberOfResolutionLevels = 1;
+#if IMAGE_IO_CLASS == 21 || IMAGE_IO_CLASS == 22
+  pipeline.add_option("--chunk-size", chunkSize, "Write a chunked .iwi directory with this chunk size, one value for all dimensions or one per dimension");
+  pipeline.add_option("--resolution-levels", numberOfResolutionLevels, "Number of resolution levels of a chunked image, from 1 to 32. Level l samples every 2^l-th pixel.");
+#endif
+
   ITK_WASM_PARSE(pipeline);
 
 #if IMAGE_IO_CLASS == 0
-  return writeImage<itk::PNGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::PNGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 1
-  return writeImage<itk::MetaImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MetaImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 2
-  return writeImage<itk::TIFFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::TIFFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 3
-  return writeImage<itk::NiftiImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::NiftiImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 4
-  return writeImage<itk::JPEGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::JPEGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 5
-  return writeImage<itk::NrrdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::NrrdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 6
-  return writeImage<itk::VTKImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::VTKImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 7
-  return writeImage<itk::BMPImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::BMPImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 8
-  return writeImage<itk::HDF5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::HDF5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 9
-  return writeImage<itk::MINCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MINCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 10
-  return writeImage<itk::MRCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MRCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 11
-  return writeImage<itk::LSMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::LSMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 12
-  return writeImage<itk::MGHImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MGHImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 13
-  return writeImage<itk::BioRadImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::BioRadImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 14
-  return writeImage<itk::GiplImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GiplImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 15
-  return writeImage<itk::GE4ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GE4ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 16
-  return writeImage<itk::GE5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GE5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 17
-  return writeImage<itk::GEAdwImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GEAdwImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 18
-  return writeImage<itk::GDCMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GDCMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 19
-  return writeImage<itk::ScancoImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::ScancoImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 20
-  return writeImage<itk::FDFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::FDFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 21
-  return writeImage<itk::WasmImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::WasmImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #elif IMAGE_IO_CLASS == 22
-  return writeImage<itk::WasmZstdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::WasmZstdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, prefilter, compressionLevel, chunkSize, numberOfResolutionLevels);
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
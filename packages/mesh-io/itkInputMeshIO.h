@@ -25,6 +25,7 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
+#include "itkWasmDescriptor.h"
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #endif
@@ -74,7 +75,7 @@ bool lexical_cast(const std::string &input, InputMeshIO &inputMeshIO)
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
     auto json = getMemoryStoreInputJSON(0, index);
-    auto        deserializedAttempt = glz::read_json<itk::MeshJSON>(json);
+    auto        deserializedAttempt = readDescriptor<itk::MeshJSON>(json);
     if (!deserializedAttempt)
     {
       const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -89,22 +90,19 @@ bool lexical_cast(const std::string &input, InputMeshIO &inputMeshIO)
 
     auto wasmMeshIOBase = itk::WasmMeshIOBase::New();
 
-    const std::string & pointsString = meshJSON.points;
-    const char * pointsPtr = reinterpret_cast< char * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
+    const char * pointsPtr = descriptorArrayPointer<char>(meshJSON.points);
     WasmMeshIOBase::DataContainerType * pointsContainer = wasmMeshIOBase->GetPointsContainer();
     SizeValueType numberOfBytes = wasmMeshIO->GetNumberOfPoints() * wasmMeshIO->GetPointDimension() * ITKComponentSize( wasmMeshIO->GetPointComponentType() );
     pointsContainer->resize(numberOfBytes);
     pointsContainer->assign(pointsPtr, pointsPtr + numberOfBytes);
 
-    const std::string & cellsString = meshJSON.cells;
-    const char * cellsPtr = reinterpret_cast< char * >( std::strtoull(cellsString.substr(35).c_str(), nullptr, 10) );
+    const char * cellsPtr = descriptorArrayPointer<char>(meshJSON.cells);
     WasmMeshIOBase::DataContainerType * cellsContainer = wasmMeshIOBase->GetCellsContainer();
     numberOfBytes = static_cast< SizeValueType >( wasmMeshIO->GetCellBufferSize() * ITKComponentSize( wasmMeshIO->GetCellComponentType() ));
     cellsContainer->resize(numberOfBytes);
     cellsContainer->assign(cellsPtr, cellsPtr + numberOfBytes);
 
-    const std::string & pointDataString = meshJSON.pointData;
-    const char * pointDataPtr = reinterpret_cast< char * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
+    const char * pointDataPtr = descriptorArrayPointer<char>(meshJSON.pointData);
     WasmMeshIOBase::DataContainerType * pointDataContainer = wasmMeshIOBase->GetPointDataContainer();
     numberOfBytes =
       static_cast< SizeValueType >(
@@ -113,8 +111,7 @@ bool lexical_cast(const std::string &input, InputMeshIO &inputMeshIO)
     pointDataContainer->resize(numberOfBytes);
     pointDataContainer->assign(pointDataPtr, pointDataPtr + numberOfBytes);
 
-    const std::string & cellDataString = meshJSON.cellData;
-    const char * cellDataPtr = reinterpret_cast< char * >( std::strtoull(cellDataString.substr(35).c_str(), nullptr, 10) );
+    const char * cellDataPtr = descriptorArrayPointer<char>(meshJSON.cellData);
     WasmMeshIOBase::DataContainerType * cellDataContainer = wasmMeshIOBase->GetCellDataContainer();
     numberOfBytes =
       static_cast< SizeValueType >(
@@ -83,6 +83,7 @@ namespace itk
           {
             const auto index = std::stoi(this->m_Identifier);
             auto wasmMeshIOBase = itk::WasmMeshIOBase::New();
+            wasmMeshIOBase->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
             wasmMeshIOBase->SetMeshIO(this->m_MeshIO);
             setMemoryStoreOutputDataObject(0, index, wasmMeshIOBase);
 
@@ -19,6 +19,7 @@
 
 #include "itkWasmMeshIO.h"
 #include "itkWasmIOCommon.h"
+#include "itkWasmDescriptor.h"
 
 #include <sstream>
 
@@ -72,10 +73,7 @@ WasmMeshIOBase::SetMeshIO(MeshIOBase * meshIO, bool readMesh)
     pointsAddress = reinterpret_cast< size_t >( &(this->m_PointsContainer->at(0)) );
   }
 
-  std::ostringstream dataStream;
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << pointsAddress;
-  meshJSON.points = dataStream.str();
+  meshJSON.points = static_cast<uint64_t>(pointsAddress);
 
   numberOfBytes = static_cast< SizeValueType >( meshIO->GetCellBufferSize() * ITKComponentSize( meshIO->GetCellComponentType() ));
 
@@ -87,10 +85,7 @@ WasmMeshIOBase::SetMeshIO(MeshIOBase * meshIO, bool readMesh)
     cellsAddress = reinterpret_cast< size_t >( &(this->m_CellsContainer->at(0)) );
   }
 
-  dataStream.str("");
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << cellsAddress;
-  meshJSON.cells = dataStream.str();
+  meshJSON.cells = static_cast<uint64_t>(cellsAddress);
 
   numberOfBytes =
     static_cast< SizeValueType >( meshIO->GetNumberOfPointPixels() * meshIO->GetNumberOfPointPixelComponents() * ITKComponentSize( meshIO->GetPointPixelComponentType() ));
@@ -103,10 +98,7 @@ WasmMeshIOBase::SetMeshIO(MeshIOBase * meshIO, bool readMesh)
     pointDataAddress = reinterpret_cast< size_t >( &(this->m_PointDataContainer->at(0)) );
   }
 
-  dataStream.str("");
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << pointDataAddress;
-  meshJSON.pointData = dataStream.str();
+  meshJSON.pointData = static_cast<uint64_t>(pointDataAddress);
 
   numberOfBytes =
     static_cast< SizeValueType >( meshIO->GetNumberOfCellPixels() * meshIO->GetNumberOfCellPixelComponents() * ITKComponentSize( meshIO->GetCellPixelComponentType() ));
@@ -119,13 +111,10 @@ WasmMeshIOBase::SetMeshIO(MeshIOBase * meshIO, bool readMesh)
     cellDataAddress = reinterpret_cast< size_t >( &(this->m_CellDataContainer->at(0)) );
   }
 
-  dataStream.str("");
-  dataStream << "data:application/vnd.itk.address,0:";
-  dataStream << cellDataAddress;
-  meshJSON.cellData = dataStream.str();
+  meshJSON.cellData = static_cast<uint64_t>(cellDataAddress);
 
   std::string serialized{};
-  auto ec = glz::write<glz::opts{ .prettify = true }>(meshJSON, serialized);
+  auto ec = writeDescriptor(meshJSON, serialized, this->m_BinaryDescriptor);
   if (ec)
   {
     itkExceptionMacro("Failed to serialize TransformListJSON");
@@ -21,6 +21,8 @@
 
 #include "itkWasmIOCommon.h"
 
+#include <sstream>
+
 namespace itk
 {
 
@@ -82,12 +84,13 @@ WasmZstdMeshIO
     auto inputBinary = ostrm.str();
 
     const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+    this->m_DecompressedCBOR.resize(decompressedBufferSize);
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
+    const size_t decompressedSize = ZSTD_decompress(this->m_DecompressedCBOR.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
+    this->m_DecompressedCBOR.resize(decompressedSize);
 
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+    // The buffers are read from the decompressed encoding, which is kept
+    this->ReadCBOR(nullptr, this->m_DecompressedCBOR.data(), decompressedSize);
     return;
   }
 
@@ -123,6 +126,24 @@ WasmZstdMeshIO
 }
 
 
+std::unique_ptr<std::ostream>
+WasmZstdMeshIO
+::CreateCBOROutputStream()
+{
+  const std::string path(this->GetFileName());
+
+  std::string::size_type cborPos = path.rfind(".zst");
+  if ( ( cborPos != std::string::npos )
+       && ( cborPos == path.length() - 4 ) )
+  {
+    // Compressed in Write()
+    return std::make_unique<std::ostringstream>();
+  }
+
+  return Superclass::CreateCBOROutputStream();
+}
+
+
 void
 WasmZstdMeshIO
 ::Write()
@@ -133,17 +154,21 @@ WasmZstdMeshIO
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 4 ) )
   {
-    unsigned char* cborBuffer;
-    size_t cborBufferSize;
-    size_t length = cbor_serialize_alloc(this->m_CBORRoot, &cborBuffer, &cborBufferSize);
+    // Completes the CBOR encoding when there are no data buffers
+    this->GetCBOROutputStream();
+    if (this->m_PendingCBORBuffers != 0)
+    {
+      itkExceptionMacro(<< "Missing " << this->m_PendingCBORBuffers << " data buffers for " << path);
+    }
+    const std::string cborBuffer = static_cast<std::ostringstream *>(this->m_CBOROutputStream.get())->str();
+    this->m_CBOROutputStream.reset();
+    const size_t cborBufferSize = cborBuffer.size();
 
     const size_t compressedBufferSize = ZSTD_compressBound(cborBufferSize);
     std::vector<char> compressedBinary(compressedBufferSize);
 
     constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, cborBuffer, cborBufferSize, compressionLevel);
-    free(cborBuffer);
-    cbor_decref(&(this->m_CBORRoot));
+    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, cborBuffer.data(), cborBufferSize, compressionLevel);
 
     compressedBinary.resize(compressedSize);
 
@@ -21,6 +21,8 @@
 
 #include "itkWasmMeshIO.h"
 
+#include <vector>
+
 namespace itk
 {
 /** \class WasmZstdMeshIO
@@ -69,6 +71,11 @@ protected:
   WasmZstdMeshIO();
   ~WasmZstdMeshIO() override;
 
+  std::unique_ptr<std::ostream> CreateCBOROutputStream() override;
+
+  /** Decompressed CBOR encoding the buffers are read from. */
+  std::vector<unsigned char> m_DecompressedCBOR;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdMeshIO);
 };
@@ -24,6 +24,7 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
+#include "itkWasmDescriptor.h"
 #endif
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
 #endif
@@ -83,7 +84,7 @@ bool lexical_cast(const std::string &input, InputTransformIO<TParametersValueTyp
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
     auto json = getMemoryStoreInputJSON(0, index);
-    auto        deserializedAttempt = glz::read_json<itk::TransformListJSON>(json);
+    auto        deserializedAttempt = readDescriptor<itk::TransformListJSON>(json);
     if (!deserializedAttempt)
     {
       const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
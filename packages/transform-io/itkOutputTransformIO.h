@@ -53,12 +53,12 @@ addTransformBuffersToMemoryStore(const itk::TransformListJSON & transformListJSO
     {
       continue;
     }
-    const auto fixedParamsAddress = static_cast< size_t >( std::strtoull(transformJSON.fixedParameters.substr(35).c_str(), nullptr, 10) );
+    const auto fixedParamsAddress = itk::descriptorArrayAddress(transformJSON.fixedParameters);
     const auto fixedParamsSize = transformJSON.numberOfFixedParameters * sizeof(FixedParametersValueType);
     itk::wasm::setMemoryStoreOutputArray(0, index, dataCount, fixedParamsAddress, fixedParamsSize);
     ++dataCount;
 
-    const auto paramsAddress = static_cast< size_t >( std::strtoull(transformJSON.parameters.substr(35).c_str(), nullptr, 10) );
+    const auto paramsAddress = itk::descriptorArrayAddress(transformJSON.parameters);
     const auto paramsSize = transformJSON.numberOfParameters * sizeof(ParametersValueType);
     itk::wasm::setMemoryStoreOutputArray(0, index, dataCount, paramsAddress, paramsSize);
     ++dataCount;
@@ -115,6 +115,7 @@ public:
     {
       const auto index = std::stoi(this->m_Identifier);
       auto wasmTransformIOBase = WasmTransformIOBase<ParametersValueType>::New();
+      wasmTransformIOBase->SetBinaryDescriptor(wasm::Pipeline::get_use_binary_descriptors());
       wasmTransformIOBase->SetTransformIO(this->m_TransformIO);
       setMemoryStoreOutputDataObject(0, index, wasmTransformIOBase);
 
@@ -24,6 +24,7 @@
 #include "itkWasmDataObject.h"
 #include "itkTransformJSON.h"
 #include "itkWasmTransformIO.h"
+#include "itkWasmDescriptor.h"
 
 namespace itk
 {
@@ -84,7 +85,7 @@ public:
     auto transformJSON = wasmTransformIO->GetJSON(inMemory);
 
     std::string serialized{};
-    auto ec = glz::write<glz::opts{ .prettify = true }>(transformJSON, serialized);
+    auto ec = writeDescriptor(transformJSON, serialized, this->m_BinaryDescriptor);
     if (ec)
     {
       itkExceptionMacro("Failed to serialize TransformListJSON");
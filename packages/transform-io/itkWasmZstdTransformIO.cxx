@@ -21,6 +21,8 @@
 #include "zstd.h"
 #include "itkWasmIOCommon.h"
 
+#include <sstream>
+
 namespace itk
 {
 
@@ -136,15 +138,16 @@ WasmZstdTransformIOTemplate<TParametersValueType>
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 4 ) )
   {
-    unsigned char * inputBinary;
-    const size_t inputBinarySize = this->WriteCBOR(nullptr, &inputBinary, true);
+    std::ostringstream cborStream;
+    this->WriteCBOR(cborStream);
+    const std::string inputBinary = cborStream.str();
+    const size_t inputBinarySize = inputBinary.size();
 
     const size_t compressedBufferSize = ZSTD_compressBound(inputBinarySize);
     std::vector<char> compressedBinary(compressedBufferSize);
 
     constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary, inputBinarySize, compressionLevel);
-    free(inputBinary);
+    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinarySize, compressionLevel);
     compressedBinary.resize(compressedSize);
 
     std::ofstream outputStream;
@@ -71,7 +71,7 @@ function(add_executable target)
       _target_link_libraries(${target} PRIVATE $<$<LINK_LANGUAGE:CXX>:wasi-itk-extras>)
       get_property(_link_flags TARGET ${wasm_target} PROPERTY LINK_FLAGS)
       set_property(TARGET ${wasm_target} PROPERTY LINK_FLAGS
-        "-mexec-model=reactor -Wl,--export-if-defined=itk_wasm_input_array_alloc -Wl,--export-if-defined=itk_wasm_input_json_alloc -Wl,--export-if-defined=itk_wasm_output_json_address -Wl,--export-if-defined=itk_wasm_output_json_size -Wl,--export-if-defined=itk_wasm_output_array_address -Wl,--export-if-defined=itk_wasm_output_array_size -Wl,--export-if-defined=itk_wasm_free_all -Wl,--export-if-defined=_start -Wl,--export-if-defined=itk_wasm_delayed_start -Wl,--export-if-defined=itk_wasm_delayed_exit ${_link_flags}")
+        "-mexec-model=reactor -Wl,--export-if-defined=itk_wasm_input_array_alloc -Wl,--export-if-defined=itk_wasm_input_json_alloc -Wl,--export-if-defined=itk_wasm_output_array_alloc -Wl,--export-if-defined=itk_wasm_output_json_address -Wl,--export-if-defined=itk_wasm_output_json_size -Wl,--export-if-defined=itk_wasm_output_metadata_address -Wl,--export-if-defined=itk_wasm_output_metadata_size -Wl,--export-if-defined=itk_wasm_output_array_address -Wl,--export-if-defined=itk_wasm_output_array_size -Wl,--export-if-defined=itk_wasm_memory_high_water_mark -Wl,--export-if-defined=itk_wasm_descriptor_encodings -Wl,--export-if-defined=itk_wasm_progress_address -Wl,--export-if-defined=itk_wasm_input_release -Wl,--export-if-defined=itk_wasm_output_release -Wl,--export-if-defined=itk_wasm_free_all -Wl,--export-if-defined=_start -Wl,--export-if-defined=itk_wasm_delayed_start -Wl,--export-if-defined=itk_wasm_delayed_exit ${_link_flags}")
       if(NOT ITK_WASM_NO_INTERFACE_LINK)
         if(NOT TARGET WebAssemblyInterface)
           find_package(ITK QUIET COMPONENTS WebAssemblyInterface)
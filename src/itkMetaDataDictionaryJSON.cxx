@@ -17,231 +17,129 @@
  *=========================================================================*/
 #include "itkMetaDataDictionaryJSON.h"
 
+#include <typeindex>
+#include <unordered_map>
+
 namespace itk
 {
 
-void
-metaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, MetadataJSON & metaDataJSON)
+namespace
 {
-  metaDataJSON.clear();
 
-  auto itr = dictionary.Begin();
-  auto end = dictionary.End();
-  while (itr != end)
+using MetaDataToJSONFunction = glz::json_t (*)(const MetaDataObjectBase *);
+
+template <typename T>
+const T &
+metaDataValue(const MetaDataObjectBase * entry)
+{
+  return static_cast<const MetaDataObject<T> *>(entry)->GetMetaDataObjectValue();
+}
+
+// bool, double, std::string
+template <typename T>
+glz::json_t
+valueToJSON(const MetaDataObjectBase * entry)
+{
+  return metaDataValue<T>(entry);
+}
+
+// Additional integral types are represented as double
+template <typename T>
+glz::json_t
+numberToJSON(const MetaDataObjectBase * entry)
+{
+  return static_cast<double>(metaDataValue<T>(entry));
+}
+
+// std::vector and itk::Array
+template <typename T>
+glz::json_t
+arrayToJSON(const MetaDataObjectBase * entry)
+{
+  const T & value = metaDataValue<T>(entry);
+  return glz::json_t::array_t(value.begin(), value.end());
+}
+
+glz::json_t
+vectorVectorDoubleToJSON(const MetaDataObjectBase * entry)
+{
+  const auto & value = metaDataValue<std::vector<std::vector<double>>>(entry);
+  glz::json_t::array_t valueDouble;
+  for (const auto & v : value)
+  {
+    valueDouble.push_back(glz::json_t::array_t(v.begin(), v.end()));
+  }
+  return valueDouble;
+}
+
+template <typename TMatrix>
+glz::json_t
+matrixToJSON(const MetaDataObjectBase * entry)
+{
+  const TMatrix & value = metaDataValue<TMatrix>(entry);
+  glz::json_t::array_t valueDouble;
+  for (unsigned int i = 0; i < TMatrix::RowDimensions; ++i)
   {
+    valueDouble.push_back(glz::json_t::array_t(value[i], value[i] + TMatrix::ColumnDimensions));
+  }
+  return valueDouble;
+}
+
+// Conversion by the dynamic type of a MetaDataObject. A single hash lookup
+// replaces a chain of dynamic_cast attempts per entry.
+const std::unordered_map<std::type_index, MetaDataToJSONFunction> &
+metaDataToJSONFunctions()
+{
+  static const std::unordered_map<std::type_index, MetaDataToJSONFunction> functions{
     // glaze types
-    using MetaDataBoolType = MetaDataObject<bool>;
-    using MetaDataDoubleType = MetaDataObject<double>;
-    using MetaDataStringType = MetaDataObject<std::string>;
-    using MetaDataVectorDoubleType = MetaDataObject<std::vector<double>>;
-    using MetaDataVectorStringType = MetaDataObject<std::vector<std::string>>;
-    using MetaDataVectorVectorDoubleType = MetaDataObject<std::vector<std::vector<double>>>;
+    { typeid(MetaDataObject<bool>), &valueToJSON<bool> },
+    { typeid(MetaDataObject<double>), &valueToJSON<double> },
+    { typeid(MetaDataObject<std::string>), &valueToJSON<std::string> },
+    { typeid(MetaDataObject<std::vector<double>>), &arrayToJSON<std::vector<double>> },
+    { typeid(MetaDataObject<std::vector<std::string>>), &arrayToJSON<std::vector<std::string>> },
+    { typeid(MetaDataObject<std::vector<std::vector<double>>>), &vectorVectorDoubleToJSON },
 
     // Additional ITK used MetaDataDictionary types
     // see ITK/Modules/Core/Common/src/itkMetaDataObject.cxx
-    using MetaDataUcharType = MetaDataObject<unsigned char>;
-    using MetaDataCharType = MetaDataObject<char>;
-    using MetaDataSignedCharType = MetaDataObject<signed char>;
-    using MetaDataUshortType = MetaDataObject<unsigned short>;
-    using MetaDataShortType = MetaDataObject<short>;
-    using MetaDataUlongType = MetaDataObject<unsigned long>;
-    using MetaDataLongType = MetaDataObject<long>;
-    using MetaDataUlongLongType = MetaDataObject<unsigned long long>;
-    using MetaDataLongLongType = MetaDataObject<long long>;
-    using MetaDataArrayCharType = MetaDataObject<Array<char>>;
-    using MetaDataArrayIntType = MetaDataObject<Array<int>>;
-    using MetaDataArrayFloatType = MetaDataObject<Array<float>>;
-    using MetaDataArrayDoubleType = MetaDataObject<Array<double>>;
-    using MetaDataMatrixFloat44Type = MetaDataObject<Matrix<float, 4, 4>>;
-    using MetaDataMatrixDoubleType = MetaDataObject<Matrix<double>>;
-
-    MetaDataObjectBase::Pointer entry = itr->second;
-    const std::string key = itr->first;
-
-    const auto boolValue = dynamic_cast<MetaDataBoolType *>(entry.GetPointer());
-    if (boolValue)
-    {
-      const bool value = boolValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, value });
-      ++itr;
-      continue;
-    }
-    const auto doubleValue = dynamic_cast<MetaDataDoubleType *>(entry.GetPointer());
-    if (doubleValue)
-    {
-      const double value = doubleValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, value });
-      ++itr;
-      continue;
-    }
-    const auto stringValue = dynamic_cast<MetaDataStringType *>(entry.GetPointer());
-    if (stringValue)
-    {
-      const std::string value = stringValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, value });
-      ++itr;
-      continue;
-    }
+    { typeid(MetaDataObject<unsigned char>), &numberToJSON<unsigned char> },
+    { typeid(MetaDataObject<char>), &numberToJSON<char> },
+    { typeid(MetaDataObject<signed char>), &numberToJSON<signed char> },
+    { typeid(MetaDataObject<unsigned short>), &numberToJSON<unsigned short> },
+    { typeid(MetaDataObject<short>), &numberToJSON<short> },
+    { typeid(MetaDataObject<unsigned long>), &numberToJSON<unsigned long> },
+    { typeid(MetaDataObject<long>), &numberToJSON<long> },
+    { typeid(MetaDataObject<unsigned long long>), &numberToJSON<unsigned long long> },
+    { typeid(MetaDataObject<long long>), &numberToJSON<long long> },
+    { typeid(MetaDataObject<Array<char>>), &arrayToJSON<Array<char>> },
+    { typeid(MetaDataObject<Array<float>>), &arrayToJSON<Array<float>> },
+    { typeid(MetaDataObject<Array<double>>), &arrayToJSON<Array<double>> },
+    { typeid(MetaDataObject<Matrix<float, 4, 4>>), &matrixToJSON<Matrix<float, 4, 4>> },
+    { typeid(MetaDataObject<Matrix<double>>), &matrixToJSON<Matrix<double>> },
+  };
+  return functions;
+}
 
-    const auto doubleVectorValue = dynamic_cast<MetaDataVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorValue)
-    {
-      const std::vector<double> value = doubleVectorValue->GetMetaDataObjectValue();
-      const glz::json_t::array_t valueDouble(value.begin(), value.end());
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
-    }
-    const auto stringVectorValue = dynamic_cast<MetaDataVectorStringType *>(entry.GetPointer());
-    if (stringVectorValue)
-    {
-      const std::vector<std::string> value = stringVectorValue->GetMetaDataObjectValue();
-      const glz::json_t::array_t valueString(value.begin(), value.end());
-      metaDataJSON.push_back({ key, valueString });
-      ++itr;
-      continue;
-    }
+} // end anonymous namespace
 
-    const auto doubleVectorVectorValue = dynamic_cast<MetaDataVectorVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorVectorValue)
-    {
-      const std::vector<std::vector<double>> value = doubleVectorVectorValue->GetMetaDataObjectValue();
-      glz::json_t::array_t valueDouble;
-      for (const auto & v : value)
-      {
-        valueDouble.push_back(glz::json_t::array_t(v.begin(), v.end()));
-      }
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
-    }
+void
+metaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, MetadataJSON & metaDataJSON)
+{
+  metaDataJSON.clear();
 
-    const auto ucharValue = dynamic_cast<MetaDataUcharType *>(entry.GetPointer());
-    if (ucharValue)
-    {
-      const unsigned char value = ucharValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto charValue = dynamic_cast<MetaDataCharType *>(entry.GetPointer());
-    if (charValue)
-    {
-      const char value = charValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto signedCharValue = dynamic_cast<MetaDataSignedCharType *>(entry.GetPointer());
-    if (signedCharValue)
-    {
-      const signed char value = signedCharValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto ushortValue = dynamic_cast<MetaDataUshortType *>(entry.GetPointer());
-    if (ushortValue)
-    {
-      const unsigned short value = ushortValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto shortValue = dynamic_cast<MetaDataShortType *>(entry.GetPointer());
-    if (shortValue)
-    {
-      const short value = shortValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto ulongValue = dynamic_cast<MetaDataUlongType *>(entry.GetPointer());
-    if (ulongValue)
-    {
-      const unsigned long value = ulongValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto longValue = dynamic_cast<MetaDataLongType *>(entry.GetPointer());
-    if (longValue)
-    {
-      const long value = longValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto ulongLongValue = dynamic_cast<MetaDataUlongLongType *>(entry.GetPointer());
-    if (ulongLongValue)
-    {
-      const unsigned long long value = ulongLongValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto longLongValue = dynamic_cast<MetaDataLongLongType *>(entry.GetPointer());
-    if (longLongValue)
-    {
-      const long long value = longLongValue->GetMetaDataObjectValue();
-      metaDataJSON.push_back({ key, static_cast<double>(value) });
-      ++itr;
-      continue;
-    }
-    const auto arrayCharValue = dynamic_cast<MetaDataArrayCharType *>(entry.GetPointer());
-    if (arrayCharValue)
-    {
-      const Array<char> valueArray = arrayCharValue->GetMetaDataObjectValue();
-      const glz::json_t::array_t valueDouble(valueArray.begin(), valueArray.end());
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
-    }
-    const auto arrayFloatValue = dynamic_cast<MetaDataArrayFloatType *>(entry.GetPointer());
-    if (arrayFloatValue)
-    {
-      const Array<float> valueArray = arrayFloatValue->GetMetaDataObjectValue();
-      const glz::json_t::array_t valueDouble(valueArray.begin(), valueArray.end());
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
-    }
-    const auto arrayDoubleValue = dynamic_cast<MetaDataArrayDoubleType *>(entry.GetPointer());
-    if (arrayDoubleValue)
-    {
-      const Array<double> valueArray = arrayDoubleValue->GetMetaDataObjectValue();
-      const glz::json_t::array_t valueDouble(valueArray.begin(), valueArray.end());
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
-    }
-    const auto matrixFloat44Value = dynamic_cast<MetaDataMatrixFloat44Type *>(entry.GetPointer());
-    if (matrixFloat44Value)
+  const auto & functions = metaDataToJSONFunctions();
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    const MetaDataObjectBase * entry = itr->second.GetPointer();
+    if (entry == nullptr)
     {
-      const Matrix<float, 4, 4> valueArray = matrixFloat44Value->GetMetaDataObjectValue();
-      glz::json_t::array_t valueDouble;
-      for (unsigned int i = 0; i < 4; ++i)
-      {
-        valueDouble.push_back(glz::json_t::array_t(valueArray[i], valueArray[i] + 4));
-      }
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
       continue;
     }
-    const auto matrixDoubleValue = dynamic_cast<MetaDataMatrixDoubleType *>(entry.GetPointer());
-    if (matrixDoubleValue)
+    // Entries of other types are skipped
+    const auto function = functions.find(std::type_index(typeid(*entry)));
+    if (function != functions.end())
     {
-      const Matrix<double, 3, 3> valueArray = matrixDoubleValue->GetMetaDataObjectValue();
-      glz::json_t::array_t valueDouble;
-      for (unsigned int i = 0; i < 3; ++i)
-      {
-        valueDouble.push_back(glz::json_t::array_t(valueArray[i], valueArray[i] + 3));
-      }
-      metaDataJSON.push_back({ key, valueDouble });
-      ++itr;
-      continue;
+      metaDataJSON.emplace_back(itr->first, function->second(entry));
     }
-    ++itr;
   }
 }
 
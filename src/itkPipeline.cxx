@@ -20,30 +20,69 @@
 #include <rang.hpp>
 #endif
 #include "CLI/Formatter.hpp"
+#ifndef ITK_WASM_NO_MEMORY_IO
+#include "itkWasmExports.h"
+#endif
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <vector>
 
 namespace itk
 {
 namespace wasm
 {
 
+namespace
+{
+// Invocation state of the calling thread
+thread_local Pipeline * currentPipeline = nullptr;
+thread_local bool inBatch = false;
+} // end anonymous namespace
+
 Pipeline
 ::Pipeline(std::string name, std::string description, int argc, char **argv):
   App(description, name),
   m_argc(argc),
   m_argv(argv),
-  m_Version("0.1.0")
+  m_Version("0.1.0"),
+  m_StartTime(Profiler::ClockType::now())
 {
+  m_PreviousPipeline = currentPipeline;
+  currentPipeline = this;
+
+#ifndef ITK_WASM_NO_MEMORY_IO
+  // The host may look the block up before main runs, so it is kept for the
+  // invocation instead of being looked up on the calling thread later
+  m_Status = &getPipelineStatus();
+  m_Status->progress.store(0.0f, std::memory_order_relaxed);
+#endif
+
   this->footer("Enjoy ITK!");
 
   this->positionals_at_end(false);
 
   this->add_flag("--memory-io", m_UseMemoryIO, "Use itk-wasm memory IO")->group("");
+  this->add_flag("--binary-descriptors", m_UseBinaryDescriptors, "Use binary (BEVE) memory IO output descriptors")->group("");
+  this->add_flag("--lazy-metadata", m_UseLazyMetadata, "Serialize memory IO output metadata on request")->group("");
+  // The arguments may be parsed more than once, so only the first profiler is
+  // kept. Its events are timed from the construction of the Pipeline.
+  this->add_option_function<std::string>("--profile", [this](const std::string & fileName)
+    {
+    if (!m_Profiler)
+    {
+      m_Profiler = std::make_unique<Profiler>(fileName, m_StartTime);
+    }
+    }, "Write a Chrome trace of the pipeline stages to this file")->group("");
   this->set_version_flag("--version", m_Version);
 
   // Set m_UseMemoryIO before it is used by other memory parsers
   this->preparse_callback([this](size_t arg)
    {
    m_UseMemoryIO = false;
+   m_UseBinaryDescriptors = false;
+   m_UseLazyMetadata = false;
     for (int ii = 0; ii < this->m_argc; ++ii)
     {
       const std::string arg(this->m_argv[ii]);
@@ -51,6 +90,14 @@ Pipeline
       {
         m_UseMemoryIO = true;
       }
+      if (arg == "--binary-descriptors")
+      {
+        m_UseBinaryDescriptors = true;
+      }
+      if (arg == "--lazy-metadata")
+      {
+        m_UseLazyMetadata = true;
+      }
     }
    });
 
@@ -61,6 +108,21 @@ Pipeline
 #endif
 }
 
+void
+Pipeline
+::parse()
+{
+  // The profiler is made while --profile is parsed, so the stage is timed here
+  const Profiler::TimePoint start = Profiler::ClockType::now();
+  const std::clock_t cpuStart = std::clock();
+  CLI::App::parse(m_argc, m_argv);
+  if (m_Profiler)
+  {
+    const double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    m_Profiler->AddEvent("parse", "pipeline", start, Profiler::ClockType::now(), cpuSeconds, 0);
+  }
+}
+
 auto
 Pipeline
 ::exit(const CLI::Error &e) -> int
@@ -278,7 +340,165 @@ Pipeline
 Pipeline
 ::~Pipeline()
 {
+  if (m_Profiler)
+  {
+    m_Profiler->Write();
+  }
+  // An abort request ends with the invocation
+  if (m_Status != nullptr)
+  {
+    m_Status->abort.store(0, std::memory_order_relaxed);
+  }
+  currentPipeline = m_PreviousPipeline;
+}
+
+Pipeline *
+Pipeline
+::get_current()
+{
+  return currentPipeline;
+}
+
+bool
+Pipeline
+::get_use_memory_io()
+{
+  return currentPipeline != nullptr && currentPipeline->m_UseMemoryIO;
+}
+
+bool
+Pipeline
+::get_use_binary_descriptors()
+{
+  return currentPipeline != nullptr && currentPipeline->m_UseBinaryDescriptors;
+}
+
+bool
+Pipeline
+::get_use_lazy_metadata()
+{
+  return currentPipeline != nullptr && currentPipeline->m_UseLazyMetadata;
+}
+
+bool
+Pipeline
+::get_in_batch()
+{
+  return inBatch;
+}
+
+WasmPipelineStatus *
+Pipeline
+::get_status()
+{
+  return currentPipeline != nullptr ? currentPipeline->m_Status : nullptr;
+}
 
+Profiler *
+Pipeline
+::get_profiler()
+{
+  return currentPipeline != nullptr ? currentPipeline->m_Profiler.get() : nullptr;
+}
+
+void
+Pipeline
+::observe_process(ProcessObject * process)
+{
+#ifndef ITK_WASM_NO_MEMORY_IO
+  // Progress events may be invoked from other threads, so the status block
+  // of the invocation is captured. ITK resets AbortGenerateData and reports
+  // progress 0 when an update starts, and checks the flag as it progresses.
+  WasmPipelineStatus * status = get_status();
+  if (status == nullptr)
+  {
+    status = &getPipelineStatus();
+  }
+  process->AddObserver(ProgressEvent(), [process, status](const EventObject &) {
+    status->progress.store(process->GetProgress(), std::memory_order_relaxed);
+    if (status->abort.load(std::memory_order_relaxed) != 0)
+    {
+      process->SetAbortGenerateData(true);
+    }
+  });
+#endif
+  if (Profiler * profiler = get_profiler())
+  {
+    profiler->Observe(process);
+  }
+}
+
+int
+Pipeline
+::run(int argc, char ** argv, MainFunctionType pipelineMain)
+{
+  if (argc != 3 || std::string(argv[1]) != "--batch")
+  {
+    return pipelineMain(argc, argv);
+  }
+
+  const std::string batchFileName(argv[2]);
+  std::ifstream batchFile;
+  if (batchFileName != "-")
+  {
+    batchFile.open(batchFileName);
+    if (!batchFile)
+    {
+      std::cerr << "Could not read the batch file: " << batchFileName << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::istream & batchStream = batchFileName == "-" ? std::cin : batchFile;
+
+  // Each invocation constructs its own Pipeline, which resets the
+  // per-invocation state
+  inBatch = true;
+  int batchExitCode = EXIT_SUCCESS;
+  unsigned int invocation = 0;
+  std::string line;
+  while (std::getline(batchStream, line))
+  {
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+    {
+      continue;
+    }
+    ++invocation;
+
+    const auto start = std::chrono::steady_clock::now();
+    int exitCode = EXIT_FAILURE;
+    auto arguments = glz::read_json<std::vector<std::string>>(line);
+    if (!arguments)
+    {
+      std::cerr << "Invalid batch invocation " << invocation << ": " << glz::format_error(arguments, line) << std::endl;
+    }
+    else
+    {
+      std::vector<char *> invocationArgv{ argv[0] };
+      for (auto & argument : arguments.value())
+      {
+        invocationArgv.push_back(argument.data());
+      }
+      invocationArgv.push_back(nullptr);
+      try
+      {
+        exitCode = pipelineMain(static_cast<int>(invocationArgv.size() - 1), invocationArgv.data());
+      }
+      catch (const std::exception & error)
+      {
+        std::cerr << error.what() << std::endl;
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cerr << "{\"invocation\":" << invocation << ",\"exitCode\":" << exitCode << ",\"seconds\":" << elapsed.count() << "}" << std::endl;
+    if (exitCode != EXIT_SUCCESS)
+    {
+      batchExitCode = EXIT_FAILURE;
+    }
+  }
+  inBatch = false;
+
+  return batchExitCode;
 }
 
 struct CLIOptionJSON
@@ -318,7 +538,7 @@ Pipeline
     CLIOptionJSON optionJSON;
     optionJSON.description = opt->get_description();
     const auto singleName = opt->get_single_name();
-    if (singleName == "help")
+    if (singleName == "help" || singleName == "binary-descriptors" || singleName == "lazy-metadata" || singleName == "profile")
     {
       continue;
     }
@@ -374,8 +594,6 @@ Pipeline
   std::cout << serialized << std::endl;
 }
 
-bool Pipeline::m_UseMemoryIO{false};
-
 } // end namespace wasm
 } // end namespace itk
 
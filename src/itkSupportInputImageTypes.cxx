@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkSupportInputImageTypes.h"
 #include "itkWasmExports.h"
+#include "itkWasmDescriptor.h"
 
 #include "itkjsonFromIOComponentEnum.h"
 #include "itkjsonFromIOPixelEnum.h"
@@ -32,7 +33,7 @@ bool lexical_cast(const std::string &input, ImageTypeJSON & imageType)
     const unsigned int index = std::stoi(input);
     auto json = wasm::getMemoryStoreInputJSON(0, index);
     std::string deserialized;
-    auto        deserializedAttempt = glz::read_json<itk::ImageJSON>(json);
+    auto        deserializedAttempt = readDescriptor<itk::ImageJSON>(json);
     if (!deserializedAttempt)
     {
       const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include "itkSupportInputMeshTypes.h"
 #include "itkWasmExports.h"
+#include "itkWasmDescriptor.h"
 
 #include "itkjsonFromIOComponentEnum.h"
 #include "itkjsonFromIOPixelEnum.h"
@@ -33,7 +34,7 @@ bool lexical_cast(const std::string &input, MeshTypeJSON & meshType)
     const unsigned int index = std::stoi(input);
     auto json = wasm::getMemoryStoreInputJSON(0, index);
     std::string deserialized;
-    auto        deserializedAttempt = glz::read_json<itk::MeshJSON>(json);
+    auto        deserializedAttempt = readDescriptor<itk::MeshJSON>(json);
     if (!deserializedAttempt)
     {
       const std::string descriptiveError = glz::format_error(deserializedAttempt, json);
@@ -0,0 +1,525 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmBase64.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ITK_WASM_BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+
+constexpr char EncodeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 6-bit value of each character, 0xff for characters outside the alphabet
+struct DecodeTable
+{
+  unsigned char values[256];
+
+  constexpr DecodeTable()
+    : values{}
+  {
+    for (unsigned int ii = 0; ii < 256; ++ii)
+    {
+      values[ii] = 0xff;
+    }
+    for (unsigned int ii = 0; ii < 64; ++ii)
+    {
+      values[static_cast<unsigned char>(EncodeTable[ii])] = static_cast<unsigned char>(ii);
+    }
+  }
+};
+constexpr DecodeTable Decode{};
+
+// Encode whole groups of 3 bytes, returns the number of bytes consumed
+size_t
+encodeScalar(const unsigned char * input, size_t length, char * output)
+{
+  size_t ii = 0;
+  for (; ii + 3 <= length; ii += 3)
+  {
+    const uint32_t group = (uint32_t{ input[ii] } << 16) | (uint32_t{ input[ii + 1] } << 8) | input[ii + 2];
+    *output++ = EncodeTable[(group >> 18) & 0x3f];
+    *output++ = EncodeTable[(group >> 12) & 0x3f];
+    *output++ = EncodeTable[(group >> 6) & 0x3f];
+    *output++ = EncodeTable[group & 0x3f];
+  }
+  return ii;
+}
+
+// Decode whole groups of 4 characters without padding, returns the number
+// of characters consumed
+size_t
+decodeScalar(const char * input, size_t length, unsigned char * output)
+{
+  size_t ii = 0;
+  for (; ii + 4 <= length; ii += 4)
+  {
+    const unsigned char a = Decode.values[static_cast<unsigned char>(input[ii])];
+    const unsigned char b = Decode.values[static_cast<unsigned char>(input[ii + 1])];
+    const unsigned char c = Decode.values[static_cast<unsigned char>(input[ii + 2])];
+    const unsigned char d = Decode.values[static_cast<unsigned char>(input[ii + 3])];
+    if ((a | b | c | d) & 0x80)
+    {
+      throw std::invalid_argument("Invalid base64 character");
+    }
+    const uint32_t group = (uint32_t{ a } << 18) | (uint32_t{ b } << 12) | (uint32_t{ c } << 6) | d;
+    *output++ = static_cast<unsigned char>(group >> 16);
+    *output++ = static_cast<unsigned char>(group >> 8);
+    *output++ = static_cast<unsigned char>(group);
+  }
+  return ii;
+}
+
+#if defined(ITK_WASM_BASE64_X86)
+
+// The kernels follow W. Mula and D. Lemire, "Faster Base64 Encoding and
+// Decoding Using AVX2 Instructions", ACM TOW 2018. Each 128-bit lane encodes
+// 12 bytes into 16 characters, or decodes 16 characters into 12 bytes.
+
+__attribute__((target("ssse3"))) inline __m128i
+encodeLane(__m128i block)
+{
+  const __m128i shuffled = _mm_shuffle_epi8(block, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  const __m128i t0 = _mm_and_si128(shuffled, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(shuffled, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t1, t3);
+  __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  offsets = _mm_or_si128(offsets, _mm_and_si128(less, _mm_set1_epi8(13)));
+  const __m128i shiftTable = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(shiftTable, offsets), indices);
+}
+
+__attribute__((target("avx2"))) inline __m256i
+encodeLanes(__m256i block)
+{
+  const __m256i shuffled = _mm256_shuffle_epi8(
+    block, _mm256_broadcastsi128_si256(_mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10)));
+  const __m256i t0 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(shuffled, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  const __m256i indices = _mm256_or_si256(t1, t3);
+  __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  offsets = _mm256_or_si256(offsets, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+  const __m256i shiftTable = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                                       '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                                       '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(shiftTable, offsets), indices);
+}
+
+__attribute__((target("ssse3"))) size_t
+encodeSSSE3(const unsigned char * input, size_t length, char * output)
+{
+  size_t ii = 0;
+  // 16 bytes are loaded for each 12 encoded
+  for (; ii + 16 <= length; ii += 12)
+  {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), encodeLane(block));
+    output += 16;
+  }
+  return ii + encodeScalar(input + ii, length - ii, output);
+}
+
+__attribute__((target("avx2"))) size_t
+encodeAVX2(const unsigned char * input, size_t length, char * output)
+{
+  size_t ii = 0;
+  for (; ii + 28 <= length; ii += 24)
+  {
+    const __m256i block = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii + 12)),
+      1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(output), encodeLanes(block));
+    output += 32;
+  }
+  return ii + encodeSSSE3(input + ii, length - ii, output);
+}
+
+__attribute__((target("ssse3"))) inline __m128i
+decodeLane(__m128i block, bool & invalid)
+{
+  const __m128i higherNibble = _mm_and_si128(_mm_srli_epi32(block, 4), _mm_set1_epi8(0x0f));
+  const __m128i lowerNibble = _mm_and_si128(block, _mm_set1_epi8(0x0f));
+  const __m128i lowerTable =
+    _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m128i higherTable =
+    _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i rollTable = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i lower = _mm_shuffle_epi8(lowerTable, lowerNibble);
+  const __m128i higher = _mm_shuffle_epi8(higherTable, higherNibble);
+  invalid = _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lower, higher), _mm_setzero_si128())) != 0;
+  const __m128i isSlash = _mm_cmpeq_epi8(block, _mm_set1_epi8(0x2f));
+  const __m128i values = _mm_add_epi8(block, _mm_shuffle_epi8(rollTable, _mm_add_epi8(isSlash, higherNibble)));
+  const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("avx2"))) inline __m256i
+decodeLanes(__m256i block, bool & invalid)
+{
+  const __m256i higherNibble = _mm256_and_si256(_mm256_srli_epi32(block, 4), _mm256_set1_epi8(0x0f));
+  const __m256i lowerNibble = _mm256_and_si256(block, _mm256_set1_epi8(0x0f));
+  const __m256i lowerTable = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a));
+  const __m256i higherTable = _mm256_broadcastsi128_si256(
+    _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i rollTable =
+    _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i lower = _mm256_shuffle_epi8(lowerTable, lowerNibble);
+  const __m256i higher = _mm256_shuffle_epi8(higherTable, higherNibble);
+  invalid = _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lower, higher), _mm256_setzero_si256())) != 0;
+  const __m256i isSlash = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x2f));
+  const __m256i values =
+    _mm256_add_epi8(block, _mm256_shuffle_epi8(rollTable, _mm256_add_epi8(isSlash, higherNibble)));
+  const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+  return _mm256_shuffle_epi8(
+    groups,
+    _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+}
+
+__attribute__((target("ssse3"))) size_t
+decodeSSSE3(const char * input, size_t length, unsigned char * output)
+{
+  size_t ii = 0;
+  // 16 bytes are stored for each 12 decoded, the following groups hold the rest
+  for (; ii + 24 <= length; ii += 16)
+  {
+    bool invalid = false;
+    const __m128i decoded = decodeLane(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii)), invalid);
+    if (invalid)
+    {
+      throw std::invalid_argument("Invalid base64 character");
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), decoded);
+    output += 12;
+  }
+  return ii + decodeScalar(input + ii, length - ii, output);
+}
+
+__attribute__((target("avx2"))) size_t
+decodeAVX2(const char * input, size_t length, unsigned char * output)
+{
+  size_t ii = 0;
+  for (; ii + 40 <= length; ii += 32)
+  {
+    bool invalid = false;
+    const __m256i decoded = decodeLanes(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + ii)), invalid);
+    if (invalid)
+    {
+      throw std::invalid_argument("Invalid base64 character");
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm256_castsi256_si128(decoded));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 12), _mm256_extracti128_si256(decoded, 1));
+    output += 24;
+  }
+  return ii + decodeSSSE3(input + ii, length - ii, output);
+}
+
+#elif defined(__wasm_simd128__)
+
+size_t
+encodeSIMD128(const unsigned char * input, size_t length, char * output)
+{
+  size_t ii = 0;
+  for (; ii + 16 <= length; ii += 12)
+  {
+    const v128_t block = wasm_v128_load(input + ii);
+    const v128_t shuffled = wasm_i8x16_shuffle(block, block, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    // The 16-bit lanes of each 32-bit word are shifted by different amounts
+    const v128_t lowLanes = wasm_i32x4_const_splat(0x0000ffff);
+    const v128_t t0 = wasm_v128_and(shuffled, wasm_i32x4_const_splat(0x0fc0fc00));
+    const v128_t t1 = wasm_v128_bitselect(wasm_u16x8_shr(t0, 10), wasm_u16x8_shr(t0, 6), lowLanes);
+    const v128_t t2 = wasm_v128_and(shuffled, wasm_i32x4_const_splat(0x003f03f0));
+    const v128_t t3 = wasm_v128_bitselect(wasm_i16x8_shl(t2, 4), wasm_i16x8_shl(t2, 8), lowLanes);
+    const v128_t indices = wasm_v128_or(t1, t3);
+    v128_t offsets = wasm_u8x16_sub_sat(indices, wasm_i8x16_splat(51));
+    const v128_t less = wasm_i8x16_gt(wasm_i8x16_splat(26), indices);
+    offsets = wasm_v128_or(offsets, wasm_v128_and(less, wasm_i8x16_splat(13)));
+    const v128_t shiftTable = wasm_i8x16_make('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                             '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    wasm_v128_store(output, wasm_i8x16_add(wasm_i8x16_swizzle(shiftTable, offsets), indices));
+    output += 16;
+  }
+  return ii + encodeScalar(input + ii, length - ii, output);
+}
+
+size_t
+decodeSIMD128(const char * input, size_t length, unsigned char * output)
+{
+  size_t ii = 0;
+  for (; ii + 24 <= length; ii += 16)
+  {
+    const v128_t block = wasm_v128_load(input + ii);
+    const v128_t higherNibble = wasm_u8x16_shr(block, 4);
+    const v128_t lowerNibble = wasm_v128_and(block, wasm_i8x16_splat(0x0f));
+    const v128_t lowerTable = wasm_i8x16_make(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const v128_t higherTable = wasm_i8x16_make(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const v128_t rollTable = wasm_i8x16_make(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const v128_t lower = wasm_i8x16_swizzle(lowerTable, lowerNibble);
+    const v128_t higher = wasm_i8x16_swizzle(higherTable, higherNibble);
+    if (wasm_v128_any_true(wasm_v128_and(lower, higher)))
+    {
+      throw std::invalid_argument("Invalid base64 character");
+    }
+    const v128_t isSlash = wasm_i8x16_eq(block, wasm_i8x16_splat(0x2f));
+    const v128_t values = wasm_i8x16_add(block, wasm_i8x16_swizzle(rollTable, wasm_i8x16_add(isSlash, higherNibble)));
+    // Merge the 6-bit values into 12-bit pairs, then into 24-bit groups
+    const v128_t pairs = wasm_v128_or(wasm_v128_and(wasm_i16x8_shl(values, 6), wasm_i16x8_splat(0x0fc0)), wasm_u16x8_shr(values, 8));
+    const v128_t groups = wasm_v128_or(wasm_v128_and(wasm_i32x4_shl(pairs, 12), wasm_i32x4_splat(0x00fff000)), wasm_u32x4_shr(pairs, 16));
+    wasm_v128_store(output, wasm_i8x16_swizzle(groups, wasm_i8x16_make(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    output += 12;
+  }
+  return ii + decodeScalar(input + ii, length - ii, output);
+}
+
+#endif
+
+size_t
+encodeBlocks(const unsigned char * input, size_t length, char * output)
+{
+#if defined(ITK_WASM_BASE64_X86)
+  static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+  static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+  if (hasAVX2)
+  {
+    return encodeAVX2(input, length, output);
+  }
+  if (hasSSSE3)
+  {
+    return encodeSSSE3(input, length, output);
+  }
+#elif defined(__wasm_simd128__)
+  return encodeSIMD128(input, length, output);
+#endif
+  return encodeScalar(input, length, output);
+}
+
+size_t
+decodeBlocks(const char * input, size_t length, unsigned char * output)
+{
+#if defined(ITK_WASM_BASE64_X86)
+  static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+  static const bool hasSSSE3 = __builtin_cpu_supports("ssse3");
+  if (hasAVX2)
+  {
+    return decodeAVX2(input, length, output);
+  }
+  if (hasSSSE3)
+  {
+    return decodeSSSE3(input, length, output);
+  }
+#elif defined(__wasm_simd128__)
+  return decodeSIMD128(input, length, output);
+#endif
+  return decodeScalar(input, length, output);
+}
+
+constexpr size_t StreamBlockSize = 3 * 16384;
+
+inline bool
+isWhitespace(char character)
+{
+  return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+}
+
+} // end anonymous namespace
+
+size_t
+base64Encode(const void * input, size_t length, char * output)
+{
+  const auto * bytes = static_cast<const unsigned char *>(input);
+  const size_t encodedBytes = encodeBlocks(bytes, length, output);
+  char * tail = output + encodedBytes / 3 * 4;
+  const size_t remainder = length - encodedBytes;
+  if (remainder > 0)
+  {
+    const uint32_t group = (uint32_t{ bytes[encodedBytes] } << 16) | (remainder > 1 ? uint32_t{ bytes[encodedBytes + 1] } << 8 : 0);
+    *tail++ = EncodeTable[(group >> 18) & 0x3f];
+    *tail++ = EncodeTable[(group >> 12) & 0x3f];
+    *tail++ = remainder > 1 ? EncodeTable[(group >> 6) & 0x3f] : '=';
+    *tail++ = '=';
+  }
+  return tail - output;
+}
+
+size_t
+base64Decode(const char * input, size_t length, void * output)
+{
+  if (length % 4 != 0)
+  {
+    throw std::invalid_argument("The base64 length is not a multiple of 4");
+  }
+  auto * bytes = static_cast<unsigned char *>(output);
+  size_t padding = 0;
+  if (length > 0 && input[length - 1] == '=')
+  {
+    padding = (length > 1 && input[length - 2] == '=') ? 2 : 1;
+  }
+  // The last group, with padding, is decoded separately
+  const size_t blocksLength = padding > 0 ? length - 4 : length;
+  const size_t decodedCharacters = decodeBlocks(input, blocksLength, bytes);
+  size_t written = decodedCharacters / 4 * 3;
+  if (padding > 0)
+  {
+    char last[4] = { input[length - 4], input[length - 3], padding > 1 ? 'A' : input[length - 2], 'A' };
+    unsigned char group[3];
+    decodeScalar(last, 4, group);
+    std::memcpy(bytes + written, group, 3 - padding);
+    written += 3 - padding;
+  }
+  return written;
+}
+
+Base64OutputStreamBuffer::Base64OutputStreamBuffer(std::ostream & sink)
+  : m_Sink(sink)
+  , m_Encoded(base64EncodedLength(StreamBlockSize))
+{}
+
+void
+Base64OutputStreamBuffer::Finish()
+{
+  const size_t written = base64Encode(m_Pending, m_PendingCount, m_Encoded.data());
+  m_Sink.write(m_Encoded.data(), written);
+  m_PendingCount = 0;
+}
+
+std::streamsize
+Base64OutputStreamBuffer::xsputn(const char * data, std::streamsize count)
+{
+  const auto * bytes = reinterpret_cast<const unsigned char *>(data);
+  size_t remaining = static_cast<size_t>(count);
+  // Complete the pending group
+  while (m_PendingCount > 0 && m_PendingCount < 3 && remaining > 0)
+  {
+    m_Pending[m_PendingCount++] = *bytes++;
+    --remaining;
+  }
+  if (m_PendingCount == 3)
+  {
+    m_Sink.write(m_Encoded.data(), base64Encode(m_Pending, 3, m_Encoded.data()));
+    m_PendingCount = 0;
+  }
+  while (remaining >= 3)
+  {
+    const size_t block = std::min(remaining / 3 * 3, StreamBlockSize);
+    m_Sink.write(m_Encoded.data(), base64Encode(bytes, block, m_Encoded.data()));
+    bytes += block;
+    remaining -= block;
+  }
+  while (remaining > 0)
+  {
+    m_Pending[m_PendingCount++] = *bytes++;
+    --remaining;
+  }
+  return count;
+}
+
+Base64OutputStreamBuffer::int_type
+Base64OutputStreamBuffer::overflow(int_type character)
+{
+  if (!traits_type::eq_int_type(character, traits_type::eof()))
+  {
+    const char value = traits_type::to_char_type(character);
+    this->xsputn(&value, 1);
+  }
+  return traits_type::not_eof(character);
+}
+
+Base64InputStreamBuffer::Base64InputStreamBuffer(std::istream & source)
+  : m_Source(source)
+  , m_Text(base64EncodedLength(StreamBlockSize))
+  , m_Decoded(StreamBlockSize)
+{}
+
+Base64InputStreamBuffer::int_type
+Base64InputStreamBuffer::underflow()
+{
+  if (this->gptr() < this->egptr())
+  {
+    return traits_type::to_int_type(*this->gptr());
+  }
+
+  while (!m_Finished)
+  {
+    // Fill the text buffer, without whitespace, after the leftover characters
+    std::streamsize readCount = 0;
+    if (m_Source)
+    {
+      m_Source.read(m_Text.data() + m_TextCount, m_Text.size() - m_TextCount);
+      readCount = m_Source.gcount();
+    }
+    char * end = m_Text.data() + m_TextCount;
+    const char * readEnd = end + readCount;
+    for (const char * character = end; character < readEnd; ++character)
+    {
+      if (!isWhitespace(*character))
+      {
+        *end++ = *character;
+      }
+    }
+    m_TextCount = end - m_Text.data();
+    m_Finished = readCount == 0;
+
+    // Decode whole groups, the last group may be padded
+    const size_t groups = m_Finished ? m_TextCount : m_TextCount / 4 * 4;
+    if (groups == 0)
+    {
+      continue;
+    }
+    const bool padded = m_Text[groups - 1] == '=';
+    const size_t decodeCount = (padded && !m_Finished) ? groups - 4 : groups;
+    if (decodeCount == 0 && !m_Finished)
+    {
+      continue;
+    }
+    const size_t decoded = base64Decode(m_Text.data(), decodeCount, m_Decoded.data());
+    m_TextCount -= decodeCount;
+    std::memmove(m_Text.data(), m_Text.data() + decodeCount, m_TextCount);
+    if (decoded > 0)
+    {
+      this->setg(m_Decoded.data(), m_Decoded.data(), m_Decoded.data() + decoded);
+      return traits_type::to_int_type(*this->gptr());
+    }
+  }
+  return traits_type::eof();
+}
+
+} // end namespace itk
@@ -25,6 +25,7 @@ WasmDataObject::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "JSON: " << this->m_JSON << std::endl;
+  os << indent << "BinaryDescriptor: " << this->m_BinaryDescriptor << std::endl;
   os << indent << "DataObject: ";
   if (this->m_DataObject)
   {
@@ -20,7 +20,12 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 
-#include <map>
+#include "itkMetaDataDictionaryJSON.h"
+#include "itkWasmProfiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -29,43 +34,395 @@ namespace itk
 namespace wasm
 {
 
-static InputArrayStoreType inputArrayStore;
+namespace
+{
+
+/** Arena allocator for the input JSON, input arrays, and host-provided output
+ * buffers.
+ *
+ * Allocations are never zero-initialized: the host overwrites every byte.
+ * Allocations are bumped from the current block. Release() rewinds the top
+ * of the arena or records the range in an address-ordered free list, whose
+ * adjacent ranges are coalesced and reused first-fit by Allocate(), so that
+ * releasing an input early returns its memory regardless of the order of
+ * allocation. Reset(), called from itk_wasm_free_all, rewinds the arena and
+ * coalesces its blocks into a single block sized to the high-water mark so
+ * that the next invocation with similar inputs does not touch the heap. */
+class MemoryStoreArena
+{
+public:
+  static constexpr size_t Alignment = alignof(std::max_align_t);
+  static constexpr size_t MinimumBlockSize = 64 * 1024;
+
+  void * Allocate(size_t size)
+  {
+    const size_t alignedSize = AlignedSize(size);
+    uint8_t * result = this->AllocateFromFreeList(alignedSize);
+    if (!result)
+    {
+      if (m_Blocks.empty() || m_Offset + alignedSize > m_Blocks.back().size)
+      {
+        this->AddBlock(std::max(alignedSize, MinimumBlockSize));
+      }
+      result = m_Blocks.back().data.get() + m_Offset;
+      m_Offset += alignedSize;
+    }
+    m_InUse += alignedSize;
+    m_HighWaterMark = std::max(m_HighWaterMark, m_InUse);
+    return result;
+  }
+
+  void Release(void * address, size_t size)
+  {
+    if (m_Blocks.empty() || !address)
+    {
+      return;
+    }
+    const size_t alignedSize = AlignedSize(size);
+    m_InUse -= alignedSize;
+    auto * begin = static_cast<uint8_t *>(address);
+    uint8_t * blockBegin = m_Blocks.back().data.get();
+    if (begin + alignedSize == blockBegin + m_Offset)
+    {
+      m_Offset -= alignedSize;
+      // A free range that now ends at the top is absorbed as well
+      auto next = this->FindFreeRange(begin);
+      if (next != m_FreeRanges.begin())
+      {
+        auto previous = std::prev(next);
+        if (previous->address >= blockBegin && previous->address + previous->size == begin)
+        {
+          m_Offset -= previous->size;
+          m_FreeRanges.erase(previous);
+        }
+      }
+      return;
+    }
+    this->AddFreeRange(begin, alignedSize);
+  }
+
+  void Reset()
+  {
+    if (m_Blocks.size() > 1)
+    {
+      m_Blocks.clear();
+      this->AddBlock(std::max(m_HighWaterMark, MinimumBlockSize));
+    }
+    m_FreeRanges.clear();
+    m_Offset = 0;
+    m_InUse = 0;
+  }
+
+  size_t GetHighWaterMark() const
+  {
+    return m_HighWaterMark;
+  }
+
+private:
+  struct Block
+  {
+    std::unique_ptr<uint8_t[]> data;
+    size_t size;
+  };
+
+  struct FreeRange
+  {
+    uint8_t * address;
+    size_t size;
+  };
+
+  static size_t AlignedSize(size_t size)
+  {
+    return (size + Alignment - 1) & ~(Alignment - 1);
+  }
+
+  std::vector<FreeRange>::iterator FindFreeRange(const uint8_t * address)
+  {
+    return std::lower_bound(m_FreeRanges.begin(), m_FreeRanges.end(), address,
+                            [](const FreeRange & range, const uint8_t * value) { return range.address < value; });
+  }
+
+  /** Insert a range into the free list, coalescing it with its neighbors. */
+  void AddFreeRange(uint8_t * begin, size_t size)
+  {
+    auto next = this->FindFreeRange(begin);
+    if (next != m_FreeRanges.begin())
+    {
+      auto previous = std::prev(next);
+      if (previous->address + previous->size == begin)
+      {
+        previous->size += size;
+        if (next != m_FreeRanges.end() && previous->address + previous->size == next->address)
+        {
+          previous->size += next->size;
+          m_FreeRanges.erase(next);
+        }
+        return;
+      }
+    }
+    if (next != m_FreeRanges.end() && begin + size == next->address)
+    {
+      next->address = begin;
+      next->size += size;
+      return;
+    }
+    m_FreeRanges.insert(next, FreeRange{ begin, size });
+  }
+
+  uint8_t * AllocateFromFreeList(size_t alignedSize)
+  {
+    for (auto it = m_FreeRanges.begin(); it != m_FreeRanges.end(); ++it)
+    {
+      if (it->size >= alignedSize)
+      {
+        uint8_t * result = it->address;
+        it->address += alignedSize;
+        it->size -= alignedSize;
+        if (it->size == 0)
+        {
+          m_FreeRanges.erase(it);
+        }
+        return result;
+      }
+    }
+    return nullptr;
+  }
+
+  void AddBlock(size_t size)
+  {
+    // The unused tail of the current block stays available in the free list
+    if (!m_Blocks.empty() && m_Offset < m_Blocks.back().size)
+    {
+      this->AddFreeRange(m_Blocks.back().data.get() + m_Offset, m_Blocks.back().size - m_Offset);
+    }
+    // new[] without an initializer leaves the bytes uninitialized
+    m_Blocks.push_back(Block{ std::unique_ptr<uint8_t[]>(new uint8_t[size]), size });
+    m_Offset = 0;
+  }
+
+  std::vector<Block> m_Blocks;
+  // sorted by address
+  std::vector<FreeRange> m_FreeRanges;
+  size_t m_Offset{ 0 };
+  size_t m_InUse{ 0 };
+  size_t m_HighWaterMark{ 0 };
+};
+
+/** Slots keyed by (index, subIndex) with O(1) lookup.
+ *
+ * Indices are small, dense integers assigned by the pipeline interface, so
+ * nested vectors replace the std::map nodes. Clear() keeps the vector
+ * capacity for the next invocation. */
+template <typename TValue>
+class MemoryStoreSlots
+{
+public:
+  TValue & operator()(uint32_t index, uint32_t subIndex)
+  {
+    if (index >= m_Slots.size())
+    {
+      m_Slots.resize(index + 1);
+    }
+    auto & subSlots = m_Slots[index];
+    if (subIndex >= subSlots.size())
+    {
+      subSlots.resize(subIndex + 1);
+    }
+    return subSlots[subIndex];
+  }
+
+  TValue Get(uint32_t index, uint32_t subIndex) const
+  {
+    if (index >= m_Slots.size() || subIndex >= m_Slots[index].size())
+    {
+      return TValue{};
+    }
+    return m_Slots[index][subIndex];
+  }
+
+  /** Slots for one index, in subIndex order. */
+  std::vector<TValue> & operator[](uint32_t index)
+  {
+    if (index >= m_Slots.size())
+    {
+      m_Slots.resize(index + 1);
+    }
+    return m_Slots[index];
+  }
+
+  /** Call function(index, subIndex, value) for every slot. */
+  template <typename TFunction>
+  void ForEach(TFunction function) const
+  {
+    for (uint32_t index = 0; index < m_Slots.size(); ++index)
+    {
+      for (uint32_t subIndex = 0; subIndex < m_Slots[index].size(); ++subIndex)
+      {
+        function(index, subIndex, m_Slots[index][subIndex]);
+      }
+    }
+  }
+
+  /** Drop the slots of one index and free their storage. */
+  void Clear(uint32_t index)
+  {
+    if (index < m_Slots.size())
+    {
+      std::vector<TValue>().swap(m_Slots[index]);
+    }
+  }
+
+  void Clear()
+  {
+    for (auto & subSlots : m_Slots)
+    {
+      subSlots.clear();
+    }
+  }
+
+private:
+  std::vector<std::vector<TValue>> m_Slots;
+};
+
+/** Inputs and outputs of the pipeline invocation on one thread.
+ *
+ * The host allocates the inputs, runs the pipeline, and reads the outputs on
+ * the same thread, so invocations on different threads of a native host or a
+ * threaded wasm instance do not share a store. */
+struct MemoryStore
+{
+  MemoryStoreArena arrayArena;
+
+  // address, size
+  MemoryStoreSlots<MemoryStoreArrayType> inputArrayStore;
+
+  // address, size
+  MemoryStoreSlots<MemoryStoreArrayType> inputJSONStore;
+
+  MemoryStoreSlots<WasmDataObject::ConstPointer> outputWasmDataObjectStore;
+
+  // address, size
+  MemoryStoreSlots<MemoryStoreArrayType> outputArrayStore;
+
+  // address, size
+  MemoryStoreSlots<MemoryStoreArrayType> outputArrayBufferStore;
+
+  // index, serialized on request for outputs with lazy metadata
+  MemoryStoreSlots<std::string> outputMetadataStore;
+
+  // copy returned by the deprecated getMemoryInputArrayStore
+  InputArrayStoreType inputArrayStoreCopy;
+};
+
+thread_local MemoryStore memoryStore;
+
+#if defined(__EMSCRIPTEN__) || defined(__wasi__)
+// A module instance runs one invocation at a time, so the block has one
+// address that the host can poll from any thread while main runs
+WasmPipelineStatus pipelineStatus;
+#else
+// Native invocations may run concurrently, one per thread
+thread_local WasmPipelineStatus pipelineStatus;
+#endif
+
+const std::string & outputMetadata(uint32_t index)
+{
+  auto & serialized = memoryStore.outputMetadataStore(index, 0);
+  if (serialized.empty())
+  {
+    MetadataJSON metadata;
+    metaDataDictionaryToJSON(memoryStore.outputWasmDataObjectStore(index, 0)->GetMetaDataDictionary(), metadata);
+    if (glz::write_json(metadata, serialized))
+    {
+      serialized = "[]";
+    }
+  }
+  return serialized;
+}
+
+/** Point a slot at a new arena allocation, releasing the allocation it held
+ * so that allocating the same slot twice does not leak arena space. */
+size_t allocateArray(MemoryStoreArrayType & slot, size_t size)
+{
+  if (slot.first)
+  {
+    memoryStore.arrayArena.Release(reinterpret_cast< void * >(slot.first), slot.second);
+  }
+  const auto address = reinterpret_cast< size_t >(memoryStore.arrayArena.Allocate(size));
+  Profiler::CountAllocation(size);
+  slot = std::make_pair(address, size);
+  return address;
+}
+
+void releaseArrays(MemoryStoreSlots<MemoryStoreArrayType> & store, uint32_t index)
+{
+  auto & arrays = store[index];
+  // Release in reverse allocation order so the arena can rewind
+  for (auto it = arrays.rbegin(); it != arrays.rend(); ++it)
+  {
+    if (it->first)
+    {
+      memoryStore.arrayArena.Release(reinterpret_cast< void * >(it->first), it->second);
+    }
+  }
+  store.Clear(index);
+}
 
-// index
-using InputJSONStoreType = std::map<uint32_t, std::string>;
-static InputJSONStoreType inputJSONStore;
+} // end anonymous namespace
 
-const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index)
+std::string getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index)
 {
-  return inputJSONStore[index];
+  const MemoryStoreArrayType json = memoryStore.inputJSONStore.Get(index, 0);
+  if (!json.first)
+  {
+    return std::string();
+  }
+  return std::string(reinterpret_cast< const char * >(json.first), json.second);
+}
+
+MemoryStoreArrayType getMemoryStoreInputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
+{
+  return memoryStore.inputArrayStore.Get(index, subIndex);
 }
 
 const InputArrayStoreType & getMemoryInputArrayStore()
 {
-  return inputArrayStore;
+  auto & copy = memoryStore.inputArrayStoreCopy;
+  copy.clear();
+  memoryStore.inputArrayStore.ForEach([&copy](uint32_t index, uint32_t subIndex, const MemoryStoreArrayType & array) {
+    if (array.first)
+    {
+      const auto data = reinterpret_cast< const uint8_t * >(array.first);
+      copy[std::make_pair(index, subIndex)] = InputArrayStoreValueType(data, data + array.second);
+    }
+  });
+  return copy;
 }
 
-using OutputWasmDataObjectStoreType = std::map<uint32_t, WasmDataObject::ConstPointer>;
-static OutputWasmDataObjectStoreType outputWasmDataObjectStore;
+size_t getMemoryStoreHighWaterMark()
+{
+  return memoryStore.arrayArena.GetHighWaterMark();
+}
+
+MemoryStoreArrayType getMemoryStoreOutputArrayBuffer(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
+{
+  return memoryStore.outputArrayBufferStore.Get(index, subIndex);
+}
 
 void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject)
 {
   WasmDataObject::ConstPointer smartPointer(dataObject);
-  outputWasmDataObjectStore[index] = smartPointer;
+  memoryStore.outputWasmDataObjectStore(index, 0) = smartPointer;
 }
 
-// dataset index, array index
-using OutputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
-// address, size
-using OutputArrayStoreValueType = std::pair<size_t, size_t>;
-using OutputArrayStoreType = std::map<OutputArrayStoreKeyType, OutputArrayStoreValueType>;
-static OutputArrayStoreType outputArrayStore;
-
 void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size)
 {
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = std::make_pair(address, size);
-  outputArrayStore[key] = value;
+  memoryStore.outputArrayStore(index, subIndex) = std::make_pair(address, size);
+}
+
+WasmPipelineStatus & getPipelineStatus()
+{
+  return pipelineStatus;
 }
 
 } // end namespace wasm
@@ -74,67 +431,103 @@ void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t su
 size_t itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size)
 {
   using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  if (inputArrayStore.count(key))
-  {
-    inputArrayStore[key] = InputArrayStoreValueType(size);
-  }
-  else
-  {
-    inputArrayStore[key].resize(size);
-  }
-  return reinterpret_cast< size_t >(inputArrayStore[key].data());
+  return allocateArray(memoryStore.inputArrayStore(index, subIndex), size);
 }
 
 size_t itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size)
 {
   using namespace itk::wasm;
-  if (inputJSONStore.count(index))
-  {
-    inputJSONStore[index] = std::string(size, ' ');
-  }
-  else
-  {
-    inputJSONStore[index].resize(size);
-  }
-  return reinterpret_cast< size_t >(inputJSONStore[index].data());
+  return allocateArray(memoryStore.inputJSONStore(index, 0), size);
+}
+
+size_t itk_wasm_output_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size)
+{
+  using namespace itk::wasm;
+  return allocateArray(memoryStore.outputArrayBufferStore(index, subIndex), size);
 }
 
 size_t itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index)
 {
   using namespace itk::wasm;
-  return reinterpret_cast< size_t >(outputWasmDataObjectStore[index]->GetJSON().data());
+  return reinterpret_cast< size_t >(memoryStore.outputWasmDataObjectStore(index, 0)->GetJSON().data());
 }
 
 size_t itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index)
 {
   using namespace itk::wasm;
-  return outputWasmDataObjectStore[index]->GetJSON().size();
+  return memoryStore.outputWasmDataObjectStore(index, 0)->GetJSON().size();
+}
+
+size_t itk_wasm_output_metadata_address(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  return reinterpret_cast< size_t >(outputMetadata(index).data());
+}
+
+size_t itk_wasm_output_metadata_size(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  return outputMetadata(index).size();
 }
 
 size_t itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
 {
   using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
-  return value.first;
+  return memoryStore.outputArrayStore.Get(index, subIndex).first;
 }
 
 size_t itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
 {
   using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
-  return value.second;
+  return memoryStore.outputArrayStore.Get(index, subIndex).second;
+}
+
+size_t itk_wasm_memory_high_water_mark()
+{
+  using namespace itk::wasm;
+  return memoryStore.arrayArena.GetHighWaterMark();
+}
+
+uint32_t itk_wasm_descriptor_encodings()
+{
+  constexpr uint32_t integerAddressJSON = 1;
+  constexpr uint32_t binaryOutputDescriptors = 2;
+  return integerAddressJSON | binaryOutputDescriptors;
+}
+
+size_t itk_wasm_progress_address()
+{
+  using namespace itk::wasm;
+  return reinterpret_cast< size_t >(&pipelineStatus);
+}
+
+void itk_wasm_input_release(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  releaseArrays(memoryStore.inputArrayStore, index);
+  releaseArrays(memoryStore.inputJSONStore, index);
+}
+
+void itk_wasm_output_release(uint32_t memoryIndex, uint32_t index)
+{
+  using namespace itk::wasm;
+  memoryStore.outputArrayStore.Clear(index);
+  memoryStore.outputWasmDataObjectStore.Clear(index);
+  memoryStore.outputMetadataStore.Clear(index);
+  releaseArrays(memoryStore.outputArrayBufferStore, index);
 }
 
 void itk_wasm_free_all()
 {
   using namespace itk::wasm;
-  inputJSONStore.clear();
-  inputArrayStore.clear();
-  outputWasmDataObjectStore.clear();
-  outputArrayStore.clear();
+  memoryStore.inputJSONStore.Clear();
+  memoryStore.inputArrayStore.Clear();
+  memoryStore.outputWasmDataObjectStore.Clear();
+  memoryStore.outputArrayStore.Clear();
+  memoryStore.outputArrayBufferStore.Clear();
+  memoryStore.outputMetadataStore.Clear();
+  memoryStore.inputArrayStoreCopy.clear();
+  memoryStore.arrayArena.Reset();
 }
 
 #endif // ITK_WASM_NO_MEMORY_IO
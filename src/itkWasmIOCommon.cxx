@@ -25,9 +25,181 @@
 
 #include "cbor.h"
 
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#define ITK_WASM_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace itk
 {
 
+namespace
+{
+
+struct CBORHeader
+{
+  uint8_t majorType{ 0 };
+  uint64_t value{ 0 };
+  bool indefinite{ false };
+};
+
+CBORHeader
+readCBORHeader(const unsigned char * buffer, size_t length, size_t & offset)
+{
+  if (offset >= length)
+  {
+    throw std::runtime_error("Truncated CBOR data");
+  }
+  const uint8_t initialByte = buffer[offset++];
+  CBORHeader header;
+  header.majorType = initialByte >> 5;
+  const uint8_t additionalInformation = initialByte & 0x1f;
+  if (additionalInformation < 24)
+  {
+    header.value = additionalInformation;
+    return header;
+  }
+  if (additionalInformation == 31)
+  {
+    header.indefinite = true;
+    return header;
+  }
+  size_t valueBytes = 0;
+  switch (additionalInformation)
+  {
+    case 24:
+      valueBytes = 1;
+      break;
+    case 25:
+      valueBytes = 2;
+      break;
+    case 26:
+      valueBytes = 4;
+      break;
+    case 27:
+      valueBytes = 8;
+      break;
+    default:
+      throw std::runtime_error("Malformed CBOR item header");
+  }
+  if (length - offset < valueBytes)
+  {
+    throw std::runtime_error("Truncated CBOR data");
+  }
+  for (size_t ii = 0; ii < valueBytes; ++ii)
+  {
+    header.value = (header.value << 8) | buffer[offset++];
+  }
+  return header;
+}
+
+bool
+atCBORBreak(const unsigned char * buffer, size_t length, size_t & offset)
+{
+  if (offset >= length)
+  {
+    throw std::runtime_error("Truncated CBOR data");
+  }
+  if (buffer[offset] == 0xff)
+  {
+    ++offset;
+    return true;
+  }
+  return false;
+}
+
+// Nesting allowed in skipped items, which bounds the recursion on malformed input
+constexpr size_t maximumCBORDepth = 256;
+
+void
+skipCBORItem(const unsigned char * buffer, size_t length, size_t & offset, size_t depth = 0)
+{
+  if (depth > maximumCBORDepth)
+  {
+    throw std::runtime_error("CBOR items are nested too deeply");
+  }
+  const CBORHeader header = readCBORHeader(buffer, length, offset);
+  switch (header.majorType)
+  {
+    case 0: // unsigned integer
+    case 1: // negative integer
+      return;
+    case 2: // byte string
+    case 3: // text string
+      if (header.indefinite)
+      {
+        while (!atCBORBreak(buffer, length, offset))
+        {
+          skipCBORItem(buffer, length, offset, depth + 1);
+        }
+        return;
+      }
+      if (length - offset < header.value)
+      {
+        throw std::runtime_error("Truncated CBOR data");
+      }
+      offset += header.value;
+      return;
+    case 4: // array
+    case 5: // map
+    {
+      if (header.indefinite)
+      {
+        while (!atCBORBreak(buffer, length, offset))
+        {
+          skipCBORItem(buffer, length, offset, depth + 1);
+        }
+        return;
+      }
+      const uint64_t items = header.majorType == 5 ? 2 * header.value : header.value;
+      for (uint64_t ii = 0; ii < items; ++ii)
+      {
+        skipCBORItem(buffer, length, offset, depth + 1);
+      }
+      return;
+    }
+    case 6: // tag
+      skipCBORItem(buffer, length, offset, depth + 1);
+      return;
+    default: // simple values and floats are contained in the header
+      if (header.indefinite)
+      {
+        throw std::runtime_error("Unexpected CBOR break");
+      }
+      return;
+  }
+}
+
+bool
+isTruncatedByteString(const unsigned char * buffer, size_t length, size_t offset)
+{
+  CBORHeader header = readCBORHeader(buffer, length, offset);
+  if (header.majorType == 6)
+  {
+    header = readCBORHeader(buffer, length, offset);
+  }
+  return header.majorType == 2 && !header.indefinite && length - offset < header.value;
+}
+
+void
+writeCBORItem(std::ostream & outputStream, const cbor_item_t * item)
+{
+  unsigned char * serialized = nullptr;
+  size_t serializedSize = 0;
+  const size_t length = cbor_serialize_alloc(item, &serialized, &serializedSize);
+  if (length == 0)
+  {
+    throw std::runtime_error("Could not serialize the CBOR item");
+  }
+  outputStream.write(reinterpret_cast<const char *>(serialized), length);
+  free(serialized);
+}
+
+} // end anonymous namespace
+
 void
 openFileForReading(std::ifstream & inputStream, const std::string & filename, bool ascii)
 {
@@ -174,55 +346,120 @@ writeCBORBuffer(cbor_item_t * index, const char * dataName, const void * buffer,
     throw std::logic_error("Call write information before writing the data buffer");
   }
   cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-  uint64_t tag = 0;
+  const uint64_t tag = cborTypedArrayTag(ioComponent);
+  cbor_item_t * dataTag = cbor_new_tag(tag);
+  cbor_tag_set_item(dataTag, cbor_move(dataItem));
+  cbor_map_add(index,
+    cbor_pair{
+      cbor_move(cbor_build_string(dataName)),
+      cbor_move(dataTag)});
+}
+
+uint64_t
+cborTypedArrayTag(IOComponentEnum ioComponent)
+{
   // Todo: support endianness
   // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
   switch (ioComponent) {
     case IOComponentEnum::CHAR:
-      tag = 64;
-      break;
+      return 64;
     case IOComponentEnum::UCHAR:
-      tag = 64;
-      break;
+      return 64;
     case IOComponentEnum::SHORT:
-      tag = 73;
-      break;
+      return 73;
     case IOComponentEnum::USHORT:
-      tag = 69;
-      break;
+      return 69;
     case IOComponentEnum::INT:
-      tag = 74;
-      break;
+      return 74;
     case IOComponentEnum::UINT:
-      tag = 70;
-      break;
+      return 70;
     case IOComponentEnum::LONG:
-      tag = 75;
-      break;
+      return 75;
     case IOComponentEnum::ULONG:
-      tag = 71;
-      break;
+      return 71;
     case IOComponentEnum::LONGLONG:
-      tag = 75;
-      break;
+      return 75;
     case IOComponentEnum::ULONGLONG:
-      tag = 71;
-      break;
+      return 71;
     case IOComponentEnum::FLOAT:
-      tag = 85;
-      break;
+      return 85;
     case IOComponentEnum::DOUBLE:
-      tag = 86;
-      break;
+      return 86;
     default:
       throw std::logic_error("Unexpected component type");
   }
-  cbor_item_t * dataTag = cbor_new_tag(tag);
-  cbor_tag_set_item(dataTag, cbor_move(dataItem));
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string(dataName)),
-      cbor_move(dataTag)});
+}
+
+void
+writeCBORHead(std::ostream & outputStream, uint8_t majorType, uint64_t value)
+{
+  unsigned char head[9];
+  size_t headLength = 1;
+  const unsigned char initialByte = static_cast<unsigned char>(majorType << 5);
+  if (value < 24)
+  {
+    head[0] = initialByte | static_cast<unsigned char>(value);
+  }
+  else if (value <= 0xff)
+  {
+    head[0] = initialByte | 24;
+    headLength = 2;
+  }
+  else if (value <= 0xffff)
+  {
+    head[0] = initialByte | 25;
+    headLength = 3;
+  }
+  else if (value <= 0xffffffff)
+  {
+    head[0] = initialByte | 26;
+    headLength = 5;
+  }
+  else
+  {
+    head[0] = initialByte | 27;
+    headLength = 9;
+  }
+  // The argument follows in network byte order
+  for (size_t ii = 1; ii < headLength; ++ii)
+  {
+    head[ii] = static_cast<unsigned char>(value >> (8 * (headLength - 1 - ii)));
+  }
+  outputStream.write(reinterpret_cast<const char *>(head), headLength);
+}
+
+void
+writeCBORMapEntries(std::ostream & outputStream, const cbor_item_t * map)
+{
+  const size_t size = cbor_map_size(map);
+  const struct cbor_pair * pairs = cbor_map_handle(map);
+  for (size_t ii = 0; ii < size; ++ii)
+  {
+    writeCBORItem(outputStream, pairs[ii].key);
+    writeCBORItem(outputStream, pairs[ii].value);
+  }
+}
+
+void
+writeCBORTypedArrayHead(std::ostream & outputStream, const char * dataName, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent)
+{
+  const uint64_t tag = cborTypedArrayTag(ioComponent);
+  const size_t dataNameLength = std::strlen(dataName);
+  writeCBORHead(outputStream, 3, dataNameLength);
+  outputStream.write(dataName, dataNameLength);
+  writeCBORHead(outputStream, 6, tag);
+  writeCBORHead(outputStream, 2, numberOfBytesToWrite);
+}
+
+void
+writeCBORTypedArray(std::ostream & outputStream, const char * dataName, const void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent)
+{
+  writeCBORTypedArrayHead(outputStream, dataName, numberOfBytesToWrite, ioComponent);
+  outputStream.write(static_cast<const char *>(buffer), numberOfBytesToWrite);
+  if (!outputStream)
+  {
+    throw std::runtime_error("Could not write the CBOR typed array");
+  }
 }
 
 size_t
@@ -271,4 +508,124 @@ ITKComponentSize(const CommonEnums::IOComponent itkComponentType)
     }
 }
 
+MappedFile::MappedFile(const std::string & fileName, bool copyOnWrite)
+{
+#ifdef ITK_WASM_HAVE_MMAP
+  const int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+  if (fileDescriptor < 0)
+  {
+    throw std::runtime_error("Could not open file: " + fileName);
+  }
+  struct stat fileStat;
+  if (fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0)
+  {
+    // Private mappings are never written back to the file
+    const int protection = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+    void * mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), protection, MAP_PRIVATE, fileDescriptor, 0);
+    if (mapped != MAP_FAILED)
+    {
+      madvise(mapped, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+      m_Data = static_cast<const unsigned char *>(mapped);
+      m_Length = static_cast<size_t>(fileStat.st_size);
+      m_Mapped = true;
+    }
+  }
+  close(fileDescriptor);
+  if (m_Mapped)
+  {
+    return;
+  }
+#else
+  (void)copyOnWrite;
+#endif
+  std::ifstream inputStream;
+  openFileForReading(inputStream, fileName);
+  inputStream.seekg(0, std::ios::end);
+  m_Buffer.resize(static_cast<size_t>(inputStream.tellg()));
+  inputStream.seekg(0, std::ios::beg);
+  if (!m_Buffer.empty() && !readBufferAsBinary(inputStream, m_Buffer.data(), m_Buffer.size()))
+  {
+    throw std::runtime_error("Could not successfully read " + fileName);
+  }
+  m_Data = m_Buffer.data();
+  m_Length = m_Buffer.size();
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef ITK_WASM_HAVE_MMAP
+  if (m_Mapped)
+  {
+    munmap(const_cast<unsigned char *>(m_Data), m_Length);
+  }
+#endif
+}
+
+std::vector<std::pair<std::string_view, CBORSpan>>
+cborMapEntries(const unsigned char * buffer, size_t length, bool allowTruncated)
+{
+  size_t offset = 0;
+  const CBORHeader mapHeader = readCBORHeader(buffer, length, offset);
+  if (mapHeader.majorType != 5)
+  {
+    throw std::runtime_error("Expected a CBOR map");
+  }
+
+  std::vector<std::pair<std::string_view, CBORSpan>> entries;
+  for (uint64_t ii = 0; mapHeader.indefinite || ii < mapHeader.value; ++ii)
+  {
+    if (mapHeader.indefinite && atCBORBreak(buffer, length, offset))
+    {
+      break;
+    }
+    const CBORHeader keyHeader = readCBORHeader(buffer, length, offset);
+    if (keyHeader.majorType != 3 || keyHeader.indefinite || length - offset < keyHeader.value)
+    {
+      throw std::runtime_error("Expected a CBOR text string map key");
+    }
+    const std::string_view key(reinterpret_cast<const char *>(buffer + offset), keyHeader.value);
+    offset += keyHeader.value;
+
+    const size_t valueOffset = offset;
+    if (allowTruncated && isTruncatedByteString(buffer, length, offset))
+    {
+      entries.emplace_back(key, CBORSpan{ buffer + valueOffset, length - valueOffset });
+      break;
+    }
+    skipCBORItem(buffer, length, offset);
+    entries.emplace_back(key, CBORSpan{ buffer + valueOffset, offset - valueOffset });
+  }
+  return entries;
+}
+
+CBORSpan
+cborByteStringContent(const CBORSpan & item)
+{
+  size_t offset = 0;
+  CBORHeader header = readCBORHeader(item.data, item.length, offset);
+  if (header.majorType == 6)
+  {
+    header = readCBORHeader(item.data, item.length, offset);
+  }
+  if (header.majorType != 2 || header.indefinite || item.length - offset < header.value)
+  {
+    throw std::runtime_error("Expected a definite length CBOR byte string");
+  }
+  return CBORSpan{ item.data + offset, static_cast<size_t>(header.value) };
+}
+
+CBORItemPointer
+cborLoadItem(const CBORSpan & item)
+{
+  struct cbor_load_result result;
+  CBORItemPointer loaded(cbor_load(item.data, item.length, &result));
+  if (loaded == nullptr || result.error.code != CBOR_ERR_NONE)
+  {
+    std::ostringstream ostrm;
+    ostrm << "Could not decode the CBOR item near byte " << result.error.position;
+    throw std::runtime_error(ostrm.str());
+  }
+  return loaded;
+}
+
 } // end namespace itk
@@ -30,15 +30,72 @@
 #include "itkWasmIOCommon.h"
 
 #include "itkIOCommon.h"
+#include "itkMultiThreaderBase.h"
 #include "itksys/SystemTools.hxx"
 
 #include "itksys/SystemTools.hxx"
 
 #include "cbor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <vector>
+
 namespace itk
 {
 
+namespace
+{
+
+/** Copy an N-D block of pixels between buffers that each hold an N-D region.
+ * The source is sampled every sourceStep pixels along each axis. */
+void
+copyPixelBlock(const char * source, const std::vector<SizeValueType> & sourceSize, const std::vector<SizeValueType> & sourceStart, SizeValueType sourceStep,
+  char * destination, const std::vector<SizeValueType> & destinationSize, const std::vector<SizeValueType> & destinationStart,
+  const std::vector<SizeValueType> & blockSize, SizeValueType pixelSize)
+{
+  const size_t dimension = blockSize.size();
+  SizeValueType rows = 1;
+  for (size_t dim = 1; dim < dimension; ++dim)
+  {
+    rows *= blockSize[dim];
+  }
+
+  for (SizeValueType row = 0; row < rows; ++row)
+  {
+    SizeValueType sourceOffset = sourceStart[0];
+    SizeValueType destinationOffset = destinationStart[0];
+    SizeValueType sourceStride = sourceSize[0];
+    SizeValueType destinationStride = destinationSize[0];
+    SizeValueType remainder = row;
+    for (size_t dim = 1; dim < dimension; ++dim)
+    {
+      const SizeValueType index = remainder % blockSize[dim];
+      remainder /= blockSize[dim];
+      sourceOffset += (sourceStart[dim] + index * sourceStep) * sourceStride;
+      destinationOffset += (destinationStart[dim] + index) * destinationStride;
+      sourceStride *= sourceSize[dim];
+      destinationStride *= destinationSize[dim];
+    }
+
+    if (sourceStep == 1)
+    {
+      std::memcpy(destination + destinationOffset * pixelSize, source + sourceOffset * pixelSize, blockSize[0] * pixelSize);
+    }
+    else
+    {
+      for (SizeValueType xx = 0; xx < blockSize[0]; ++xx)
+      {
+        std::memcpy(destination + (destinationOffset + xx) * pixelSize, source + (sourceOffset + xx * sourceStep) * pixelSize, pixelSize);
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
 WasmImageIO
 ::WasmImageIO()
 {
@@ -69,6 +126,27 @@ WasmImageIO
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "ChunkSize:";
+  for (const auto chunkSize : this->m_ChunkSize)
+  {
+    os << ' ' << chunkSize;
+  }
+  os << std::endl;
+  os << indent << "NumberOfResolutionLevels: " << this->m_NumberOfResolutionLevels << std::endl;
+  os << indent << "ResolutionLevel: " << this->m_ResolutionLevel << std::endl;
+}
+
+
+void
+WasmImageIO
+::SetChunkSize(const std::vector<SizeValueType> & chunkSize)
+{
+  if (this->m_ChunkSize != chunkSize)
+  {
+    this->m_ChunkSize = chunkSize;
+    this->Modified();
+  }
 }
 
 
@@ -142,75 +220,65 @@ WasmImageIO
 
 void
 WasmImageIO
-::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
+::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength, bool headerOnly )
 {
-  bool cborBufferAllocated = false;
+  // Map the file instead of reading it into memory. Only the small entries
+  // are decoded, the pixel data is copied once from the mapping.
+  std::unique_ptr<MappedFile> mappedFile;
+  const unsigned char * cborData = cborBuffer;
   size_t length = cborBufferLength;
-  if (cborBuffer == nullptr)
+  if (cborData == nullptr)
   {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
+    try
+    {
+      mappedFile = std::make_unique<MappedFile>(this->GetFileName());
     }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
+    catch (const std::exception & error)
     {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+      itkExceptionMacro(<< error.what());
     }
-    fclose(file);
+    cborData = mappedFile->GetData();
+    length = mappedFile->GetLength();
   }
 
-  struct cbor_load_result result;
-  cbor_item_t* index = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  std::vector<std::pair<std::string_view, CBORSpan>> entries;
+  try
   {
-    free(cborBuffer);
+    entries = cborMapEntries(cborData, length, headerOnly);
   }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
-      }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
-      }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
-      }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
-      }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
-      }
-      case CBOR_ERR_NONE: {
-        break;
-      }
-    }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
+  catch (const std::exception & error)
+  {
+    itkExceptionMacro("There was an error while reading the input: " << error.what());
   }
 
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+  const auto loadItem = [this](std::string_view key, const CBORSpan & value) {
+    try
+    {
+      return cborLoadItem(value);
+    }
+    catch (const std::exception & error)
+    {
+      itkExceptionMacro("There was an error while reading " << key << ": " << error.what());
+    }
+  };
+  const auto byteStringContent = [this](std::string_view key, const CBORSpan & value) {
+    try
+    {
+      return cborByteStringContent(value);
+    }
+    catch (const std::exception & error)
+    {
+      itkExceptionMacro("There was an error while reading " << key << ": " << error.what());
+    }
+  };
+
+  for (const auto & [key, value] : entries)
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
     if (key == "imageType")
     {
-      const cbor_item_t * imageTypeItem = indexHandle[ii].value;
-      const size_t imageTypeCount = cbor_map_size(imageTypeItem);
-      const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem);
+      const CBORItemPointer imageTypeItem = loadItem(key, value);
+      const size_t imageTypeCount = cbor_map_size(imageTypeItem.get());
+      const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem.get());
       for (size_t jj = 0; jj < imageTypeCount; ++jj)
       {
         const std::string_view imageTypeKey(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].key)), cbor_string_length(imageTypeHandle[jj].key));
@@ -244,8 +312,9 @@ WasmImageIO
     }
     else if (key == "origin")
     {
-      const auto originHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t originSize = cbor_array_size(indexHandle[ii].value);
+      const CBORItemPointer originItem = loadItem(key, value);
+      const auto originHandle = cbor_array_handle(originItem.get());
+      const size_t originSize = cbor_array_size(originItem.get());
       for( int dim = 0; dim < originSize; ++dim )
         {
         const auto item = originHandle[dim];
@@ -254,8 +323,9 @@ WasmImageIO
     }
     else if (key == "spacing")
     {
-      const auto spacingHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t spacingSize = cbor_array_size(indexHandle[ii].value);
+      const CBORItemPointer spacingItem = loadItem(key, value);
+      const auto spacingHandle = cbor_array_handle(spacingItem.get());
+      const size_t spacingSize = cbor_array_size(spacingItem.get());
       for( int dim = 0; dim < spacingSize; ++dim )
         {
         const auto item = spacingHandle[dim];
@@ -264,8 +334,9 @@ WasmImageIO
     }
     else if (key == "size")
     {
-      const auto sizeHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t sizeSize = cbor_array_size(indexHandle[ii].value);
+      const CBORItemPointer sizeItem = loadItem(key, value);
+      const auto sizeHandle = cbor_array_handle(sizeItem.get());
+      const size_t sizeSize = cbor_array_size(sizeItem.get());
       for( int dim = 0; dim < sizeSize; ++dim )
         {
         const auto item = sizeHandle[dim];
@@ -274,9 +345,11 @@ WasmImageIO
     }
     else if (key == "direction")
     {
-      cbor_item_t * directionItem = cbor_tag_item(indexHandle[ii].value);
-      const double * directionHandle = reinterpret_cast< double * >( cbor_bytestring_handle(directionItem) );
-      const size_t directionSize = cbor_bytestring_length(directionItem);
+      const CBORSpan directionContent = byteStringContent(key, value);
+      // The byte string content is not necessarily aligned for double
+      std::vector< double > directionHandle( directionContent.length / sizeof(double) );
+      std::memcpy(directionHandle.data(), directionContent.data, directionHandle.size() * sizeof(double));
+      const size_t directionSize = directionContent.length;
       const unsigned int dimension = std::sqrt( directionSize / sizeof(double) );
       for( unsigned int jj = 0; jj < dimension; ++jj )
         {
@@ -294,9 +367,12 @@ WasmImageIO
       {
         const SizeValueType numberOfBytesToBeRead =
           static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-        const cbor_item_t * dataItem = cbor_tag_item(indexHandle[ii].value);
-        const char * dataHandle = reinterpret_cast< char * >( cbor_bytestring_handle(dataItem) );
-        std::memcpy(buffer, dataHandle, numberOfBytesToBeRead);
+        const CBORSpan dataContent = byteStringContent(key, value);
+        if (dataContent.length < numberOfBytesToBeRead)
+        {
+          itkExceptionMacro("Read failed: Wanted " << numberOfBytesToBeRead << " bytes, but the data has " << dataContent.length << " bytes.");
+        }
+        std::memcpy(buffer, dataContent.data, numberOfBytesToBeRead);
       }
     }
     else if (key == "metadata")
@@ -308,15 +384,37 @@ WasmImageIO
       itkExceptionMacro("Unexpected cbor map key: " << key);
     }
   }
+}
 
-  cbor_decref(&index);
+void
+WasmImageIO
+::WriteCBOR(std::ostream & outputStream, const void *buffer)
+{
+  this->WriteCBORHeader(outputStream, buffer != nullptr);
+
+  if( buffer != nullptr )
+  {
+    const SizeValueType numberOfBytesToWrite =
+      static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+    outputStream.write(static_cast< const char * >( buffer ), numberOfBytesToWrite);
+  }
+
+  if ( !outputStream )
+  {
+    itkExceptionMacro(<< "Failed to write the CBOR encoding to " << this->GetFileName());
+  }
 }
 
-size_t
+
+void
 WasmImageIO
-::WriteCBOR(const void *buffer, unsigned char ** cborBufferPtr, bool allocateCBORBuffer )
+::WriteCBORHeader(std::ostream & outputStream, bool withData)
 {
-  cbor_item_t * index  = cbor_new_definite_map(7);
+  // The map head is followed by the small fields, encoded by libcbor, and the
+  // typed arrays, which are written directly from their buffers.
+  writeCBORHead(outputStream, 5, withData ? 7 : 6);
+
+  cbor_item_t * index  = cbor_new_definite_map(3);
 
   cbor_item_t * imageTypeItem = cbor_new_definite_map(4);
   cbor_map_add(imageTypeItem,
@@ -364,6 +462,9 @@ WasmImageIO
       cbor_move(cbor_build_string("spacing")),
       cbor_move(spacingItem)});
 
+  writeCBORMapEntries(outputStream, index);
+  cbor_decref(&index);
+
   std::vector< double > direction( dimension * dimension );
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
@@ -373,13 +474,9 @@ WasmImageIO
       direction[jj + ii*dimension] = dimensionDirection[jj];
       }
     }
-  cbor_item_t * directionItem = cbor_build_bytestring(reinterpret_cast<unsigned char *>(&(direction.at(0))), dimension*dimension*sizeof(double));
-  cbor_item_t * directionTag = cbor_new_tag(86);
-  cbor_tag_set_item(directionTag, cbor_move(directionItem));
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("direction")),
-      cbor_move(directionTag)});
+  writeCBORTypedArray(outputStream, "direction", &(direction.at(0)), dimension*dimension*sizeof(double), IOComponentEnum::DOUBLE);
+
+  index  = cbor_new_definite_map(2);
 
   cbor_item_t * sizeItem = cbor_new_definite_array(dimension);
   for( unsigned int ii = 0; ii < dimension; ++ii )
@@ -397,82 +494,15 @@ WasmImageIO
       cbor_move(cbor_build_string("metadata")),
       cbor_move(metaDataItem)});
 
-  if( buffer != nullptr )
+  writeCBORMapEntries(outputStream, index);
+  cbor_decref(&index);
+
+  if( withData )
   {
     const SizeValueType numberOfBytesToWrite =
       static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-    cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-    uint64_t tag = 0;
-    // Todo: support endianness
-    // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
-    switch (this->GetComponentType()) {
-      case IOComponentEnum::CHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::UCHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::SHORT:
-        tag = 73;
-        break;
-      case IOComponentEnum::USHORT:
-        tag = 69;
-        break;
-      case IOComponentEnum::INT:
-        tag = 74;
-        break;
-      case IOComponentEnum::UINT:
-        tag = 70;
-        break;
-      case IOComponentEnum::LONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::LONGLONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONGLONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::FLOAT:
-        tag = 85;
-        break;
-      case IOComponentEnum::DOUBLE:
-        tag = 86;
-        break;
-      default:
-        itkExceptionMacro("Unexpected component type");
-    }
-    cbor_item_t * dataTag = cbor_new_tag(tag);
-    cbor_tag_set_item(dataTag, cbor_move(dataItem));
-    cbor_map_add(index,
-      cbor_pair{
-        cbor_move(cbor_build_string("data")),
-        cbor_move(dataTag)});
+    writeCBORTypedArrayHead(outputStream, "data", numberOfBytesToWrite, this->GetComponentType());
   }
-
-  size_t cborBufferSize;
-  size_t length;
-  unsigned char * cborBuffer;
-
-  if (allocateCBORBuffer)
-  {
-    length = cbor_serialize_alloc(index, cborBufferPtr, &cborBufferSize);
-  }
-  else
-  {
-    length = cbor_serialize_alloc(index, &cborBuffer, &cborBufferSize);
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
-  }
-
-  cbor_decref(&index);
-
-  return length;
 }
 
 
@@ -508,6 +538,31 @@ WasmImageIO
 
   const unsigned int dimension = imageJSON.imageType.dimension;
 
+  this->m_ChunkedLayout = imageJSON.chunkedLayout;
+  if (this->m_ChunkedLayout)
+  {
+    if (this->m_ChunkedLayout->chunkSize.size() != dimension ||
+        std::find(this->m_ChunkedLayout->chunkSize.begin(), this->m_ChunkedLayout->chunkSize.end(), 0) != this->m_ChunkedLayout->chunkSize.end())
+    {
+      itkExceptionMacro("Invalid chunk size in " << indexPath);
+    }
+    if (this->m_ResolutionLevel >= this->m_ChunkedLayout->levels)
+    {
+      itkExceptionMacro("Resolution level " << this->m_ResolutionLevel << " requested, but " << path << " has " << this->m_ChunkedLayout->levels << " levels");
+    }
+    // Level l samples every 2^l-th pixel, starting at the origin
+    const SizeValueType factor = SizeValueType{ 1 } << this->m_ResolutionLevel;
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      this->SetDimensions(dim, (imageJSON.size[dim] + factor - 1) / factor);
+      this->SetSpacing(dim, imageJSON.spacing[dim] * factor);
+    }
+  }
+  else if (this->m_ResolutionLevel != 0)
+  {
+    itkExceptionMacro("Resolution level " << this->m_ResolutionLevel << " requested, but " << path << " is not chunked");
+  }
+
   const auto dataPath = path + "/data";
   const auto directionPath = dataPath +  "/direction.raw";
   std::ifstream directionStream;
@@ -526,6 +581,24 @@ WasmImageIO
 }
 
 
+std::string
+WasmImageIO
+::GetDataFileName() const
+{
+  const std::string path(this->GetFileName());
+
+  std::string::size_type cborPos = path.rfind(".cbor");
+  if ( ( ( cborPos != std::string::npos )
+         && ( cborPos == path.length() - 5 ) )
+       || this->m_ChunkedLayout )
+  {
+    return std::string();
+  }
+
+  return path + "/data/data.raw";
+}
+
+
 void
 WasmImageIO
 ::Read( void *buffer )
@@ -540,6 +613,12 @@ WasmImageIO
     return;
   }
 
+  if (this->m_ChunkedLayout)
+  {
+    this->ReadChunks(buffer);
+    return;
+  }
+
   const std::string dataFile = (path + "/data/data.raw").c_str();
   std::ifstream dataStream;
   this->OpenFileForReading( dataStream, dataFile.c_str() );
@@ -635,6 +714,20 @@ WasmImageIO
 
   imageJSON.data = "data:application/vnd.itk.path,data/data.raw";
 
+  if (!this->m_ChunkSize.empty())
+  {
+    ImageChunkedLayoutJSON chunkedLayout;
+    for( unsigned int ii = 0; ii < dimension; ++ii )
+    {
+      const SizeValueType chunkSize = this->m_ChunkSize.size() == 1 ? this->m_ChunkSize[0] : this->m_ChunkSize.at(ii);
+      chunkedLayout.chunkSize.push_back(std::max(chunkSize, SizeValueType{ 1 }));
+    }
+    chunkedLayout.levels = this->m_NumberOfResolutionLevels;
+    chunkedLayout.compression = this->GetChunkCompression();
+    imageJSON.chunkedLayout = chunkedLayout;
+    imageJSON.data = "data:application/vnd.itk.path,data/chunks";
+  }
+
   auto dictionary = this->GetMetaDataDictionary();
   metaDataDictionaryToJSON(dictionary, imageJSON.metadata);
 
@@ -706,7 +799,19 @@ WasmImageIO
   if ( ( cborPos != std::string::npos )
        && ( cborPos == path.length() - 5 ) )
   {
-    this->WriteCBOR(buffer);
+    std::ofstream outputStream;
+    openFileForWriting(outputStream, path, true, false);
+    this->WriteCBOR(outputStream, buffer);
+    return;
+  }
+
+  if (!this->m_ChunkSize.empty())
+  {
+    if (!this->RequestedToStream() || !itksys::SystemTools::FileExists(path + "/index.json", true))
+    {
+      this->WriteImageInformation();
+    }
+    this->WriteChunks(buffer);
     return;
   }
 
@@ -745,4 +850,215 @@ WasmImageIO
   }
 }
 
+
+std::string
+WasmImageIO
+::GetChunkFileName(unsigned int level, const std::vector<SizeValueType> & chunkIndex, const std::string & compression) const
+{
+  std::ostringstream fileName;
+  fileName << "data/chunks/" << level << '/';
+  for (size_t dim = 0; dim < chunkIndex.size(); ++dim)
+  {
+    fileName << (dim == 0 ? "" : ".") << chunkIndex[dim];
+  }
+  fileName << (compression == "zstd" ? ".raw.zst" : ".raw");
+  return fileName.str();
+}
+
+
+void
+WasmImageIO
+::ReadChunk(const std::string & fileName, const std::string & compression, void * buffer, SizeValueType numberOfBytes)
+{
+  if (!compression.empty())
+  {
+    itkExceptionMacro("Chunks compressed with " << compression << " are read by WasmZstdImageIO");
+  }
+  std::ifstream inputStream;
+  this->OpenFileForReading( inputStream, fileName );
+  if ( !readBufferAsBinary( inputStream, buffer, numberOfBytes ) )
+  {
+    itkExceptionMacro(<< "Read failed: Wanted " << numberOfBytes << " bytes, but read " << inputStream.gcount() << " bytes from " << fileName);
+  }
+}
+
+
+void
+WasmImageIO
+::WriteChunk(const std::string & fileName, const std::string & compression, const void * buffer, SizeValueType numberOfBytes)
+{
+  if (!compression.empty())
+  {
+    itkExceptionMacro("Chunks compressed with " << compression << " are written by WasmZstdImageIO");
+  }
+  std::ofstream outputStream;
+  this->OpenFileForWriting( outputStream, fileName, true, false );
+  outputStream.write(static_cast< const char * >( buffer ), numberOfBytes);
+  if ( !outputStream )
+  {
+    itkExceptionMacro(<< "Write failed: could not write " << numberOfBytes << " bytes to " << fileName);
+  }
+}
+
+
+void
+WasmImageIO
+::ReadChunks(void * buffer)
+{
+  const std::string path(this->GetFileName());
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const std::vector<SizeValueType> & chunkSize = this->m_ChunkedLayout->chunkSize;
+  const std::string & compression = this->m_ChunkedLayout->compression;
+
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const bool useIORegion = ioRegion.GetImageDimension() == dimension;
+  std::vector<SizeValueType> regionStart(dimension);
+  std::vector<SizeValueType> regionSize(dimension);
+  std::vector<SizeValueType> firstChunk(dimension);
+  std::vector<SizeValueType> numberOfChunks(dimension);
+  SizeValueType totalChunks = 1;
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    regionStart[dim] = useIORegion ? ioRegion.GetIndex(dim) : 0;
+    regionSize[dim] = useIORegion ? ioRegion.GetSize(dim) : this->GetDimensions(dim);
+    if (regionSize[dim] == 0)
+    {
+      return;
+    }
+    firstChunk[dim] = regionStart[dim] / chunkSize[dim];
+    numberOfChunks[dim] = (regionStart[dim] + regionSize[dim] - 1) / chunkSize[dim] - firstChunk[dim] + 1;
+    totalChunks *= numberOfChunks[dim];
+  }
+
+  // Chunks are independent, and overlap disjoint parts of the buffer
+  auto * output = static_cast<char *>(buffer);
+  const auto readChunk = [&](SizeValueType chunk) {
+    std::vector<SizeValueType> chunkIndex(dimension);
+    std::vector<SizeValueType> chunkExtent(dimension);
+    std::vector<SizeValueType> sourceStart(dimension);
+    std::vector<SizeValueType> destinationStart(dimension);
+    std::vector<SizeValueType> blockSize(dimension);
+    SizeValueType chunkPixels = 1;
+    SizeValueType remainder = chunk;
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      chunkIndex[dim] = firstChunk[dim] + remainder % numberOfChunks[dim];
+      remainder /= numberOfChunks[dim];
+      const SizeValueType chunkOrigin = chunkIndex[dim] * chunkSize[dim];
+      chunkExtent[dim] = std::min(chunkSize[dim], this->GetDimensions(dim) - chunkOrigin);
+      chunkPixels *= chunkExtent[dim];
+      const SizeValueType overlapStart = std::max(chunkOrigin, regionStart[dim]);
+      const SizeValueType overlapEnd = std::min(chunkOrigin + chunkExtent[dim], regionStart[dim] + regionSize[dim]);
+      sourceStart[dim] = overlapStart - chunkOrigin;
+      destinationStart[dim] = overlapStart - regionStart[dim];
+      blockSize[dim] = overlapEnd - overlapStart;
+    }
+
+    std::vector<char> chunkData(chunkPixels * pixelSize);
+    this->ReadChunk(path + "/" + this->GetChunkFileName(this->m_ResolutionLevel, chunkIndex, compression), compression, chunkData.data(), chunkData.size());
+    copyPixelBlock(chunkData.data(), chunkExtent, sourceStart, 1, output, regionSize, destinationStart, blockSize, pixelSize);
+  };
+
+  MultiThreaderBase::New()->ParallelizeArray(0, totalChunks, readChunk, nullptr);
+}
+
+
+void
+WasmImageIO
+::WriteChunks(const void * buffer)
+{
+  const std::string path(this->GetFileName());
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const std::string compression = this->GetChunkCompression();
+  std::vector<SizeValueType> chunkSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    chunkSize[dim] = std::max(this->m_ChunkSize.size() == 1 ? this->m_ChunkSize[0] : this->m_ChunkSize.at(dim), SizeValueType{ 1 });
+  }
+
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const bool useIORegion = ioRegion.GetImageDimension() == dimension;
+  std::vector<SizeValueType> regionStart(dimension);
+  std::vector<SizeValueType> regionSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    regionStart[dim] = useIORegion ? ioRegion.GetIndex(dim) : 0;
+    regionSize[dim] = useIORegion ? ioRegion.GetSize(dim) : this->GetDimensions(dim);
+  }
+
+  const auto * input = static_cast<const char *>(buffer);
+  for (unsigned int level = 0; level < this->m_NumberOfResolutionLevels; ++level)
+  {
+    // The pixels of the level sampled from the region written
+    const SizeValueType factor = SizeValueType{ 1 } << level;
+    std::vector<SizeValueType> levelSize(dimension);
+    std::vector<SizeValueType> levelStart(dimension);
+    std::vector<SizeValueType> levelEnd(dimension);
+    std::vector<SizeValueType> firstChunk(dimension);
+    std::vector<SizeValueType> numberOfChunks(dimension);
+    SizeValueType totalChunks = 1;
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      levelSize[dim] = (this->GetDimensions(dim) + factor - 1) / factor;
+      levelStart[dim] = (regionStart[dim] + factor - 1) / factor;
+      levelEnd[dim] = (regionStart[dim] + regionSize[dim] + factor - 1) / factor;
+      if (levelEnd[dim] <= levelStart[dim])
+      {
+        totalChunks = 0;
+        break;
+      }
+      firstChunk[dim] = levelStart[dim] / chunkSize[dim];
+      numberOfChunks[dim] = (levelEnd[dim] - 1) / chunkSize[dim] - firstChunk[dim] + 1;
+      totalChunks *= numberOfChunks[dim];
+    }
+    if (totalChunks == 0)
+    {
+      continue;
+    }
+
+    std::ostringstream levelPath;
+    levelPath << path << "/data/chunks/" << level;
+    itksys::SystemTools::MakeDirectory(levelPath.str());
+
+    const auto writeChunk = [&](SizeValueType chunk) {
+      std::vector<SizeValueType> chunkIndex(dimension);
+      std::vector<SizeValueType> chunkExtent(dimension);
+      std::vector<SizeValueType> sourceStart(dimension);
+      std::vector<SizeValueType> destinationStart(dimension);
+      std::vector<SizeValueType> blockSize(dimension);
+      SizeValueType chunkPixels = 1;
+      bool wholeChunk = true;
+      SizeValueType remainder = chunk;
+      for (unsigned int dim = 0; dim < dimension; ++dim)
+      {
+        chunkIndex[dim] = firstChunk[dim] + remainder % numberOfChunks[dim];
+        remainder /= numberOfChunks[dim];
+        const SizeValueType chunkOrigin = chunkIndex[dim] * chunkSize[dim];
+        chunkExtent[dim] = std::min(chunkSize[dim], levelSize[dim] - chunkOrigin);
+        chunkPixels *= chunkExtent[dim];
+        const SizeValueType overlapStart = std::max(chunkOrigin, levelStart[dim]);
+        const SizeValueType overlapEnd = std::min(chunkOrigin + chunkExtent[dim], levelEnd[dim]);
+        sourceStart[dim] = overlapStart * factor - regionStart[dim];
+        destinationStart[dim] = overlapStart - chunkOrigin;
+        blockSize[dim] = overlapEnd - overlapStart;
+        wholeChunk = wholeChunk && blockSize[dim] == chunkExtent[dim];
+      }
+
+      const std::string chunkFileName = path + "/" + this->GetChunkFileName(level, chunkIndex, compression);
+      std::vector<char> chunkData(chunkPixels * pixelSize);
+      // Streamed regions that cover part of a chunk update the chunk written before
+      if (!wholeChunk && itksys::SystemTools::FileExists(chunkFileName, true))
+      {
+        this->ReadChunk(chunkFileName, compression, chunkData.data(), chunkData.size());
+      }
+      copyPixelBlock(input, regionSize, sourceStart, factor, chunkData.data(), chunkExtent, destinationStart, blockSize, pixelSize);
+      this->WriteChunk(chunkFileName, compression, chunkData.data(), chunkData.size());
+    };
+
+    MultiThreaderBase::New()->ParallelizeArray(0, totalChunks, writeChunk, nullptr);
+  }
+}
+
 } // end namespace itk
@@ -34,6 +34,8 @@
 
 #include "cbor.h"
 
+#include <cstring>
+
 namespace itk
 {
 
@@ -50,6 +52,10 @@ WasmMeshIO
 WasmMeshIO
 ::~WasmMeshIO()
 {
+  if (this->m_CBORRoot != nullptr)
+  {
+    cbor_decref(&(this->m_CBORRoot));
+  }
 }
 
 
@@ -91,78 +97,57 @@ void
 WasmMeshIO
 ::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
 {
-  bool cborBufferAllocated = false;
+  // Only the top-level map is indexed. The buffers are copied from the
+  // mapped file, or the buffer provided, when they are read.
+  this->m_CBORSections.clear();
+  this->m_MappedCBOR.reset();
+  const unsigned char * cborData = cborBuffer;
   size_t length = cborBufferLength;
-  if (cborBuffer == nullptr)
+  if (cborData == nullptr)
   {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
+    try
+    {
+      this->m_MappedCBOR = std::make_unique<MappedFile>(this->GetFileName());
     }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
+    catch (const std::exception & error)
     {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
-
+      itkExceptionMacro(<< error.what());
     }
-    fclose(file);
+    cborData = this->m_MappedCBOR->GetData();
+    length = this->m_MappedCBOR->GetLength();
   }
 
-  if (this->m_CBORRoot != nullptr) {
-    cbor_decref(&(this->m_CBORRoot));
+  std::vector<std::pair<std::string_view, CBORSpan>> entries;
+  try
+  {
+    entries = cborMapEntries(cborData, length);
   }
-  struct cbor_load_result result;
-  this->m_CBORRoot = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  catch (const std::exception & error)
   {
-    free(cborBuffer);
+    itkExceptionMacro("There was an error while reading the input: " << error.what());
   }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
-      }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
-      }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
-      }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
-      }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
-      }
-      case CBOR_ERR_NONE: {
-        break;
-      }
+
+  const auto loadItem = [this](std::string_view key, const CBORSpan & value) {
+    try
+    {
+      return cborLoadItem(value);
     }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
-  }
+    catch (const std::exception & error)
+    {
+      itkExceptionMacro("There was an error while reading " << key << ": " << error.what());
+    }
+  };
+  const auto loadCount = [&loadItem](std::string_view key, const CBORSpan & value) {
+    return cbor_get_uint64(loadItem(key, value).get());
+  };
 
-  cbor_item_t * index = this->m_CBORRoot;
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+  for (const auto & [key, value] : entries)
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
     if (key == "meshType")
     {
-      const cbor_item_t * meshTypeItem = indexHandle[ii].value;
-      const size_t meshTypeCount = cbor_map_size(meshTypeItem);
-      const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem);
+      const CBORItemPointer meshTypeItem = loadItem(key, value);
+      const size_t meshTypeCount = cbor_map_size(meshTypeItem.get());
+      const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem.get());
       for (size_t jj = 0; jj < meshTypeCount; ++jj)
       {
         const std::string_view meshTypeKey(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].key)), cbor_string_length(meshTypeHandle[jj].key));
@@ -225,7 +210,7 @@ WasmMeshIO
     }
     else if (key == "numberOfPoints")
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
+      const auto components = loadCount(key, value);
       this->SetNumberOfPoints( components );
       if ( components )
         {
@@ -234,7 +219,7 @@ WasmMeshIO
     }
     else if (key == "numberOfPointPixels")
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
+      const auto components = loadCount(key, value);
       this->SetNumberOfPointPixels( components );
       if ( components )
         {
@@ -243,7 +228,7 @@ WasmMeshIO
     }
     else if (key == "numberOfCells")
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
+      const auto components = loadCount(key, value);
       this->SetNumberOfCells( components );
       if ( components )
         {
@@ -252,7 +237,7 @@ WasmMeshIO
     }
     else if (key == "numberOfCellPixels")
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
+      const auto components = loadCount(key, value);
       this->SetNumberOfCellPixels( components );
       if ( components )
         {
@@ -261,12 +246,41 @@ WasmMeshIO
     }
     else if (key == "cellBufferSize")
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
+      const auto components = loadCount(key, value);
       this->SetCellBufferSize( components );
     }
- }
+    else if (key == "points" || key == "cells" || key == "pointData" || key == "cellData")
+    {
+      try
+      {
+        this->m_CBORSections[std::string(key)] = cborByteStringContent(value);
+      }
+      catch (const std::exception & error)
+      {
+        itkExceptionMacro("There was an error while reading " << key << ": " << error.what());
+      }
+    }
+  }
 }
 
+
+void
+WasmMeshIO
+::ReadCBORSection( const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead )
+{
+  const auto section = this->m_CBORSections.find(dataName);
+  if (section == this->m_CBORSections.end())
+  {
+    itkExceptionMacro("Read failed: " << dataName << " is missing in " << this->GetFileName());
+  }
+  if (section->second.length < numberOfBytesToBeRead)
+  {
+    itkExceptionMacro("Read failed: Wanted " << numberOfBytesToBeRead << " bytes, but " << dataName << " has " << section->second.length << " bytes.");
+  }
+  std::memcpy(buffer, section->second.data, numberOfBytesToBeRead);
+}
+
+
 auto
 WasmMeshIO
 ::GetJSON() -> MeshJSON
@@ -345,7 +359,8 @@ WasmMeshIO
   if (this->m_CBORRoot != nullptr) {
     cbor_decref(&(this->m_CBORRoot));
   }
-  this->m_CBORRoot = cbor_new_definite_map(10);
+  this->m_CBOROutputStream.reset();
+  this->m_CBORRoot = cbor_new_definite_map(6);
 
   cbor_item_t * index = this->m_CBORRoot;
   cbor_item_t * meshTypeItem = cbor_new_definite_map(9);
@@ -400,42 +415,75 @@ WasmMeshIO
     cbor_pair{
       cbor_move(cbor_build_string("numberOfPoints")),
       cbor_move(cbor_build_uint64(this->GetNumberOfPoints()))});
-  if ( this->GetNumberOfPoints() )
-    {
-    this->m_UpdatePoints = true;
-    }
+  this->m_UpdatePoints = this->GetNumberOfPoints() > 0;
 
   cbor_map_add(index,
     cbor_pair{
       cbor_move(cbor_build_string("numberOfPointPixels")),
       cbor_move(cbor_build_uint64(this->GetNumberOfPointPixels()))});
-  if ( this->GetNumberOfPointPixels() )
-    {
-    this->m_UpdatePointData = true;
-    }
+  this->m_UpdatePointData = this->GetNumberOfPointPixels() > 0;
 
   cbor_map_add(index,
       cbor_pair{
         cbor_move(cbor_build_string("numberOfCells")),
         cbor_move(cbor_build_uint64(this->GetNumberOfCells()))});
-  if ( this->GetNumberOfCells() )
-    {
-    this->m_UpdateCells = true;
-    }
+  this->m_UpdateCells = this->GetNumberOfCells() > 0;
 
   cbor_map_add(index,
       cbor_pair{
         cbor_move(cbor_build_string("numberOfCellPixels")),
         cbor_move(cbor_build_uint64(this->GetNumberOfCellPixels()))});
-  if ( this->GetNumberOfCellPixels() )
-    {
-    this->m_UpdateCellData = true;
-    }
+  this->m_UpdateCellData = this->GetNumberOfCellPixels() > 0;
 
   cbor_map_add(index,
       cbor_pair{
         cbor_move(cbor_build_string("cellBufferSize")),
         cbor_move(cbor_build_uint64(this->GetCellBufferSize()))});
+
+  this->m_PendingCBORBuffers = static_cast<unsigned int>(this->m_UpdatePoints) + static_cast<unsigned int>(this->m_UpdateCells) +
+    static_cast<unsigned int>(this->m_UpdatePointData) + static_cast<unsigned int>(this->m_UpdateCellData);
+}
+
+
+std::unique_ptr<std::ostream>
+WasmMeshIO
+::CreateCBOROutputStream()
+{
+  auto outputStream = std::make_unique<std::ofstream>();
+  openFileForWriting(*outputStream, this->GetFileName(), true, false);
+  return outputStream;
+}
+
+
+void
+WasmMeshIO
+::CountCBORBufferWritten()
+{
+  if (this->m_PendingCBORBuffers == 0)
+  {
+    itkExceptionMacro(<< "Unexpected data buffer for " << this->GetFileName());
+  }
+  --(this->m_PendingCBORBuffers);
+}
+
+
+std::ostream &
+WasmMeshIO
+::GetCBOROutputStream()
+{
+  if (this->m_CBOROutputStream == nullptr)
+  {
+    if (this->m_CBORRoot == nullptr)
+    {
+      itkExceptionMacro("Call WriteMeshInformation before writing the data buffers");
+    }
+    // The map head counts the buffers that will follow the mesh information
+    this->m_CBOROutputStream = this->CreateCBOROutputStream();
+    writeCBORHead(*(this->m_CBOROutputStream), 5, cbor_map_size(this->m_CBORRoot) + this->m_PendingCBORBuffers);
+    writeCBORMapEntries(*(this->m_CBOROutputStream), this->m_CBORRoot);
+    cbor_decref(&(this->m_CBORRoot));
+  }
+  return *(this->m_CBOROutputStream);
 }
 
 void
@@ -498,7 +546,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "points", buffer, numberOfBytesToBeRead);
+    this->ReadCBORSection("points", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -526,7 +574,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "cells", buffer, numberOfBytesToBeRead);
+    this->ReadCBORSection("cells", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -555,7 +603,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "pointData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORSection("pointData", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -584,7 +632,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "cellData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORSection("cellData", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -697,7 +745,9 @@ WasmMeshIO
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "points", buffer, numberOfBytes, this->GetPointComponentType() );
+    std::ostream & outputStream = this->GetCBOROutputStream();
+    this->CountCBORBufferWritten();
+    writeCBORTypedArray(outputStream, "points", buffer, numberOfBytes, this->GetPointComponentType() );
     return;
   }
 
@@ -725,7 +775,9 @@ WasmMeshIO
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "cells", buffer, numberOfBytes, this->GetCellComponentType() );
+    std::ostream & outputStream = this->GetCBOROutputStream();
+    this->CountCBORBufferWritten();
+    writeCBORTypedArray(outputStream, "cells", buffer, numberOfBytes, this->GetCellComponentType() );
     return;
   }
 
@@ -753,7 +805,9 @@ WasmMeshIO
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "pointData", buffer, numberOfBytes, this->GetPointPixelComponentType() );
+    std::ostream & outputStream = this->GetCBOROutputStream();
+    this->CountCBORBufferWritten();
+    writeCBORTypedArray(outputStream, "pointData", buffer, numberOfBytes, this->GetPointPixelComponentType() );
     return;
   }
 
@@ -777,11 +831,13 @@ void
 WasmMeshIO
 ::WriteCellData( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetNumberOfPointPixels() * this->GetNumberOfPointPixelComponents() * ITKComponentSize( this->GetCellPixelComponentType() );
+  const SizeValueType numberOfBytes = this->GetNumberOfCellPixels() * this->GetNumberOfCellPixelComponents() * ITKComponentSize( this->GetCellPixelComponentType() );
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "cellData", buffer, numberOfBytes, this->GetCellPixelComponentType() );
+    std::ostream & outputStream = this->GetCBOROutputStream();
+    this->CountCBORBufferWritten();
+    writeCBORTypedArray(outputStream, "cellData", buffer, numberOfBytes, this->GetCellPixelComponentType() );
     return;
   }
 
@@ -806,16 +862,17 @@ WasmMeshIO
 {
   if (fileNameIsCBOR(this->GetFileName()))
     {
-    unsigned char* cborBuffer;
-    size_t cborBufferSize;
-    size_t length = cbor_serialize_alloc(this->m_CBORRoot, &cborBuffer, &cborBufferSize);
-
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
-
-    cbor_decref(&(this->m_CBORRoot));
+    std::ostream & outputStream = this->GetCBOROutputStream();
+    if (this->m_PendingCBORBuffers != 0)
+      {
+      itkExceptionMacro(<< "Missing " << this->m_PendingCBORBuffers << " data buffers for " << this->GetFileName());
+      }
+    outputStream.flush();
+    if (!outputStream)
+      {
+      itkExceptionMacro(<< "Failed to write the CBOR encoding to " << this->GetFileName());
+      }
+    this->m_CBOROutputStream.reset();
     }
 }
 
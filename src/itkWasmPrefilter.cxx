@@ -0,0 +1,423 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmPrefilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+
+constexpr uint32_t PrefilterFrameMagicNumber = 0x184D2A50;
+constexpr unsigned char PrefilterFrameSignature[4] = { 'I', 'T', 'K', 'P' };
+
+// Loads and stores through memcpy do not require aligned buffers, and
+// compilers turn them into plain vector loads and stores
+template <typename T>
+inline T
+loadElement(const unsigned char * data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+template <typename T>
+inline void
+storeElement(unsigned char * data, T value)
+{
+  std::memcpy(data, &value, sizeof(T));
+}
+
+template <typename T>
+void
+deltaEncode(const unsigned char * input, unsigned char * output, size_t count, size_t rowLength)
+{
+  const size_t firstRow = std::min(rowLength, count);
+  std::memcpy(output, input, firstRow * sizeof(T));
+  for (size_t ii = firstRow; ii < count; ++ii)
+  {
+    const T value = loadElement<T>(input + ii * sizeof(T)) - loadElement<T>(input + (ii - rowLength) * sizeof(T));
+    storeElement<T>(output + ii * sizeof(T), value);
+  }
+}
+
+template <typename T>
+void
+deltaDecode(unsigned char * data, size_t count, size_t rowLength)
+{
+  // Rows depend on the previous row, but the elements of a row do not
+  // depend on each other, so the inner loop vectorizes
+  for (size_t rowBegin = rowLength; rowBegin < count; rowBegin += rowLength)
+  {
+    const size_t rowEnd = std::min(rowBegin + rowLength, count);
+    unsigned char * row = data + rowBegin * sizeof(T);
+    const unsigned char * previousRow = row - rowLength * sizeof(T);
+    for (size_t ii = 0; ii < rowEnd - rowBegin; ++ii)
+    {
+      const T value = loadElement<T>(row + ii * sizeof(T)) + loadElement<T>(previousRow + ii * sizeof(T));
+      storeElement<T>(row + ii * sizeof(T), value);
+    }
+  }
+}
+
+template <size_t ElementSize>
+void
+shuffle(const unsigned char * input, unsigned char * output, size_t count)
+{
+  size_t ii = 0;
+#if defined(__SSE2__)
+  if constexpr (ElementSize == 2)
+  {
+    const __m128i lowMask = _mm_set1_epi16(0x00ff);
+    for (; ii + 16 <= count; ii += 16)
+    {
+      const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii * 2));
+      const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii * 2 + 16));
+      const __m128i low = _mm_packus_epi16(_mm_and_si128(first, lowMask), _mm_and_si128(second, lowMask));
+      const __m128i high = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + ii), low);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + count + ii), high);
+    }
+  }
+#elif defined(__wasm_simd128__)
+  if constexpr (ElementSize == 2)
+  {
+    for (; ii + 16 <= count; ii += 16)
+    {
+      const v128_t first = wasm_v128_load(input + ii * 2);
+      const v128_t second = wasm_v128_load(input + ii * 2 + 16);
+      const v128_t low = wasm_i8x16_shuffle(first, second, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+      const v128_t high = wasm_i8x16_shuffle(first, second, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+      wasm_v128_store(output + ii, low);
+      wasm_v128_store(output + count + ii, high);
+    }
+  }
+#endif
+  for (; ii < count; ++ii)
+  {
+    for (size_t byte = 0; byte < ElementSize; ++byte)
+    {
+      output[byte * count + ii] = input[ii * ElementSize + byte];
+    }
+  }
+}
+
+template <size_t ElementSize>
+void
+unshuffle(const unsigned char * input, unsigned char * output, size_t count)
+{
+  size_t ii = 0;
+#if defined(__SSE2__)
+  if constexpr (ElementSize == 2)
+  {
+    for (; ii + 16 <= count; ii += 16)
+    {
+      const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + ii));
+      const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + count + ii));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + ii * 2), _mm_unpacklo_epi8(low, high));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(output + ii * 2 + 16), _mm_unpackhi_epi8(low, high));
+    }
+  }
+#elif defined(__wasm_simd128__)
+  if constexpr (ElementSize == 2)
+  {
+    for (; ii + 16 <= count; ii += 16)
+    {
+      const v128_t low = wasm_v128_load(input + ii);
+      const v128_t high = wasm_v128_load(input + count + ii);
+      wasm_v128_store(output + ii * 2, wasm_i8x16_shuffle(low, high, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+      wasm_v128_store(output + ii * 2 + 16, wasm_i8x16_shuffle(low, high, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+    }
+  }
+#endif
+  for (; ii < count; ++ii)
+  {
+    for (size_t byte = 0; byte < ElementSize; ++byte)
+    {
+      output[ii * ElementSize + byte] = input[byte * count + ii];
+    }
+  }
+}
+
+void
+shuffleBytes(const unsigned char * input, unsigned char * output, size_t count, size_t elementSize)
+{
+  switch (elementSize)
+  {
+    case 2:
+      shuffle<2>(input, output, count);
+      break;
+    case 4:
+      shuffle<4>(input, output, count);
+      break;
+    case 8:
+      shuffle<8>(input, output, count);
+      break;
+    default:
+      for (size_t ii = 0; ii < count; ++ii)
+      {
+        for (size_t byte = 0; byte < elementSize; ++byte)
+        {
+          output[byte * count + ii] = input[ii * elementSize + byte];
+        }
+      }
+  }
+}
+
+void
+unshuffleBytes(const unsigned char * input, unsigned char * output, size_t count, size_t elementSize)
+{
+  switch (elementSize)
+  {
+    case 2:
+      unshuffle<2>(input, output, count);
+      break;
+    case 4:
+      unshuffle<4>(input, output, count);
+      break;
+    case 8:
+      unshuffle<8>(input, output, count);
+      break;
+    default:
+      for (size_t ii = 0; ii < count; ++ii)
+      {
+        for (size_t byte = 0; byte < elementSize; ++byte)
+        {
+          output[ii * elementSize + byte] = input[byte * count + ii];
+        }
+      }
+  }
+}
+
+void
+deltaEncodeBytes(const unsigned char * input, unsigned char * output, size_t count, size_t elementSize, size_t rowLength)
+{
+  switch (elementSize)
+  {
+    case 1:
+      deltaEncode<uint8_t>(input, output, count, rowLength);
+      break;
+    case 2:
+      deltaEncode<uint16_t>(input, output, count, rowLength);
+      break;
+    case 4:
+      deltaEncode<uint32_t>(input, output, count, rowLength);
+      break;
+    case 8:
+      deltaEncode<uint64_t>(input, output, count, rowLength);
+      break;
+    default:
+      throw std::invalid_argument("The delta prefilter requires elements of 1, 2, 4, or 8 bytes");
+  }
+}
+
+void
+deltaDecodeBytes(unsigned char * data, size_t count, size_t elementSize, size_t rowLength)
+{
+  switch (elementSize)
+  {
+    case 1:
+      deltaDecode<uint8_t>(data, count, rowLength);
+      break;
+    case 2:
+      deltaDecode<uint16_t>(data, count, rowLength);
+      break;
+    case 4:
+      deltaDecode<uint32_t>(data, count, rowLength);
+      break;
+    case 8:
+      deltaDecode<uint64_t>(data, count, rowLength);
+      break;
+    default:
+      throw std::invalid_argument("The delta prefilter requires elements of 1, 2, 4, or 8 bytes");
+  }
+}
+
+void
+writeUInt32LE(unsigned char * bytes, uint32_t value)
+{
+  bytes[0] = static_cast<unsigned char>(value & 0xff);
+  bytes[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+  bytes[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+  bytes[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+}
+
+uint32_t
+readUInt32LE(const unsigned char * bytes)
+{
+  return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+} // end anonymous namespace
+
+WasmPrefilterEnum
+wasmPrefilterFromString(const std::string & prefilter)
+{
+  if (prefilter == "none")
+  {
+    return WasmPrefilterEnum::None;
+  }
+  if (prefilter == "shuffle")
+  {
+    return WasmPrefilterEnum::Shuffle;
+  }
+  if (prefilter == "delta")
+  {
+    return WasmPrefilterEnum::Delta;
+  }
+  if (prefilter == "delta-shuffle")
+  {
+    return WasmPrefilterEnum::DeltaShuffle;
+  }
+  throw std::invalid_argument("Unknown prefilter: " + prefilter);
+}
+
+std::string
+wasmPrefilterToString(WasmPrefilterEnum prefilter)
+{
+  switch (prefilter)
+  {
+    case WasmPrefilterEnum::Shuffle:
+      return "shuffle";
+    case WasmPrefilterEnum::Delta:
+      return "delta";
+    case WasmPrefilterEnum::DeltaShuffle:
+      return "delta-shuffle";
+    default:
+      return "none";
+  }
+}
+
+std::ostream &
+operator<<(std::ostream & out, WasmPrefilterEnum prefilter)
+{
+  return out << wasmPrefilterToString(prefilter);
+}
+
+void
+applyWasmPrefilter(const WasmPrefilterParameters & parameters, const void * input, void * output, size_t length)
+{
+  const auto * source = static_cast<const unsigned char *>(input);
+  auto * destination = static_cast<unsigned char *>(output);
+  const size_t elementSize = std::max<size_t>(parameters.elementSize, 1);
+  const size_t count = length / elementSize;
+  if (count == 0)
+  {
+    // Too short for an element, copied like trailing bytes
+    std::copy(source, source + length, destination);
+    return;
+  }
+  const size_t tail = count * elementSize;
+  const bool delta = (static_cast<uint8_t>(parameters.prefilter) & static_cast<uint8_t>(WasmPrefilterEnum::Delta)) != 0;
+  const bool shuffled = (static_cast<uint8_t>(parameters.prefilter) & static_cast<uint8_t>(WasmPrefilterEnum::Shuffle)) != 0;
+
+  if (delta && shuffled)
+  {
+    std::vector<unsigned char> differences(tail);
+    deltaEncodeBytes(source, differences.data(), count, elementSize, std::max<size_t>(parameters.rowLength, 1));
+    shuffleBytes(differences.data(), destination, count, elementSize);
+  }
+  else if (delta)
+  {
+    deltaEncodeBytes(source, destination, count, elementSize, std::max<size_t>(parameters.rowLength, 1));
+  }
+  else if (shuffled)
+  {
+    shuffleBytes(source, destination, count, elementSize);
+  }
+  else
+  {
+    std::memcpy(destination, source, tail);
+  }
+  std::memcpy(destination + tail, source + tail, length - tail);
+}
+
+void
+undoWasmPrefilter(const WasmPrefilterParameters & parameters, void * data, size_t length)
+{
+  auto * bytes = static_cast<unsigned char *>(data);
+  const size_t elementSize = std::max<size_t>(parameters.elementSize, 1);
+  const size_t count = length / elementSize;
+  if (count == 0)
+  {
+    return;
+  }
+  if ((static_cast<uint8_t>(parameters.prefilter) & static_cast<uint8_t>(WasmPrefilterEnum::Shuffle)) != 0 && elementSize > 1)
+  {
+    const std::vector<unsigned char> shuffled(bytes, bytes + count * elementSize);
+    unshuffleBytes(shuffled.data(), bytes, count, elementSize);
+  }
+  if ((static_cast<uint8_t>(parameters.prefilter) & static_cast<uint8_t>(WasmPrefilterEnum::Delta)) != 0)
+  {
+    deltaDecodeBytes(bytes, count, elementSize, std::max<size_t>(parameters.rowLength, 1));
+  }
+}
+
+void
+writeWasmPrefilterFrame(const WasmPrefilterParameters & parameters, unsigned char * frame)
+{
+  writeUInt32LE(frame, PrefilterFrameMagicNumber);
+  writeUInt32LE(frame + 4, WasmPrefilterFrameSize - 8);
+  std::memcpy(frame + 8, PrefilterFrameSignature, 4);
+  frame[12] = static_cast<unsigned char>(parameters.prefilter);
+  frame[13] = parameters.elementSize;
+  frame[14] = 0;
+  frame[15] = 0;
+  writeUInt32LE(frame + 16, parameters.rowLength);
+}
+
+bool
+readWasmPrefilterFrame(const unsigned char * data, size_t length, WasmPrefilterParameters & parameters)
+{
+  if (length < WasmPrefilterFrameSize || readUInt32LE(data) != PrefilterFrameMagicNumber ||
+      readUInt32LE(data + 4) != WasmPrefilterFrameSize - 8 || std::memcmp(data + 8, PrefilterFrameSignature, 4) != 0)
+  {
+    return false;
+  }
+  if (data[12] > static_cast<unsigned char>(WasmPrefilterEnum::DeltaShuffle))
+  {
+    throw std::runtime_error("Unknown prefilter in the prefilter frame");
+  }
+  const auto prefilter = static_cast<WasmPrefilterEnum>(data[12]);
+  const uint8_t elementSize = data[13];
+  const bool delta = (data[12] & static_cast<uint8_t>(WasmPrefilterEnum::Delta)) != 0;
+  if (delta && elementSize != 1 && elementSize != 2 && elementSize != 4 && elementSize != 8)
+  {
+    throw std::runtime_error("Invalid element size " + std::to_string(elementSize) +
+                             " for the delta prefilter in the prefilter frame");
+  }
+  parameters.prefilter = prefilter;
+  parameters.elementSize = elementSize;
+  parameters.rowLength = readUInt32LE(data + 16);
+  return true;
+}
+
+} // end namespace itk
@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmProfiler.h"
+#include "itkPipeline.h"
+
+#include "glaze/glaze.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// Chrome trace event format, with complete ("X") events
+struct TraceEventArgsJSON
+{
+  double cpu_us{ 0.0 };
+  size_t bytes{ 0 };
+  size_t allocations{ 0 };
+  size_t allocated_bytes{ 0 };
+};
+
+struct TraceEventJSON
+{
+  std::string name;
+  std::string cat;
+  std::string ph{ "X" };
+  int pid{ 1 };
+  size_t tid{ 1 };
+  double ts{ 0.0 };
+  double dur{ 0.0 };
+  TraceEventArgsJSON args;
+};
+
+struct TraceJSON
+{
+  std::string displayTimeUnit{ "ms" };
+  std::vector<TraceEventJSON> traceEvents;
+};
+
+double cpuSecondsSince(std::clock_t start)
+{
+  return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+}
+
+// Trivial, so it is usable from operator new before any initialization
+thread_local Profiler::AllocationCount threadAllocationCount;
+
+Profiler::AllocationCount allocatedSince(const Profiler::AllocationCount & start)
+{
+  const Profiler::AllocationCount now = Profiler::GetAllocationCount();
+  return { now.allocations - start.allocations, now.bytes - start.bytes };
+}
+
+} // end anonymous namespace
+
+Profiler
+::Profiler(std::string fileName, TimePoint origin):
+  m_FileName(std::move(fileName)),
+  m_Origin(origin)
+{
+}
+
+void
+Profiler
+::AddEvent(std::string name, const char * category, TimePoint start, TimePoint end, double cpuSeconds, size_t bytes, AllocationCount allocated)
+{
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  Event event{ std::move(name),
+               category,
+               Microseconds(start - m_Origin).count(),
+               Microseconds(end - start).count(),
+               cpuSeconds * 1e6,
+               bytes,
+               allocated,
+               std::hash<std::thread::id>()(std::this_thread::get_id()) };
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Events.push_back(std::move(event));
+}
+
+void
+Profiler
+::CountAllocation(size_t bytes) noexcept
+{
+  ++threadAllocationCount.allocations;
+  threadAllocationCount.bytes += bytes;
+}
+
+auto
+Profiler
+::GetAllocationCount() noexcept -> AllocationCount
+{
+  return threadAllocationCount;
+}
+
+void
+Profiler
+::Observe(ProcessObject * process)
+{
+  struct Update
+  {
+    TimePoint start;
+    std::clock_t cpuStart{ 0 };
+    AllocationCount allocationStart;
+  };
+  auto update = std::make_shared<Update>();
+  std::string name = process->GetNameOfClass();
+  if (!process->GetObjectName().empty())
+  {
+    name += " " + process->GetObjectName();
+  }
+  process->AddObserver(StartEvent(), [update](const EventObject &) {
+    update->start = ClockType::now();
+    update->cpuStart = std::clock();
+    update->allocationStart = GetAllocationCount();
+  });
+  // The profiler is looked up when the process ends, which may be after the
+  // invocation
+  process->AddObserver(EndEvent(), [update, name](const EventObject &) {
+    if (Profiler * profiler = Pipeline::get_profiler())
+    {
+      profiler->AddEvent(name, "filter", update->start, ClockType::now(), cpuSecondsSince(update->cpuStart), 0, allocatedSince(update->allocationStart));
+    }
+  });
+}
+
+void
+Profiler
+::Write() const
+{
+  TraceJSON trace;
+  {
+    // Thread ids are numbered in the order they appear
+    std::vector<size_t> threads;
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    trace.traceEvents.reserve(m_Events.size());
+    for (const Event & event : m_Events)
+    {
+      size_t thread = 0;
+      while (thread < threads.size() && threads[thread] != event.thread)
+      {
+        ++thread;
+      }
+      if (thread == threads.size())
+      {
+        threads.push_back(event.thread);
+      }
+      TraceEventJSON traceEvent;
+      traceEvent.name = event.name;
+      traceEvent.cat = event.category;
+      traceEvent.tid = thread + 1;
+      traceEvent.ts = event.start;
+      traceEvent.dur = event.duration;
+      traceEvent.args = { event.cpuDuration, event.bytes, event.allocated.allocations, event.allocated.bytes };
+      trace.traceEvents.push_back(std::move(traceEvent));
+    }
+  }
+
+  std::string serialized;
+  if (glz::write_json(trace, serialized))
+  {
+    std::cerr << "Could not serialize the profile: " << m_FileName << std::endl;
+    return;
+  }
+  std::ofstream stream(m_FileName);
+  if (!stream)
+  {
+    std::cerr << "Could not write the profile: " << m_FileName << std::endl;
+    return;
+  }
+  stream << serialized << std::endl;
+}
+
+ProfileScope
+::ProfileScope(const char * name, const char * category):
+  m_Profiler(Pipeline::get_profiler()),
+  m_Name(name),
+  m_Category(category)
+{
+  if (m_Profiler != nullptr)
+  {
+    m_Start = Profiler::ClockType::now();
+    m_CPUStart = std::clock();
+    m_AllocationStart = Profiler::GetAllocationCount();
+  }
+}
+
+ProfileScope
+::~ProfileScope()
+{
+  if (m_Profiler != nullptr)
+  {
+    m_Profiler->AddEvent(m_Name, m_Category, m_Start, Profiler::ClockType::now(), cpuSecondsSince(m_CPUStart), m_Bytes, allocatedSince(m_AllocationStart));
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#ifdef ITKWASM_COUNT_ALLOCATIONS
+// Count every heap allocation made through operator new. The array and
+// nothrow forms call this one, and operator delete pairs it with free.
+void *
+operator new(std::size_t size)
+{
+  itk::wasm::Profiler::CountAllocation(size);
+  if (size == 0)
+  {
+    size = 1;
+  }
+  while (true)
+  {
+    if (void * pointer = std::malloc(size))
+    {
+      return pointer;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void
+operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void
+operator delete(void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+#endif
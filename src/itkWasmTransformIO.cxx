@@ -508,21 +508,15 @@ WasmTransformIOTemplate<TParametersValueType>::SetJSON(const TransformListJSON &
 }
 
 template <typename TParametersValueType>
-size_t
+void
 WasmTransformIOTemplate<TParametersValueType>
-::WriteCBOR(const void *buffer, unsigned char ** cborBufferPtr, bool allocateCBORBuffer )
+::WriteCBOR(std::ostream & outputStream)
 {
   auto transformListJSON = this->GetJSON();
 
-  if (this->m_CBORRoot != nullptr)
-  {
-    cbor_decref(&(this->m_CBORRoot));
-  }
-  // create a container for a javascript array
-  this->m_CBORRoot = cbor_new_definite_array(transformListJSON.size());
+  // the head of a javascript array
+  writeCBORHead(outputStream, 4, transformListJSON.size());
 
-  unsigned int  count = 0;
-  cbor_item_t * index = this->m_CBORRoot;
   // write the transformListJSON into the cbor array
   ConstTransformListType & writeTransformList = this->GetWriteTransformList();
   const std::string    compositeTransformType = writeTransformList.front()->GetTransformTypeAsString();
@@ -542,7 +536,7 @@ WasmTransformIOTemplate<TParametersValueType>
        ++transformIt, ++jsonIt)
   {
     const auto &  transformJSON = *jsonIt;
-    cbor_item_t * transformItem = cbor_new_definite_map(8);
+    cbor_item_t * transformItem = cbor_new_definite_map(6);
     cbor_item_t * transformTypeItem = cbor_new_definite_map(4);
 
     const std::string transformParameterization = transformParameterizationString(transformJSON.transformType);
@@ -595,63 +589,40 @@ WasmTransformIOTemplate<TParametersValueType>
                  cbor_pair{ cbor_move(cbor_build_string("outputSpaceName")),
                             cbor_move(cbor_build_string(transformJSON.outputSpaceName.c_str())) });
 
-    if (transformJSON.transformType.transformParameterization == JSONTransformParameterizationEnum::Composite)
+    // The small fields are followed by the parameters, which are written
+    // directly from their buffers.
+    const bool isComposite = transformJSON.transformType.transformParameterization == JSONTransformParameterizationEnum::Composite;
+    writeCBORHead(outputStream, 5, isComposite ? 6 : 8);
+    writeCBORMapEntries(outputStream, transformItem);
+    cbor_decref(&transformItem);
+    if (isComposite)
     {
-      cbor_array_push(index, cbor_move(transformItem));
-      ++count;
       continue;
     }
+
     const auto fixedNumberOfBytes = transformJSON.numberOfFixedParameters * sizeof(FixedParametersValueType);
     const auto fixedParams = (*transformIt)->GetFixedParameters();
-    writeCBORBuffer(transformItem,
-                    "fixedParameters",
-                    reinterpret_cast<const void *>(fixedParams.data_block()),
-                    fixedNumberOfBytes,
-                    IOComponentEnum::DOUBLE);
+    writeCBORTypedArray(outputStream,
+                        "fixedParameters",
+                        reinterpret_cast<const void *>(fixedParams.data_block()),
+                        fixedNumberOfBytes,
+                        IOComponentEnum::DOUBLE);
     const auto numberOfBytes = transformJSON.numberOfParameters * sizeof(ParametersValueType);
     const auto params = (*transformIt)->GetParameters();
-    if (transformJSON.transformType.parametersValueType == JSONFloatTypesEnum::float32)
-    {
-      writeCBORBuffer(transformItem,
-                      "parameters",
-                      reinterpret_cast<const void *>(params.data_block()),
-                      numberOfBytes,
-                      IOComponentEnum::FLOAT);
-    }
-    else if (transformJSON.transformType.parametersValueType == JSONFloatTypesEnum::float64)
-    {
-      writeCBORBuffer(transformItem,
-                      "parameters",
-                      reinterpret_cast<const void *>(params.data_block()),
-                      numberOfBytes,
-                      IOComponentEnum::DOUBLE);
-    }
-
-    cbor_array_push(index, cbor_move(transformItem));
-
-    ++count;
+    const IOComponentEnum parametersComponent =
+      transformJSON.transformType.parametersValueType == JSONFloatTypesEnum::float32 ? IOComponentEnum::FLOAT
+                                                                                     : IOComponentEnum::DOUBLE;
+    writeCBORTypedArray(outputStream,
+                        "parameters",
+                        reinterpret_cast<const void *>(params.data_block()),
+                        numberOfBytes,
+                        parametersComponent);
   }
 
-  size_t cborBufferSize;
-  size_t length;
-  unsigned char * cborBuffer;
-
-  if (allocateCBORBuffer)
-  {
-    length = cbor_serialize_alloc(index, cborBufferPtr, &cborBufferSize);
-  }
-  else
+  if (!outputStream)
   {
-    length = cbor_serialize_alloc(index, &cborBuffer, &cborBufferSize);
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
+    itkExceptionMacro(<< "Failed to write the CBOR encoding to " << this->GetFileName());
   }
-
-  cbor_decref(&(this->m_CBORRoot));
-
-  return length;
 }
 
 template <typename TParametersValueType>
@@ -954,7 +925,9 @@ WasmTransformIOTemplate<TParametersValueType>::Write()
 {
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    this->WriteCBOR();
+    std::ofstream outputStream;
+    openFileForWriting(outputStream, this->GetFileName(), true, false);
+    this->WriteCBOR(outputStream);
     return;
   }
 
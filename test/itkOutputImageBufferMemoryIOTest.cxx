@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkImageToWasmImageFilter.h"
+#include "itkShrinkImageFilter.h"
+#include "itkWasmExports.h"
+
+#include <cstring>
+
+int
+itkOutputImageBufferMemoryIOTest(int, char * argv[])
+{
+  constexpr unsigned int Dimension = 2;
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ShrinkFilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(32);
+  image->SetRegions(size);
+  image->Allocate();
+  for (itk::SizeValueType ii = 0; ii < image->GetPixelContainer()->Size(); ++ii)
+  {
+    image->GetBufferPointer()[ii] = static_cast<PixelType>(ii);
+  }
+
+  auto expectedFilter = ShrinkFilterType::New();
+  expectedFilter->SetInput(image);
+  expectedFilter->SetShrinkFactors(2);
+  expectedFilter->Update();
+  const ImageType * expected = expectedFilter->GetOutput();
+
+  // The host writes the input image into the memory store
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+  imageToWasmImageFilter->SetInput(image);
+  imageToWasmImageFilter->Update();
+  auto wasmImage = imageToWasmImageFilter->GetOutput();
+
+  const auto imageDataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(PixelType);
+  void * imageDataPointer = reinterpret_cast< void * >(itk_wasm_input_array_alloc(0, 0, 0, imageDataSize));
+  std::memcpy(imageDataPointer, wasmImage->GetImage()->GetBufferPointer(), imageDataSize);
+
+  const auto imageJSON = wasmImage->GetJSON();
+  void * imageJSONPointer = reinterpret_cast< void * >(itk_wasm_input_json_alloc(0, 0, imageJSON.size()));
+  std::memcpy(imageJSONPointer, imageJSON.data(), imageJSON.size());
+
+  // and pre-allocates the output pixel buffer
+  const size_t outputBufferSize = expected->GetPixelContainer()->Size() * sizeof(PixelType);
+  const size_t outputBufferAddress = itk_wasm_output_array_alloc(0, 0, 0, outputBufferSize);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryStoreOutputArrayBuffer(0, 0, 0).first, outputBufferAddress);
+
+  {
+    const char * mockArgv[] = { argv[0], "--memory-io", "0", "0", nullptr };
+    itk::wasm::Pipeline pipeline("output-image-buffer-memory-io-test", "Test writing an output image into a host buffer", 4, const_cast< char ** >(mockArgv));
+
+    itk::wasm::InputImage<ImageType> inputImage;
+    pipeline.add_option("input-image", inputImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+    itk::wasm::OutputImage<ImageType> outputImage;
+    pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    auto filter = ShrinkFilterType::New();
+    filter->SetInput(inputImage.Get());
+    filter->SetShrinkFactors(2);
+    outputImage.UseOutputBuffer(filter);
+    filter->Update();
+    ITK_TEST_EXPECT_EQUAL(reinterpret_cast< size_t >(filter->GetOutput()->GetBufferPointer()), outputBufferAddress);
+
+    outputImage.Set(filter->GetOutput());
+  }
+
+  // The published output array is the host buffer, so there is nothing to copy
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_address(0, 0, 0), outputBufferAddress);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(0, 0, 0), outputBufferSize);
+  ITK_TEST_EXPECT_TRUE(std::memcmp(reinterpret_cast< const void * >(outputBufferAddress), expected->GetBufferPointer(), outputBufferSize) == 0);
+
+  // Releasing the output clears its slots and returns its buffer to the arena
+  const size_t highWaterMark = itk_wasm_memory_high_water_mark();
+  itk_wasm_output_release(0, 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_address(0, 0, 0), 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_size(0, 0, 0), 0);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryStoreOutputArrayBuffer(0, 0, 0).first, 0);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_alloc(0, 0, 0, outputBufferSize), outputBufferAddress);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_memory_high_water_mark(), highWaterMark);
+
+  itk_wasm_free_all();
+
+  return EXIT_SUCCESS;
+}
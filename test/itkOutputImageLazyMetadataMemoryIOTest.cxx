@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkImageToWasmImageFilter.h"
+#include "itkMetaDataObject.h"
+#include "itkWasmExports.h"
+
+#include <cstring>
+
+int
+itkOutputImageLazyMetadataMemoryIOTest(int, char * argv[])
+{
+  constexpr unsigned int Dimension = 2;
+  using PixelType = uint8_t;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(8);
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(7);
+  const std::string metadataValue = "lazy-metadata-test-value";
+  itk::EncapsulateMetaData<std::string>(image->GetMetaDataDictionary(), "lazy-metadata-test-key", metadataValue);
+
+  // The host writes the input image into the memory store
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+  imageToWasmImageFilter->SetInput(image);
+  imageToWasmImageFilter->Update();
+  auto wasmImage = imageToWasmImageFilter->GetOutput();
+
+  const auto imageDataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(PixelType);
+  void * imageDataPointer = reinterpret_cast< void * >(itk_wasm_input_array_alloc(0, 0, 0, imageDataSize));
+  std::memcpy(imageDataPointer, wasmImage->GetImage()->GetBufferPointer(), imageDataSize);
+
+  const auto imageJSON = wasmImage->GetJSON();
+  ITK_TEST_EXPECT_TRUE(imageJSON.find(metadataValue) != std::string::npos);
+  void * imageJSONPointer = reinterpret_cast< void * >(itk_wasm_input_json_alloc(0, 0, imageJSON.size()));
+  std::memcpy(imageJSONPointer, imageJSON.data(), imageJSON.size());
+
+  {
+    const char * mockArgv[] = { argv[0], "--memory-io", "--lazy-metadata", "0", "0", nullptr };
+    itk::wasm::Pipeline pipeline("output-image-lazy-metadata-memory-io-test", "Test serializing output metadata on request", 5, const_cast< char ** >(mockArgv));
+
+    itk::wasm::InputImage<ImageType> inputImage;
+    pipeline.add_option("input-image", inputImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+    itk::wasm::OutputImage<ImageType> outputImage;
+    pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+
+    ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_use_lazy_metadata());
+    outputImage.Set(inputImage.Get());
+  }
+
+  // The output descriptor is written without the metadata
+  const std::string outputJSON(reinterpret_cast< const char * >(itk_wasm_output_json_address(0, 0)), itk_wasm_output_json_size(0, 0));
+  ITK_TEST_EXPECT_TRUE(outputJSON.find(metadataValue) == std::string::npos);
+
+  // which is serialized when the host requests it
+  const size_t metadataAddress = itk_wasm_output_metadata_address(0, 0);
+  const std::string metadataJSON(reinterpret_cast< const char * >(metadataAddress), itk_wasm_output_metadata_size(0, 0));
+  std::cout << "metadata: " << metadataJSON << std::endl;
+  ITK_TEST_EXPECT_TRUE(metadataJSON.find("lazy-metadata-test-key") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(metadataJSON.find(metadataValue) != std::string::npos);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_metadata_address(0, 0), metadataAddress);
+
+  itk_wasm_free_all();
+
+  return EXIT_SUCCESS;
+}
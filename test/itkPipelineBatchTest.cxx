@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+std::vector<int> invocationValues;
+
+int
+batchTestPipelineMain(int argc, char * argv[])
+{
+  itk::wasm::Pipeline pipeline("batch-test", "A test ITK Wasm batch Pipeline", argc, argv);
+
+  int value = 0;
+  pipeline.add_option("value", value, "A value")->required();
+
+  ITK_WASM_PARSE(pipeline);
+
+  invocationValues.push_back(value);
+
+  return value >= 42 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkPipelineBatchTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " batchFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string batchFileName = argv[1];
+
+  {
+    std::ofstream batchFile(batchFileName);
+    batchFile << "[\"3\"]\n";
+    batchFile << "\n";
+    batchFile << "[\"--help\"]\n";
+    batchFile << "[\"5\"]\n";
+    batchFile << "[\"5\", \"6\"\n";
+    batchFile << "[\"42\"]\n";
+  }
+
+  char * batchArgv[] = { argv[0], const_cast<char *>("--batch"), argv[1], nullptr };
+  // The malformed line and the failed invocation fail the batch, but not the
+  // other invocations
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::Pipeline::run(3, batchArgv, batchTestPipelineMain), EXIT_FAILURE);
+  ITK_TEST_EXPECT_EQUAL(invocationValues.size(), 3);
+  ITK_TEST_EXPECT_EQUAL(invocationValues[0], 3);
+  ITK_TEST_EXPECT_EQUAL(invocationValues[1], 5);
+  ITK_TEST_EXPECT_EQUAL(invocationValues[2], 42);
+  ITK_TEST_EXPECT_TRUE(!itk::wasm::Pipeline::get_in_batch());
+
+  {
+    std::ofstream batchFile(batchFileName);
+    batchFile << "[\"7\"]\n";
+  }
+  invocationValues.clear();
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::Pipeline::run(3, batchArgv, batchTestPipelineMain), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(invocationValues.size(), 1);
+
+  // Without --batch, the pipeline runs once with the arguments
+  invocationValues.clear();
+  char * singleArgv[] = { argv[0], const_cast<char *>("11"), nullptr };
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::Pipeline::run(2, singleArgv, batchTestPipelineMain), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_EQUAL(invocationValues.size(), 1);
+  ITK_TEST_EXPECT_EQUAL(invocationValues[0], 11);
+
+  return EXIT_SUCCESS;
+}
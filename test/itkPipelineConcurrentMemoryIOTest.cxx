@@ -0,0 +1,184 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkShrinkImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkWasmExports.h"
+
+#include <cstring>
+
+#if !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+
+// Holds both invocations at the same step, so their memory stores are live
+// at the same time
+class Barrier
+{
+public:
+  void
+  ArriveAndWait()
+  {
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    if (++m_Arrived == 2)
+    {
+      m_Condition.notify_all();
+    }
+    m_Condition.wait(lock, [this] { return m_Arrived == 2; });
+  }
+
+private:
+  std::mutex              m_Mutex;
+  std::condition_variable m_Condition;
+  unsigned int            m_Arrived{ 0 };
+};
+
+bool
+outputMatches(const ImageType * outputImage, itk::SizeValueType outputSize, PixelType value)
+{
+  const auto region = outputImage->GetLargestPossibleRegion();
+  if (region.GetSize(0) != outputSize || region.GetSize(1) != outputSize)
+  {
+    return false;
+  }
+  for (itk::ImageRegionConstIterator<ImageType> it(outputImage, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != value)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+runInvocation(const char * executable, itk::SizeValueType imageSize, PixelType value, Barrier & inputsWritten, Barrier & outputsWritten, bool & succeeded)
+{
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(imageSize);
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(value);
+
+  // Write the input into the memory store of this thread
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+  imageToWasmImageFilter->SetInput(image);
+  imageToWasmImageFilter->Update();
+  auto wasmImage = imageToWasmImageFilter->GetOutput();
+
+  const auto imageDataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(PixelType);
+  void * imageDataPointer = reinterpret_cast< void * >(itk_wasm_input_array_alloc(0, 0, 0, imageDataSize));
+  std::memcpy(imageDataPointer, wasmImage->GetImage()->GetBufferPointer(), imageDataSize);
+
+  const auto imageJSON = wasmImage->GetJSON();
+  void * imageJSONPointer = reinterpret_cast< void * >(itk_wasm_input_json_alloc(0, 0, imageJSON.size()));
+  std::memcpy(imageJSONPointer, imageJSON.data(), imageJSON.size());
+
+  inputsWritten.ArriveAndWait();
+
+  {
+    const char * mockArgv[] = { executable, "--memory-io", "0", "0", nullptr };
+    itk::wasm::Pipeline pipeline("pipeline-concurrent-memory-io-test", "Test two invocations with memory IO on two threads", 4, const_cast< char ** >(mockArgv));
+
+    itk::wasm::InputImage<ImageType> inputImage;
+    pipeline.add_option("input-image", inputImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+    itk::wasm::OutputImage<ImageType> outputImage;
+    pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+    int exitCode = EXIT_FAILURE;
+    try
+    {
+      pipeline.parse();
+
+      using ShrinkFilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+      auto filter = ShrinkFilterType::New();
+      filter->SetInput(inputImage.Get());
+      filter->SetShrinkFactors(2);
+      filter->Update();
+
+      outputImage.Set(filter->GetOutput());
+      exitCode = EXIT_SUCCESS;
+    }
+    catch (const CLI::ParseError & e)
+    {
+      exitCode = pipeline.exit(e);
+    }
+    succeeded = exitCode == EXIT_SUCCESS;
+  }
+
+  // Read the outputs back while the other invocation still holds its own
+  outputsWritten.ArriveAndWait();
+
+  if (succeeded)
+  {
+    const char * outputJSON = reinterpret_cast< const char * >(itk_wasm_output_json_address(0, 0));
+    auto outputWasmImage = itk::WasmImage<ImageType>::New();
+    outputWasmImage->SetJSON(std::string(outputJSON, itk_wasm_output_json_size(0, 0)));
+
+    using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+    auto wasmImageToImageFilter = WasmImageToImageFilterType::New();
+    wasmImageToImageFilter->SetInput(outputWasmImage);
+    wasmImageToImageFilter->Update();
+    // The output image imports the pixel buffer of the memory store
+    succeeded = outputMatches(wasmImageToImageFilter->GetOutput(), imageSize / 2, value);
+  }
+
+  itk_wasm_free_all();
+}
+
+} // namespace
+#endif
+
+int
+itkPipelineConcurrentMemoryIOTest(int, char * argv[])
+{
+#if !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+  // Each thread has its own memory store and invocation state
+  Barrier inputsWritten;
+  Barrier outputsWritten;
+  bool firstSucceeded = false;
+  bool secondSucceeded = false;
+  std::thread firstThread(runInvocation, argv[0], 16, 1.0f, std::ref(inputsWritten), std::ref(outputsWritten), std::ref(firstSucceeded));
+  std::thread secondThread(runInvocation, argv[0], 32, 2.0f, std::ref(inputsWritten), std::ref(outputsWritten), std::ref(secondSucceeded));
+  firstThread.join();
+  secondThread.join();
+
+  ITK_TEST_EXPECT_TRUE(firstSucceeded);
+  ITK_TEST_EXPECT_TRUE(secondSucceeded);
+#else
+  (void)argv;
+#endif
+
+  return EXIT_SUCCESS;
+}
@@ -232,9 +232,31 @@ itkPipelineMemoryIOTest(int argc, char * argv[])
   auto readWasmVectorImageDataPointer = reinterpret_cast< void * >(readWasmVectorImageDataPointerAddress);
   std::memcpy(readWasmVectorImageDataPointer, readWasmVectorImageData, readWasmVectorImageDataSize);
 
+  const auto storedVectorImageData = itk::wasm::getMemoryStoreInputArray(0, 8, 0);
+  ITK_TEST_EXPECT_EQUAL(storedVectorImageData.first, readWasmVectorImageDataPointerAddress);
+  ITK_TEST_EXPECT_EQUAL(storedVectorImageData.second, readWasmVectorImageDataSize);
+  ITK_TEST_EXPECT_TRUE(itk_wasm_memory_high_water_mark() >= readWasmImageDataSize + readWasmVectorImageDataSize);
+
+  // Allocating the same slot again releases the previous allocation
+  const size_t reallocatedSize = 1024 * 1024;
+  const size_t highWaterMarkBeforeRealloc = itk_wasm_memory_high_water_mark();
+  itk_wasm_input_array_alloc(0, 9, 0, reallocatedSize);
+  itk_wasm_input_array_alloc(0, 9, 0, reallocatedSize);
+  ITK_TEST_EXPECT_TRUE(itk_wasm_memory_high_water_mark() - highWaterMarkBeforeRealloc <= reallocatedSize);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryStoreInputArray(0, 9, 0).second, reallocatedSize);
+
+  // Releasing an input that is not at the top of the arena makes its memory available
+  const size_t releasedAddress = itk::wasm::getMemoryStoreInputArray(0, 9, 0).first;
+  itk_wasm_input_array_alloc(0, 10, 0, reallocatedSize);
+  itk_wasm_input_release(0, 9);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_alloc(0, 11, 0, reallocatedSize), releasedAddress);
+  itk_wasm_input_release(0, 10);
+  itk_wasm_input_release(0, 11);
+
   auto readVectorImageJSON = readWasmVectorImage->GetJSON();
   void * readWasmVectorImagePointer = reinterpret_cast< void * >( itk_wasm_input_json_alloc(0, 8, readVectorImageJSON.size()));
   std::memcpy(readWasmVectorImagePointer, readVectorImageJSON.data(), readVectorImageJSON.size());
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryStoreInputJSON(0, 8), readVectorImageJSON);
 
   const char * mockArgv[] = {"itkPipelineMemoryIOTest", "--memory-io", "0", "0", "1", "1", "2", "2", "3", "3", "4", "4", "5", "5", "6", "6", "7", "7", "8", "8", NULL};
   itk::wasm::Pipeline pipeline("pipeline-test", "A test ITK Wasm Pipeline", 20, const_cast< char ** >(mockArgv));
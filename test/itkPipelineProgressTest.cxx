@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkWasmExports.h"
+#include "itkShrinkImageFilter.h"
+
+namespace
+{
+// Iterates like an itk::GradientDescentOptimizerv4 without a metric
+class IteratingOptimizer : public itk::Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(IteratingOptimizer);
+
+  using Self = IteratingOptimizer;
+  using Superclass = itk::Object;
+  using Pointer = itk::SmartPointer<Self>;
+  itkNewMacro(Self);
+
+  itk::SizeValueType
+  GetNumberOfIterations() const
+  {
+    return 4;
+  }
+
+  itk::SizeValueType
+  GetCurrentIteration() const
+  {
+    return m_CurrentIteration;
+  }
+
+  void
+  StopOptimization()
+  {
+    m_Stopped = true;
+  }
+
+  bool
+  GetStopped() const
+  {
+    return m_Stopped;
+  }
+
+  void
+  Iterate()
+  {
+    this->InvokeEvent(itk::IterationEvent());
+    ++m_CurrentIteration;
+  }
+
+protected:
+  IteratingOptimizer() = default;
+
+private:
+  itk::SizeValueType m_CurrentIteration{ 0 };
+  bool               m_Stopped{ false };
+};
+} // namespace
+
+int
+itkPipelineProgressTest(int, char * argv[])
+{
+  itk::wasm::WasmPipelineStatus & status = itk::wasm::getPipelineStatus();
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_progress_address(), reinterpret_cast<size_t>(&status));
+
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+  {
+    char * progressArgv[] = { argv[0], nullptr };
+    itk::wasm::Pipeline pipeline("progress-test", "A test ITK Wasm Pipeline", 1, progressArgv);
+
+    // The invocation keeps the block it started with
+    ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_status() == &status);
+
+    auto filter = FilterType::New();
+    pipeline.observe_process(filter);
+
+    filter->UpdateProgress(0.25f);
+    ITK_TEST_EXPECT_EQUAL(status.progress.load(), 0.25f);
+    ITK_TEST_EXPECT_TRUE(!filter->GetAbortGenerateData());
+
+    // The host requests an abort, which is passed on at the next progress event
+    status.abort.store(1);
+    filter->UpdateProgress(0.5f);
+    ITK_TEST_EXPECT_EQUAL(status.progress.load(), 0.5f);
+    ITK_TEST_EXPECT_TRUE(filter->GetAbortGenerateData());
+  }
+
+  // The abort request ends with the invocation
+  ITK_TEST_EXPECT_EQUAL(status.abort.load(), 0u);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_status() == nullptr);
+
+  // Optimizer iterations are reported as the progress of the process that
+  // runs the optimizer, e.g. a registration method
+  {
+    char * progressArgv[] = { argv[0], nullptr };
+    itk::wasm::Pipeline pipeline("progress-test", "A test ITK Wasm Pipeline", 1, progressArgv);
+
+    auto filter = FilterType::New();
+    auto optimizer = IteratingOptimizer::New();
+    pipeline.observe_process(filter);
+    pipeline.observe_optimizer(filter, optimizer.GetPointer());
+
+    optimizer->Iterate();
+    ITK_TEST_EXPECT_EQUAL(status.progress.load(), 0.25f);
+    ITK_TEST_EXPECT_TRUE(!optimizer->GetStopped());
+
+    status.abort.store(1);
+    optimizer->Iterate();
+    ITK_TEST_EXPECT_EQUAL(status.progress.load(), 0.5f);
+    ITK_TEST_EXPECT_TRUE(optimizer->GetStopped());
+  }
+
+  return EXIT_SUCCESS;
+}
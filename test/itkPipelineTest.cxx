@@ -40,6 +40,10 @@
 #include "itkOutputPointSet.h"
 #include "itkPointSet.h"
 
+#if !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+#include <thread>
+#endif
+
 int
 itkPipelineTest(int argc, char * argv[])
 {
@@ -135,6 +139,23 @@ itkPipelineTest(int argc, char * argv[])
 
   ITK_WASM_PARSE(pipeline);
 
+  // Inputs are materialized once per invocation, also when parsed again
+  const ImageType * parsedImage = inputImage.Get();
+  const MeshType * parsedMesh = inputMesh.Get();
+  pipeline.parse();
+  ITK_TEST_EXPECT_TRUE(inputImage.Get() == parsedImage);
+  ITK_TEST_EXPECT_TRUE(inputMesh.Get() == parsedMesh);
+
+  // The invocation state is kept per thread
+  ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_current() == &pipeline);
+#if !defined(__wasi__) && !defined(__EMSCRIPTEN__)
+  bool otherThreadHasPipeline = true;
+  std::thread([&otherThreadHasPipeline]() {
+    otherThreadHasPipeline = itk::wasm::Pipeline::get_current() != nullptr;
+  }).join();
+  ITK_TEST_EXPECT_TRUE(!otherThreadHasPipeline);
+#endif
+
   outputImage.Set(inputImage.Get());
 
   const std::string inputTextStreamContent{ std::istreambuf_iterator<char>(inputTextStream.Get()),
@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmBase64.h"
+#include "itkTestingMacros.h"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int
+itkWasmBase64Test(int, char *[])
+{
+  const std::string text("Many hands make light work.");
+  std::vector<char> encoded(itk::base64EncodedLength(text.size()));
+  const size_t encodedLength = itk::base64Encode(text.data(), text.size(), encoded.data());
+  ITK_TEST_EXPECT_EQUAL(std::string(encoded.data(), encodedLength), "TWFueSBoYW5kcyBtYWtlIGxpZ2h0IHdvcmsu");
+
+  // Lengths around the vector block sizes, with and without padding
+  for (size_t length = 0; length < 200; ++length)
+  {
+    std::vector<unsigned char> input(length);
+    for (size_t ii = 0; ii < length; ++ii)
+    {
+      input[ii] = static_cast<unsigned char>(ii * 151 + length);
+    }
+    std::vector<char> base64(itk::base64EncodedLength(length));
+    ITK_TEST_EXPECT_EQUAL(itk::base64Encode(input.data(), length, base64.data()), base64.size());
+    std::vector<unsigned char> decoded(base64.size() / 4 * 3);
+    const size_t decodedLength = itk::base64Decode(base64.data(), base64.size(), decoded.data());
+    decoded.resize(decodedLength);
+    if (decoded != input)
+    {
+      std::cerr << "Length " << length << " did not round trip" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // An invalid character in a vector block
+  std::string invalid(64, 'A');
+  invalid[20] = '*';
+  std::vector<unsigned char> decoded(invalid.size() / 4 * 3);
+  bool caught = false;
+  try
+  {
+    itk::base64Decode(invalid.data(), invalid.size(), decoded.data());
+  }
+  catch (const std::invalid_argument &)
+  {
+    caught = true;
+  }
+  ITK_TEST_EXPECT_TRUE(caught);
+
+  // The stream buffers, with writes that split groups and wrapped lines
+  std::string binary(100000, '\0');
+  for (size_t ii = 0; ii < binary.size(); ++ii)
+  {
+    binary[ii] = static_cast<char>(ii * 7 / 3);
+  }
+  std::ostringstream base64Text;
+  itk::Base64OutputStreamBuffer outputBuffer(base64Text);
+  std::ostream outputStream(&outputBuffer);
+  outputStream.write(binary.data(), 1);
+  outputStream.write(binary.data() + 1, 50000);
+  outputStream.write(binary.data() + 50001, binary.size() - 50001);
+  outputBuffer.Finish();
+  ITK_TEST_EXPECT_EQUAL(base64Text.str().size(), itk::base64EncodedLength(binary.size()));
+
+  std::string wrapped;
+  const std::string unwrapped = base64Text.str();
+  for (size_t ii = 0; ii < unwrapped.size(); ii += 76)
+  {
+    wrapped += unwrapped.substr(ii, 76) + "\r\n";
+  }
+  std::istringstream wrappedText(wrapped);
+  itk::Base64InputStreamBuffer inputBuffer(wrappedText);
+  std::istream inputStream(&inputBuffer);
+  const std::string roundTrip((std::istreambuf_iterator<char>(inputStream)), std::istreambuf_iterator<char>());
+  ITK_TEST_EXPECT_TRUE(roundTrip == binary);
+
+  return EXIT_SUCCESS;
+}
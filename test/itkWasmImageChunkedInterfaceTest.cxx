@@ -0,0 +1,136 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkWasmDescriptor.h"
+#include "itkWasmExports.h"
+#include "itkPipeline.h"
+#include "itkInputImage.h"
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkRegionOfInterestImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <cstring>
+
+int
+itkWasmImageChunkedInterfaceTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputImage OutputImage" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFile = argv[1];
+  const char * outputImageFile = argv[2];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = unsigned char;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ImagePointer = ImageType::Pointer;
+
+  ImagePointer inputImage = nullptr;
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImage = itk::ReadImage<ImageType>(inputImageFile));
+
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToJSON = ImageToWasmImageFilterType::New();
+  imageToJSON->SetInput(inputImage);
+  imageToJSON->Update();
+
+  // Split the pixel buffer into two separately allocated chunks along the slowest axis
+  auto imageJSON = itk::readDescriptor<itk::ImageJSON>(imageToJSON->GetOutput()->GetJSON()).value();
+  const auto size = inputImage->GetLargestPossibleRegion().GetSize();
+  const itk::SizeValueType sliceElements = size[0] * size[1];
+  const itk::SizeValueType firstSlices = size[2] / 2;
+  const PixelType * buffer = inputImage->GetBufferPointer();
+  const std::vector<PixelType> firstChunk(buffer, buffer + firstSlices * sliceElements);
+  const std::vector<PixelType> secondChunk(buffer + firstSlices * sliceElements,
+                                           buffer + size[2] * sliceElements);
+
+  std::vector<itk::ImageChunkJSON> chunks(2);
+  chunks[0].index = 0;
+  chunks[0].size = firstSlices;
+  chunks[0].data = itk::descriptorArray(firstChunk.data());
+  chunks[1].index = firstSlices;
+  chunks[1].size = size[2] - firstSlices;
+  chunks[1].data = itk::descriptorArray(secondChunk.data());
+  imageJSON.chunks = chunks;
+  imageJSON.data = uint64_t{ 0 };
+
+  using WasmImageType = itk::WasmImage<ImageType>;
+  auto wasmImage = WasmImageType::New();
+  std::string chunkedJSON;
+  itk::writeDescriptor(imageJSON, chunkedJSON);
+  wasmImage->SetJSON(chunkedJSON);
+
+  // A region within the first chunk is imported without a copy
+  using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+  auto slabToImage = WasmImageToImageFilterType::New();
+  slabToImage->SetInput(wasmImage);
+  slabToImage->UpdateOutputInformation();
+  ImageType::RegionType slabRegion = slabToImage->GetOutput()->GetLargestPossibleRegion();
+  slabRegion.SetSize(2, 1);
+  slabToImage->GetOutput()->SetRequestedRegion(slabRegion);
+  slabToImage->Update();
+  ITK_TEST_EXPECT_EQUAL(slabToImage->GetOutput()->GetBufferPointer(), firstChunk.data());
+  ITK_TEST_EXPECT_EQUAL(slabToImage->GetOutput()->GetBufferedRegion().GetSize(2), firstSlices);
+
+  // The largest region gathers both chunks
+  auto jsonToImage = WasmImageToImageFilterType::New();
+  jsonToImage->SetInput(wasmImage);
+  jsonToImage->Update();
+  ImageType::Pointer convertedImage = jsonToImage->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(convertedImage->GetBufferedRegion(), inputImage->GetLargestPossibleRegion());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(convertedImage, outputImageFile));
+
+  // A streaming pipeline input imports only the chunks its filters request
+  void * jsonPointer = reinterpret_cast< void * >(itk_wasm_input_json_alloc(0, 0, chunkedJSON.size()));
+  std::memcpy(jsonPointer, chunkedJSON.data(), chunkedJSON.size());
+  {
+    const char * mockArgv[] = { argv[0], "--memory-io", "0", nullptr };
+    itk::wasm::Pipeline pipeline("chunked-input-test", "Test requesting slabs of a chunked input", 3, const_cast< char ** >(mockArgv));
+
+    itk::wasm::InputImage<ImageType> streamedImage;
+    streamedImage.SetStreaming(true);
+    pipeline.add_option("input-image", streamedImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+    ITK_WASM_PARSE(pipeline);
+    ITK_TEST_EXPECT_EQUAL(streamedImage.Get()->GetLargestPossibleRegion(), inputImage->GetLargestPossibleRegion());
+    ITK_TEST_EXPECT_EQUAL(streamedImage.Get()->GetBufferedRegion().GetNumberOfPixels(), 0);
+
+    using RegionOfInterestFilterType = itk::RegionOfInterestImageFilter<ImageType, ImageType>;
+    auto regionOfInterest = RegionOfInterestFilterType::New();
+    regionOfInterest->SetInput(streamedImage.Get());
+    ImageType::RegionType secondSlabRegion = inputImage->GetLargestPossibleRegion();
+    secondSlabRegion.SetIndex(2, firstSlices);
+    secondSlabRegion.SetSize(2, 1);
+    regionOfInterest->SetRegionOfInterest(secondSlabRegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(regionOfInterest->Update());
+    ITK_TEST_EXPECT_EQUAL(streamedImage.Get()->GetBufferPointer(), secondChunk.data());
+    ITK_TEST_EXPECT_EQUAL(streamedImage.Get()->GetBufferedRegion().GetIndex(2), static_cast<itk::IndexValueType>(firstSlices));
+    ITK_TEST_EXPECT_TRUE(std::equal(secondChunk.begin(), secondChunk.begin() + sliceElements,
+                                    regionOfInterest->GetOutput()->GetBufferPointer()));
+  }
+  itk_wasm_free_all();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkWasmDescriptor.h"
+#include "itkImageJSON.h"
+
+#include "itkMetaDataObject.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+#include <iomanip>
+
+namespace
+{
+
+template <typename TImage>
+double
+benchmarkDescriptor(const TImage * image, bool binaryDescriptor, unsigned int iterations, size_t & descriptorSize)
+{
+  itk::TimeProbe probe;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    probe.Start();
+    using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<TImage>;
+    auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
+    imageToWasmImageFilter->SetInput(image);
+    imageToWasmImageFilter->SetBinaryDescriptor(binaryDescriptor);
+    imageToWasmImageFilter->Update();
+
+    using WasmImageToImageFilterType = itk::WasmImageToImageFilter<TImage>;
+    auto wasmImageToImageFilter = WasmImageToImageFilterType::New();
+    wasmImageToImageFilter->SetInput(imageToWasmImageFilter->GetOutput());
+    wasmImageToImageFilter->Update();
+    probe.Stop();
+
+    descriptorSize = imageToWasmImageFilter->GetOutput()->GetJSON().size();
+  }
+  return probe.GetMean();
+}
+
+} // end anonymous namespace
+
+int
+itkWasmImageDescriptorBenchmarkTest(int argc, char * argv[])
+{
+  unsigned int numberOfEntries = 500;
+  if (argc > 1)
+  {
+    numberOfEntries = std::stoi(argv[1]);
+  }
+  unsigned int iterations = 20;
+  if (argc > 2)
+  {
+    iterations = std::stoi(argv[2]);
+  }
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = float;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size.Fill(8);
+  image->SetRegions(size);
+  image->Allocate();
+  image->FillBuffer(1.0f);
+
+  // DICOM-like dictionary: many short string tags and a few numeric arrays
+  auto & dictionary = image->GetMetaDataDictionary();
+  for (unsigned int ii = 0; ii < numberOfEntries; ++ii)
+  {
+    std::ostringstream key;
+    key << "0020|" << std::setw(4) << std::setfill('0') << ii;
+    switch (ii % 3)
+    {
+      case 0:
+        itk::EncapsulateMetaData<std::string>(dictionary, key.str(), "ORIGINAL\\PRIMARY\\AXIAL");
+        break;
+      case 1:
+        itk::EncapsulateMetaData<double>(dictionary, key.str(), 0.5 * ii);
+        break;
+      default:
+        itk::EncapsulateMetaData<std::vector<double>>(dictionary, key.str(), std::vector<double>(16, 0.25 * ii));
+        break;
+    }
+  }
+
+  size_t jsonSize = 0;
+  const double jsonTime = benchmarkDescriptor<ImageType>(image, false, iterations, jsonSize);
+  size_t binarySize = 0;
+  const double binaryTime = benchmarkDescriptor<ImageType>(image, true, iterations, binarySize);
+
+  std::cout << "Metadata entries: " << numberOfEntries << std::endl;
+  std::cout << "JSON descriptor: " << jsonSize << " bytes, " << jsonTime * 1.0e3 << " ms per call" << std::endl;
+  std::cout << "BEVE descriptor: " << binarySize << " bytes, " << binaryTime * 1.0e3 << " ms per call" << std::endl;
+
+  // Both encodings must describe the same image
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto jsonFilter = ImageToWasmImageFilterType::New();
+  jsonFilter->SetInput(image);
+  jsonFilter->Update();
+  auto binaryFilter = ImageToWasmImageFilterType::New();
+  binaryFilter->SetInput(image);
+  binaryFilter->BinaryDescriptorOn();
+  binaryFilter->Update();
+
+  ITK_TEST_EXPECT_TRUE(!jsonFilter->GetOutput()->GetBinaryDescriptor());
+  ITK_TEST_EXPECT_TRUE(binaryFilter->GetOutput()->GetBinaryDescriptor());
+  const std::string & json = jsonFilter->GetOutput()->GetJSON();
+  const std::string & binary = binaryFilter->GetOutput()->GetJSON();
+
+  auto fromJSON = itk::readDescriptor<itk::ImageJSON>(json, false);
+  auto fromBinary = itk::readDescriptor<itk::ImageJSON>(binary, true);
+  ITK_TEST_EXPECT_TRUE(bool(fromJSON));
+  ITK_TEST_EXPECT_TRUE(bool(fromBinary));
+
+  // Addresses are native integers in both encodings
+  ITK_TEST_EXPECT_EQUAL(itk::descriptorArrayAddress(fromJSON.value().data), reinterpret_cast<size_t>(image->GetBufferPointer()));
+  ITK_TEST_EXPECT_EQUAL(itk::descriptorArrayAddress(fromBinary.value().data), reinterpret_cast<size_t>(image->GetBufferPointer()));
+
+  // The decoded descriptors are identical, field by field
+  std::string fromJSONReserialized;
+  std::string fromBinaryReserialized;
+  ITK_TEST_EXPECT_TRUE(!itk::writeDescriptor(fromJSON.value(), fromJSONReserialized));
+  ITK_TEST_EXPECT_TRUE(!itk::writeDescriptor(fromBinary.value(), fromBinaryReserialized));
+  ITK_TEST_EXPECT_EQUAL(fromJSONReserialized, fromBinaryReserialized);
+  ITK_TEST_EXPECT_EQUAL(fromBinary.value().metadata.size(), static_cast<size_t>(numberOfEntries));
+  itk::MetaDataDictionary fromBinaryDictionary;
+  itk::jsonToMetaDataDictionary(fromBinary.value().metadata, fromBinaryDictionary);
+  double fromBinaryValue = 0.0;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData<double>(fromBinaryDictionary, "0020|0001", fromBinaryValue));
+  ITK_TEST_EXPECT_EQUAL(fromBinaryValue, 0.5);
+
+  // and the image read back from the binary descriptor matches the input
+  using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+  auto wasmImageToImageFilter = WasmImageToImageFilterType::New();
+  wasmImageToImageFilter->SetInput(binaryFilter->GetOutput());
+  wasmImageToImageFilter->Update();
+  const ImageType * roundTrip = wasmImageToImageFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(roundTrip->GetLargestPossibleRegion(), image->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(roundTrip->GetDirection(), image->GetDirection());
+  ITK_TEST_EXPECT_EQUAL(roundTrip->GetBufferPointer(), image->GetBufferPointer());
+
+  return EXIT_SUCCESS;
+}
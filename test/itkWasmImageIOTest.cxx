@@ -17,10 +17,14 @@
  *=========================================================================*/
 #include "itkWasmImageIOFactory.h"
 #include "itkWasmImageIO.h"
+#include "itkWasmMappedImage.h"
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkTestingMacros.h"
 #include "itkMetaDataObject.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <algorithm>
 
 int
 itkWasmImageIOTest(int argc, char * argv[])
@@ -90,5 +94,68 @@ itkWasmImageIOTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(wasmReader->GetOutput(), convertedCBORFile));
 
+  // The pixel data of the directory layout is mapped
+  ImagePointer mappedImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(mappedImage = itk::wasm::readMappedImage<ImageType>(imageDirectory));
+  ITK_TEST_EXPECT_TRUE(mappedImage.IsNotNull());
+  ITK_TEST_EXPECT_EQUAL(mappedImage->GetLargestPossibleRegion(), writtenReadImage->GetLargestPossibleRegion());
+  ITK_TEST_EXPECT_EQUAL(mappedImage->GetOrigin(), writtenReadImage->GetOrigin());
+  ITK_TEST_EXPECT_EQUAL(mappedImage->GetSpacing(), writtenReadImage->GetSpacing());
+  ITK_TEST_EXPECT_EQUAL(mappedImage->GetDirection(), writtenReadImage->GetDirection());
+  ITK_TEST_EXPECT_TRUE(mappedImage->GetMetaDataDictionary().HasKey(testEntryKey));
+  const itk::SizeValueType numberOfPixels = writtenReadImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  ITK_TEST_EXPECT_TRUE(std::equal(mappedImage->GetBufferPointer(), mappedImage->GetBufferPointer() + numberOfPixels, writtenReadImage->GetBufferPointer()));
+  // Other layouts and pixel types are left to the reader
+  ITK_TEST_EXPECT_TRUE(itk::wasm::readMappedImage<ImageType>(imageCBOR).IsNull());
+  ITK_TEST_EXPECT_TRUE((itk::wasm::readMappedImage<itk::Image<float, Dimension>>(imageDirectory).IsNull()));
+
+  // Chunked, multiscale directory layout
+  const std::string chunkedDirectory = std::string(imageDirectory) + ".chunked";
+  auto chunkedWriteIO = itk::WasmImageIO::New();
+  chunkedWriteIO->SetChunkSize({ 16 });
+  chunkedWriteIO->SetNumberOfResolutionLevels(2);
+  wasmWriter->SetImageIO( chunkedWriteIO );
+  wasmWriter->SetFileName( chunkedDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmWriter->Update());
+
+  auto chunkedReader = ReaderType::New();
+  chunkedReader->SetImageIO( itk::WasmImageIO::New() );
+  chunkedReader->SetFileName( chunkedDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(chunkedReader->Update());
+  ITK_TEST_EXPECT_TRUE(itk::wasm::readMappedImage<ImageType>(chunkedDirectory).IsNull());
+  const ImageType * chunkedImage = chunkedReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(chunkedImage->GetLargestPossibleRegion(), inputImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> inputIt(inputImage, inputImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> chunkedIt(chunkedImage, chunkedImage->GetLargestPossibleRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++chunkedIt)
+  {
+    if (inputIt.Get() != chunkedIt.Get())
+    {
+      std::cerr << "Chunked pixel mismatch at " << inputIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto levelIO = itk::WasmImageIO::New();
+  levelIO->SetResolutionLevel(1);
+  auto levelReader = ReaderType::New();
+  levelReader->SetImageIO( levelIO );
+  levelReader->SetFileName( chunkedDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(levelReader->Update());
+  const ImageType * levelImage = levelReader->GetOutput();
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    ITK_TEST_EXPECT_EQUAL(levelImage->GetLargestPossibleRegion().GetSize(dim), (inputImage->GetLargestPossibleRegion().GetSize(dim) + 1) / 2);
+    ITK_TEST_EXPECT_EQUAL(levelImage->GetSpacing()[dim], 2.0 * inputImage->GetSpacing()[dim]);
+  }
+  ImageType::IndexType levelIndex;
+  ImageType::IndexType inputIndex;
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    levelIndex[dim] = levelImage->GetLargestPossibleRegion().GetSize(dim) > 1 ? 1 : 0;
+    inputIndex[dim] = 2 * levelIndex[dim];
+  }
+  ITK_TEST_EXPECT_EQUAL(levelImage->GetPixel(levelIndex), inputImage->GetPixel(inputIndex));
+
   return EXIT_SUCCESS;
 }
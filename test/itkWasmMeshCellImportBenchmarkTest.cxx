@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMeshToWasmMeshFilter.h"
+#include "itkWasmMeshToMeshFilter.h"
+
+#include "itkMesh.h"
+#include "itkTetrahedronCell.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+
+namespace
+{
+
+// Cell by cell import with SetCell, as WasmMeshToMeshFilter did before the
+// bulk import path
+template <typename TMesh>
+void
+populateCellsCellByCell(TMesh * mesh, itk::SizeValueType cellBufferSize, const uint32_t * cellsBufferPtr)
+{
+  using TetrahedronCellType = itk::TetrahedronCell<typename TMesh::CellType>;
+  typename TMesh::CellIdentifier id = 0;
+  itk::SizeValueType index = 0;
+  while (index < cellBufferSize)
+  {
+    index += 2;
+    typename TMesh::CellAutoPointer cell;
+    auto * tetrahedronCell = new TetrahedronCellType;
+    for (unsigned int jj = 0; jj < TetrahedronCellType::NumberOfPoints; ++jj)
+    {
+      tetrahedronCell->SetPointId(jj, cellsBufferPtr[index++]);
+    }
+    cell.TakeOwnership(tetrahedronCell);
+    mesh->SetCell(id++, cell);
+  }
+}
+
+} // end anonymous namespace
+
+int
+itkWasmMeshCellImportBenchmarkTest(int argc, char * argv[])
+{
+  unsigned int numberOfCells = 100000;
+  if (argc > 1)
+  {
+    numberOfCells = std::stoi(argv[1]);
+  }
+  unsigned int iterations = 5;
+  if (argc > 2)
+  {
+    iterations = std::stoi(argv[2]);
+  }
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = float;
+  using MeshType = itk::Mesh<PixelType, Dimension>;
+
+  // A strip of tetrahedra sharing faces
+  auto mesh = MeshType::New();
+  for (unsigned int ii = 0; ii < numberOfCells + 3; ++ii)
+  {
+    MeshType::PointType point;
+    point[0] = ii;
+    point[1] = ii % 2;
+    point[2] = (ii / 2) % 2;
+    mesh->SetPoint(ii, point);
+  }
+  std::vector<uint32_t> cellsBuffer;
+  cellsBuffer.reserve(6 * numberOfCells);
+  for (unsigned int ii = 0; ii < numberOfCells; ++ii)
+  {
+    cellsBuffer.push_back(static_cast<uint32_t>(itk::CellGeometryEnum::TETRAHEDRON_CELL));
+    cellsBuffer.push_back(4);
+    for (unsigned int jj = 0; jj < 4; ++jj)
+    {
+      cellsBuffer.push_back(ii + jj);
+    }
+  }
+  populateCellsCellByCell<MeshType>(mesh, cellsBuffer.size(), cellsBuffer.data());
+
+  using MeshToWasmMeshFilterType = itk::MeshToWasmMeshFilter<MeshType>;
+  auto meshToWasmMesh = MeshToWasmMeshFilterType::New();
+  meshToWasmMesh->SetInput(mesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshToWasmMesh->Update());
+
+  // Both paths import the same cells buffer into an empty mesh
+  itk::TimeProbe cellByCellProbe;
+  itk::TimeProbe bulkProbe;
+  MeshType::Pointer cellByCellMesh;
+  MeshType::Pointer bulkMesh;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    cellByCellMesh = nullptr;
+    cellByCellProbe.Start();
+    cellByCellMesh = MeshType::New();
+    populateCellsCellByCell<MeshType>(cellByCellMesh, cellsBuffer.size(), cellsBuffer.data());
+    cellByCellProbe.Stop();
+
+    bulkMesh = nullptr;
+    bulkProbe.Start();
+    bulkMesh = MeshType::New();
+    populateCells<MeshType, uint32_t>(bulkMesh, cellsBuffer.size(), cellsBuffer.data());
+    bulkProbe.Stop();
+  }
+
+  std::cout << "Tetrahedra: " << numberOfCells << std::endl;
+  std::cout << "Cell by cell SetCell: " << cellByCellProbe.GetMean() * 1.0e3 << " ms" << std::endl;
+  std::cout << "Bulk import: " << bulkProbe.GetMean() * 1.0e3 << " ms" << std::endl;
+
+  ITK_TEST_EXPECT_EQUAL(bulkMesh->GetNumberOfCells(), cellByCellMesh->GetNumberOfCells());
+  for (MeshType::CellIdentifier id = 0; id < numberOfCells; ++id)
+  {
+    MeshType::CellAutoPointer expected;
+    MeshType::CellAutoPointer cell;
+    ITK_TEST_EXPECT_TRUE(cellByCellMesh->GetCell(id, expected));
+    ITK_TEST_EXPECT_TRUE(bulkMesh->GetCell(id, cell));
+    ITK_TEST_EXPECT_EQUAL(cell->GetType(), expected->GetType());
+    ITK_TEST_EXPECT_TRUE(std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), expected->PointIdsBegin()));
+  }
+
+  // and the filter imports the cells buffer of the wasm mesh
+  using WasmMeshToMeshFilterType = itk::WasmMeshToMeshFilter<MeshType>;
+  auto wasmMeshToMesh = WasmMeshToMeshFilterType::New();
+  wasmMeshToMesh->SetInput(meshToWasmMesh->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(wasmMeshToMesh->Update());
+  MeshType::Pointer convertedMesh = wasmMeshToMesh->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(convertedMesh->GetNumberOfCells(), numberOfCells);
+  MeshType::CellAutoPointer lastCell;
+  ITK_TEST_EXPECT_TRUE(convertedMesh->GetCell(numberOfCells - 1, lastCell));
+  ITK_TEST_EXPECT_EQUAL(lastCell->GetType(), itk::CellGeometryEnum::TETRAHEDRON_CELL);
+  ITK_TEST_EXPECT_EQUAL(lastCell->GetPointIds()[3], numberOfCells + 2);
+
+  return EXIT_SUCCESS;
+}
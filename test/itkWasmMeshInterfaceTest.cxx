@@ -21,8 +21,36 @@
 #include "itkMesh.h"
 #include "itkMeshFileReader.h"
 #include "itkMeshFileWriter.h"
+#include "itkHexahedronCell.h"
+#include "itkLineCell.h"
+#include "itkPolygonCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
+#include "itkMultiThreaderBase.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
+
+namespace
+{
+
+template <typename TCell, typename TMesh>
+void
+addCell(TMesh * mesh, typename TMesh::CellIdentifier id, unsigned int numberOfPoints)
+{
+  typename TMesh::CellAutoPointer cell;
+  cell.TakeOwnership(new TCell);
+  for (unsigned int jj = 0; jj < numberOfPoints; ++jj)
+  {
+    cell->SetPointId(jj, id + jj);
+  }
+  mesh->SetCell(id, cell);
+}
+
+} // end anonymous namespace
+
 int
 itkWasmMeshInterfaceTest(int argc, char * argv[])
 {
@@ -55,6 +83,11 @@ itkWasmMeshInterfaceTest(int argc, char * argv[])
 
   std::cout << "Mesh JSON: " << meshJSON->GetJSON() << std::endl;
 
+  // The parallel cell serialization matches the serial Mesh cells array
+  const auto & cellBuffer = meshJSON->GetCellBuffer()->CastToSTLConstContainer();
+  const auto & cellsArray = inputMesh->GetCellsArray()->CastToSTLConstContainer();
+  ITK_TEST_EXPECT_TRUE(cellBuffer == cellsArray);
+
   using WasmMeshToMeshFilterType = itk::WasmMeshToMeshFilter<MeshType>;
   auto jsonToMeshFilter = WasmMeshToMeshFilterType::New();
   jsonToMeshFilter->SetInput(meshJSON);
@@ -68,5 +101,72 @@ itkWasmMeshInterfaceTest(int argc, char * argv[])
   writer->SetInput(convertedMesh);
   ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
 
+  // Mixed cell types over several serialization chunks, so chunk boundaries
+  // fall between cells with different numbers of points
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(4);
+  using CellType = MeshType::CellType;
+  const MeshType::CellIdentifier numberOfMixedCells = 4 * 16384 + 123;
+  auto mixedMesh = MeshType::New();
+  for (MeshType::CellIdentifier id = 0; id < numberOfMixedCells + 8; ++id)
+  {
+    MeshType::PointType point;
+    point[0] = id;
+    point[1] = id % 2;
+    point[2] = (id / 2) % 2;
+    mixedMesh->SetPoint(id, point);
+  }
+  for (MeshType::CellIdentifier id = 0; id < numberOfMixedCells; ++id)
+  {
+    switch (id % 7)
+    {
+      case 0:
+        addCell<itk::VertexCell<CellType>>(mixedMesh.GetPointer(), id, 1);
+        break;
+      case 1:
+        addCell<itk::LineCell<CellType>>(mixedMesh.GetPointer(), id, 2);
+        break;
+      case 2:
+        addCell<itk::TriangleCell<CellType>>(mixedMesh.GetPointer(), id, 3);
+        break;
+      case 3:
+        addCell<itk::QuadrilateralCell<CellType>>(mixedMesh.GetPointer(), id, 4);
+        break;
+      case 4:
+        addCell<itk::PolygonCell<CellType>>(mixedMesh.GetPointer(), id, 5);
+        break;
+      case 5:
+        addCell<itk::TetrahedronCell<CellType>>(mixedMesh.GetPointer(), id, 4);
+        break;
+      default:
+        addCell<itk::HexahedronCell<CellType>>(mixedMesh.GetPointer(), id, 8);
+    }
+  }
+
+  auto mixedMeshToJSONFilter = MeshToWasmMeshFilterType::New();
+  mixedMeshToJSONFilter->SetInput(mixedMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(mixedMeshToJSONFilter->Update());
+  const auto & mixedCellBuffer = mixedMeshToJSONFilter->GetOutput()->GetCellBuffer()->CastToSTLConstContainer();
+  const auto & mixedCellsArray = mixedMesh->GetCellsArray()->CastToSTLConstContainer();
+  ITK_TEST_EXPECT_TRUE(mixedCellBuffer == mixedCellsArray);
+
+  auto jsonToMixedMeshFilter = WasmMeshToMeshFilterType::New();
+  jsonToMixedMeshFilter->SetInput(mixedMeshToJSONFilter->GetOutput());
+  ITK_TRY_EXPECT_NO_EXCEPTION(jsonToMixedMeshFilter->Update());
+  MeshType::Pointer convertedMixedMesh = jsonToMixedMeshFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(convertedMixedMesh->GetNumberOfCells(), numberOfMixedCells);
+  for (MeshType::CellIdentifier id = 0; id < numberOfMixedCells; ++id)
+  {
+    MeshType::CellAutoPointer expected;
+    MeshType::CellAutoPointer cell;
+    mixedMesh->GetCell(id, expected);
+    convertedMixedMesh->GetCell(id, cell);
+    if (cell->GetType() != expected->GetType() ||
+        !std::equal(cell->PointIdsBegin(), cell->PointIdsEnd(), expected->PointIdsBegin(), expected->PointIdsEnd()))
+    {
+      std::cerr << "Mixed mesh cell " << id << " differs after the round trip" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
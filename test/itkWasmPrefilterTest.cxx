@@ -0,0 +1,91 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmPrefilter.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+int
+itkWasmPrefilterTest(int, char *[])
+{
+  // A smooth 16-bit ramp, with an odd number of trailing bytes
+  constexpr size_t rowLength = 37;
+  constexpr size_t rows = 23;
+  std::vector<uint16_t> pixels(rowLength * rows);
+  for (size_t ii = 0; ii < pixels.size(); ++ii)
+  {
+    pixels[ii] = static_cast<uint16_t>(1000 + 7 * (ii % rowLength) + 300 * (ii / rowLength));
+  }
+  std::vector<unsigned char> input(pixels.size() * sizeof(uint16_t) + 1);
+  std::memcpy(input.data(), pixels.data(), pixels.size() * sizeof(uint16_t));
+  input.back() = 42;
+
+  for (const std::string name : { "none", "shuffle", "delta", "delta-shuffle" })
+  {
+    itk::WasmPrefilterParameters parameters;
+    parameters.prefilter = itk::wasmPrefilterFromString(name);
+    parameters.elementSize = sizeof(uint16_t);
+    parameters.rowLength = rowLength;
+    ITK_TEST_EXPECT_EQUAL(itk::wasmPrefilterToString(parameters.prefilter), name);
+
+    std::vector<unsigned char> filtered(input.size());
+    itk::applyWasmPrefilter(parameters, input.data(), filtered.data(), input.size());
+    ITK_TEST_EXPECT_EQUAL(filtered.back(), 42);
+    if (parameters.prefilter == itk::WasmPrefilterEnum::Delta)
+    {
+      // Each row after the first differs from the previous row by 300
+      uint16_t difference;
+      std::memcpy(&difference, filtered.data() + rowLength * sizeof(uint16_t), sizeof(uint16_t));
+      ITK_TEST_EXPECT_EQUAL(difference, 300);
+    }
+
+    unsigned char frame[itk::WasmPrefilterFrameSize];
+    itk::writeWasmPrefilterFrame(parameters, frame);
+    itk::WasmPrefilterParameters recorded;
+    ITK_TEST_EXPECT_TRUE(itk::readWasmPrefilterFrame(frame, sizeof(frame), recorded));
+    ITK_TEST_EXPECT_TRUE(recorded.prefilter == parameters.prefilter);
+    ITK_TEST_EXPECT_EQUAL(recorded.elementSize, parameters.elementSize);
+    ITK_TEST_EXPECT_EQUAL(recorded.rowLength, parameters.rowLength);
+
+    itk::undoWasmPrefilter(recorded, filtered.data(), filtered.size());
+    if (filtered != input)
+    {
+      std::cerr << "The " << name << " prefilter did not round trip" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  bool caught = false;
+  try
+  {
+    itk::wasmPrefilterFromString("bitshuffle");
+  }
+  catch (const std::invalid_argument &)
+  {
+    caught = true;
+  }
+  ITK_TEST_EXPECT_TRUE(caught);
+  itk::WasmPrefilterParameters unchanged;
+  ITK_TEST_EXPECT_TRUE(!itk::readWasmPrefilterFrame(input.data(), input.size(), unchanged));
+
+  return EXIT_SUCCESS;
+}
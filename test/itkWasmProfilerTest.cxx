@@ -0,0 +1,105 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkShrinkImageFilter.h"
+#include "itkWasmExports.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+int
+itkWasmProfilerTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " profileFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string profileFileName = argv[1];
+
+  {
+    char * noProfileArgv[] = { argv[0], nullptr };
+    itk::wasm::Pipeline pipeline("profiler-test", "A test ITK Wasm Pipeline", 1, noProfileArgv);
+    ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_profiler() == nullptr);
+  }
+
+  {
+    char * profileArgv[] = { argv[0], const_cast<char *>("--profile"), argv[1], nullptr };
+    itk::wasm::Pipeline pipeline("profiler-test", "A test ITK Wasm Pipeline", 3, profileArgv);
+
+    // The profiler is created when --profile is parsed
+    pipeline.parse();
+    ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_profiler() != nullptr);
+
+    using ImageType = itk::Image<float, 2>;
+    auto image = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize({ { 16, 16 } });
+    image->SetRegions(region);
+    image->Allocate(true);
+
+    using FilterType = itk::ShrinkImageFilter<ImageType, ImageType>;
+    auto filter = FilterType::New();
+    filter->SetInput(image);
+    pipeline.observe_process(filter);
+
+    // Memory IO store allocations are counted in every build
+    {
+      const auto allocationStart = itk::wasm::Profiler::GetAllocationCount();
+      itk::wasm::ProfileScope allocateScope("allocate input", "test");
+      itk_wasm_input_array_alloc(0, 0, 0, 4096);
+      const auto allocationEnd = itk::wasm::Profiler::GetAllocationCount();
+      ITK_TEST_EXPECT_TRUE(allocationEnd.allocations > allocationStart.allocations);
+      ITK_TEST_EXPECT_TRUE(allocationEnd.bytes - allocationStart.bytes >= 4096);
+    }
+    itk_wasm_free_all();
+
+    itk::wasm::ProfileScope scope("a \"quoted\" stage", "test");
+    scope.SetBytes(1024);
+    filter->Update();
+  }
+
+  const std::string equalsProfileFileName = profileFileName + ".equals.json";
+  {
+    const std::string profileArgument = "--profile=" + equalsProfileFileName;
+    char * profileArgv[] = { argv[0], const_cast<char *>(profileArgument.c_str()), nullptr };
+    itk::wasm::Pipeline pipeline("profiler-test", "A test ITK Wasm Pipeline", 2, profileArgv);
+    pipeline.parse();
+    ITK_TEST_EXPECT_TRUE(itk::wasm::Pipeline::get_profiler() != nullptr);
+    ITK_TEST_EXPECT_EQUAL(itk::wasm::Pipeline::get_profiler()->GetFileName(), equalsProfileFileName);
+  }
+
+  std::ifstream profileFile(profileFileName);
+  const std::string profile((std::istreambuf_iterator<char>(profileFile)), std::istreambuf_iterator<char>());
+  ITK_TEST_EXPECT_TRUE(profile.find("\"traceEvents\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"name\":\"parse\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"name\":\"ShrinkImageFilter\",\"cat\":\"filter\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"name\":\"a \\\"quoted\\\" stage\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"bytes\":1024") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"name\":\"allocate input\"") != std::string::npos);
+  ITK_TEST_EXPECT_TRUE(profile.find("\"allocated_bytes\":") != std::string::npos);
+
+  std::ifstream equalsProfileFile(equalsProfileFileName);
+  const std::string equalsProfile((std::istreambuf_iterator<char>(equalsProfileFile)), std::istreambuf_iterator<char>());
+  ITK_TEST_EXPECT_TRUE(equalsProfile.find("\"name\":\"parse\"") != std::string::npos);
+
+  return EXIT_SUCCESS;
+}